@@ -0,0 +1,126 @@
+/******************************************************************************\
+ * This benchmark measures the throughput of remote messaging when a single   *
+ * node sends to many peers at once. Each sink counts received messages and   *
+ * the source runs one sending actor per sink. Start one sink per port in     *
+ * separate processes first, then run the source with the ports of all sinks. *
+ *                                                                            *
+ * Usage: basp_fanout sink <port>                                             *
+ *        basp_fanout source <messages per peer> <port> [<port> ...]          *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+// a payload with a few elements to make serialization non-trivial
+using payload = std::vector<int32_t>;
+
+behavior sink(event_based_actor* self) {
+  auto count = std::make_shared<uint64_t>(0);
+  return {
+    [=](const payload&) {
+      ++*count;
+    },
+    [=](done_atom) {
+      auto result = *count;
+      *count = 0;
+      return result;
+    }
+  };
+}
+
+void run_sink(uint16_t port) {
+  announce<payload>("payload");
+  io::publish(spawn(sink), port, "127.0.0.1");
+  cout << "sink published at port " << port << endl;
+  await_all_actors_done();
+}
+
+void run_source(uint64_t n, const std::vector<uint16_t>& ports) {
+  announce<payload>("payload");
+  std::vector<actor> sinks;
+  for (auto port : ports) {
+    sinks.push_back(io::remote_actor("127.0.0.1", port));
+  }
+  scoped_actor self;
+  auto t0 = clock_type::now();
+  for (auto& dest : sinks) {
+    spawn([=](event_based_actor* sender) {
+      payload xs(16, 42);
+      for (uint64_t i = 0; i < n; ++i) {
+        sender->send(dest, xs);
+      }
+    });
+  }
+  // send requests only after all senders are done
+  self->await_all_other_actors_done();
+  uint64_t total = 0;
+  for (auto& dest : sinks) {
+    self->sync_send(dest, done_atom::value).await(
+      [&](uint64_t received) {
+        total += received;
+      }
+    );
+  }
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto secs = static_cast<double>(ms.count()) / 1000.;
+  cout << total << " messages to " << sinks.size() << " peers in "
+       << ms.count() << " ms (" << static_cast<uint64_t>(total / secs)
+       << " msg/s)" << endl;
+  for (auto& dest : sinks) {
+    anon_send_exit(dest, exit_reason::user_shutdown);
+  }
+}
+
+void usage() {
+  cout << "usage: basp_fanout sink <port>" << endl
+       << "       basp_fanout source <messages per peer> <port> [<port> ...]"
+       << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    usage();
+    return 1;
+  }
+  std::string mode = argv[1];
+  try {
+    if (mode == "sink" && argc == 3) {
+      run_sink(static_cast<uint16_t>(std::stoul(argv[2])));
+    } else if (mode == "source" && argc > 3) {
+      std::vector<uint16_t> ports;
+      for (int i = 3; i < argc; ++i) {
+        ports.push_back(static_cast<uint16_t>(std::stoul(argv[i])));
+      }
+      run_source(std::stoull(argv[2]), ports);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  catch (std::exception& e) {
+    cerr << "error: " << e.what() << endl;
+    return 1;
+  }
+  shutdown();
+}
@@ -0,0 +1,120 @@
+/******************************************************************************\
+ * This benchmark measures how the IO throughput of a node scales with the    *
+ * number of event loops of the middleman. It runs pairs of echo servers and  *
+ * clients in a single process, each pair exchanging small messages over a   *
+ * loopback connection with a fixed number of messages in flight.             *
+ *                                                                            *
+ * Usage: event_loops [event loops] [connections] [seconds]                   *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+using done_atom = atom_constant<atom("done")>;
+
+constexpr size_t msg_size = 64;
+constexpr size_t msgs_in_flight = 16;
+
+behavior echo_server(broker* self) {
+  return {
+    [=](const new_connection_msg& msg) {
+      self->configure_read(msg.handle, receive_policy::exactly(msg_size));
+    },
+    [=](const new_data_msg& msg) {
+      auto& buf = self->wr_buf(msg.handle);
+      buf.insert(buf.end(), msg.buf.begin(), msg.buf.end());
+      self->flush(msg.handle);
+    },
+    [=](const connection_closed_msg&) {
+      self->quit();
+    },
+    [=](publish_atom) {
+      return self->add_tcp_doorman(0, "127.0.0.1").second;
+    }
+  };
+}
+
+behavior client(broker* self, connection_handle hdl) {
+  auto count = std::make_shared<uint64_t>(0);
+  self->configure_read(hdl, receive_policy::exactly(msg_size));
+  auto& buf = self->wr_buf(hdl);
+  buf.resize(msg_size * msgs_in_flight, 'x');
+  self->flush(hdl);
+  return {
+    [=](const new_data_msg& msg) {
+      ++*count;
+      auto& out = self->wr_buf(msg.handle);
+      out.insert(out.end(), msg.buf.begin(), msg.buf.end());
+      self->flush(msg.handle);
+    },
+    [=](done_atom) {
+      self->quit();
+      return *count;
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: event_loops [event loops] [connections] [seconds]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  size_t num_loops = 1;
+  size_t num_connections = 64;
+  size_t seconds = 5;
+  if (argc > 1) {
+    num_loops = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    num_connections = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    seconds = std::stoul(argv[3]);
+  }
+  set_middleman(num_loops);
+  {
+    scoped_actor self;
+    std::vector<actor> clients;
+    for (size_t i = 0; i < num_connections; ++i) {
+      auto server = spawn_io(echo_server);
+      self->sync_send(server, publish_atom::value).await(
+        [&](uint16_t port) {
+          clients.push_back(spawn_io_client(client, "127.0.0.1", port));
+        }
+      );
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    uint64_t total = 0;
+    for (auto& c : clients) {
+      self->sync_send(c, done_atom::value).await(
+        [&](uint64_t count) {
+          total += count;
+        }
+      );
+    }
+    cout << num_loops << " event loops, " << num_connections
+         << " connections: " << total / seconds << " msg/s" << endl;
+  }
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,165 @@
+/******************************************************************************\
+ * This benchmark compares the loopback TCP transport of BASP with shared     *
+ * memory channels between two processes on the same host. It forks a server *
+ * process and then runs the client twice, once with shared memory disabled  *
+ * and once with shared memory enabled. Each client measures the average     *
+ * round-trip time of `roundtrips` request/response pairs and the throughput *
+ * of `messages` asynchronous messages.                                       *
+ *                                                                            *
+ * Usage: shm_transport [roundtrips] [messages]                               *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+#include "caf/experimental/whereis.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using ping_atom = atom_constant<atom("ping")>;
+using pong_atom = atom_constant<atom("pong")>;
+using tick_atom = atom_constant<atom("tick")>;
+
+behavior server(event_based_actor* self) {
+  auto received = std::make_shared<uint64_t>(0);
+  return {
+    [](ping_atom, uint64_t x) {
+      return std::make_tuple(pong_atom::value, x);
+    },
+    [=](tick_atom, uint64_t) {
+      ++*received;
+    },
+    [=](get_atom) {
+      auto result = *received;
+      *received = 0;
+      return result;
+    }
+  };
+}
+
+// runs the server and reports its port via `fd`
+void run_server(int fd) {
+  auto port = io::publish(spawn(server), 0, "127.0.0.1");
+  if (write(fd, &port, sizeof(port)) != sizeof(port))
+    cerr << "unable to report port to parent process" << endl;
+  close(fd);
+  await_all_actors_done();
+  shutdown();
+}
+
+void run_client(const char* name, bool use_shm, uint16_t port,
+                uint64_t roundtrips, uint64_t messages) {
+  { // must be configured before the middleman starts
+    scoped_actor self;
+    auto cs = experimental::whereis(atom("ConfigServ"));
+    self->send(cs, put_atom::value, "global.enable-shared-memory",
+               make_message(use_shm));
+    // wait until the configuration server has processed our update
+    self->sync_send(cs, get_atom::value, "global.enable-shared-memory").await(
+      [](ok_atom, const std::string&, const message&) {
+        // nop
+      }
+    );
+  }
+  auto srv = io::remote_actor("127.0.0.1", port);
+  { // lifetime scope of self
+    scoped_actor self;
+    auto t0 = clock_type::now();
+    for (uint64_t i = 0; i < roundtrips; ++i) {
+      self->sync_send(srv, ping_atom::value, i).await(
+        [](pong_atom, uint64_t) {
+          // nop
+        }
+      );
+    }
+    auto t1 = clock_type::now();
+    for (uint64_t i = 0; i < messages; ++i) {
+      self->send(srv, tick_atom::value, i);
+    }
+    uint64_t received = 0;
+    self->sync_send(srv, get_atom::value).await(
+      [&](uint64_t x) {
+        received = x;
+      }
+    );
+    auto t2 = clock_type::now();
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::milliseconds;
+    auto rtt = duration_cast<microseconds>(t1 - t0).count();
+    auto ms = duration_cast<milliseconds>(t2 - t1).count();
+    cout << name << ": " << (static_cast<double>(rtt) / roundtrips)
+         << " us/roundtrip, " << received << " messages in " << ms
+         << " ms (" << (received * 1000 / (ms + 1)) << " msg/s)" << endl;
+  }
+  shutdown();
+}
+
+void usage() {
+  cout << "usage: shm_transport [roundtrips] [messages]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  uint64_t roundtrips = 10000;
+  uint64_t messages = 1000000;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    roundtrips = std::stoull(argv[1]);
+  }
+  if (argc > 2) {
+    messages = std::stoull(argv[2]);
+  }
+  // fork all processes before CAF starts any thread
+  int fds[2];
+  if (pipe(fds) != 0) {
+    cerr << "pipe() failed" << endl;
+    return 1;
+  }
+  auto srv = fork();
+  if (srv == 0) {
+    close(fds[0]);
+    run_server(fds[1]);
+    return 0;
+  }
+  close(fds[1]);
+  uint16_t port = 0;
+  if (read(fds[0], &port, sizeof(port)) != sizeof(port)) {
+    cerr << "server did not start" << endl;
+    return 1;
+  }
+  close(fds[0]);
+  auto client = [&](const char* name, bool use_shm) {
+    auto pid = fork();
+    if (pid == 0) {
+      run_client(name, use_shm, port, roundtrips, messages);
+      exit(0);
+    }
+    waitpid(pid, nullptr, 0);
+  };
+  client("tcp", false);
+  client("shm", true);
+  kill(srv, SIGTERM);
+  waitpid(srv, nullptr, 0);
+}
@@ -0,0 +1,118 @@
+/******************************************************************************\
+ * This benchmark measures the throughput of many small messages between two  *
+ * nodes over the loopback device. The client sends `n` integers to an actor  *
+ * published by the server and waits for the server to acknowledge the last  *
+ * message. Run the server first, then the client in a separate process.      *
+ *                                                                            *
+ * Usage: small_messages server [port]                                        *
+ *        small_messages client [port] [messages]                             *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+#include "caf/experimental/whereis.hpp"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+behavior counter(event_based_actor* self) {
+  auto count = std::make_shared<uint64_t>(0);
+  return {
+    [=](int32_t) {
+      ++*count;
+    },
+    [=](done_atom) {
+      auto result = *count;
+      *count = 0;
+      return result;
+    }
+  };
+}
+
+void run_server(uint16_t port) {
+  auto actual_port = io::publish(spawn(counter), port, "127.0.0.1");
+  cout << "server published at port " << actual_port << endl;
+  await_all_actors_done();
+}
+
+void run_client(uint16_t port, uint64_t n) {
+  scoped_actor self;
+  // stay on TCP, nodes on the same host otherwise use shared memory
+  auto cs = experimental::whereis(atom("ConfigServ"));
+  self->send(cs, put_atom::value, "global.enable-shared-memory",
+             make_message(false));
+  self->sync_send(cs, get_atom::value, "global.enable-shared-memory").await(
+    [](ok_atom, const std::string&, const message&) {
+      // nop
+    }
+  );
+  auto srv = io::remote_actor("127.0.0.1", port);
+  auto t0 = clock_type::now();
+  for (uint64_t i = 0; i < n; ++i) {
+    self->send(srv, static_cast<int32_t>(i));
+  }
+  self->sync_send(srv, done_atom::value).await(
+    [&](uint64_t received) {
+      auto t1 = clock_type::now();
+      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+      auto secs = static_cast<double>(ms.count()) / 1000.;
+      cout << received << " messages in " << ms.count() << " ms ("
+           << static_cast<uint64_t>(received / secs) << " msg/s)" << endl;
+    }
+  );
+  anon_send_exit(srv, exit_reason::user_shutdown);
+  self->await_all_other_actors_done();
+}
+
+void usage() {
+  cout << "usage: small_messages server [port]" << endl
+       << "       small_messages client [port] [messages]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 4) {
+    usage();
+    return 1;
+  }
+  std::string mode = argv[1];
+  uint16_t port = 4242;
+  uint64_t n = 1000000;
+  if (argc > 2) {
+    port = static_cast<uint16_t>(std::stoul(argv[2]));
+  }
+  if (argc > 3) {
+    n = std::stoull(argv[3]);
+  }
+  try {
+    if (mode == "server" && argc < 4) {
+      run_server(port);
+    } else if (mode == "client") {
+      run_client(port, n);
+    } else {
+      usage();
+      return 1;
+    }
+  }
+  catch (std::exception& e) {
+    cerr << "error: " << e.what() << endl;
+    return 1;
+  }
+  shutdown();
+}
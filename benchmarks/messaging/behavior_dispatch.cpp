@@ -0,0 +1,81 @@
+/******************************************************************************\
+ * This benchmark measures how long it takes a behavior to dispatch a message *
+ * to its handler depending on the number of match cases. Each message        *
+ * matches the last match case of the behavior, i.e., the worst case for      *
+ * behaviors that test each case in turn.                                     *
+ *                                                                            *
+ * Usage: behavior_dispatch [iterations]                                      *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// all cases of a row have `T` as first element
+template <class T, class... Us>
+message_handler row() {
+  return message_handler{[](T, Us) { /* nop */ }...};
+}
+
+message_handler concat() {
+  return {};
+}
+
+template <class... Ts>
+message_handler concat(const message_handler& x, const Ts&... xs) {
+  return x.or_else(concat(xs...));
+}
+
+template <class... Ts>
+message_handler rows() {
+  return concat(row<Ts, Ts...>()...);
+}
+
+void run(const char* name, message_handler bhvr, message msg, size_t n) {
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < n; ++i) {
+    bhvr(msg);
+  }
+  auto t1 = clock_type::now();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+  cout << name << ": " << static_cast<double>(ns.count()) / n
+       << " ns/dispatch" << endl;
+}
+
+void usage() {
+  cout << "usage: behavior_dispatch [iterations]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t iterations = 10000000;
+  if (argc > 2) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    iterations = std::stoul(argv[1]);
+  }
+  run("  1 case ", message_handler{[](double) { /* nop */ }},
+      make_message(1.), iterations);
+  run(" 10 cases", row<double, int8_t, int16_t, int32_t, int64_t, uint8_t,
+                       uint16_t, uint32_t, uint64_t, float, double>(),
+      make_message(1., 1.), iterations);
+  run("100 cases", rows<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t,
+                        uint32_t, uint64_t, float, double>(),
+      make_message(1., 1.), iterations);
+  shutdown();
+}
@@ -0,0 +1,98 @@
+/******************************************************************************\
+ * This benchmark measures selective receive with a deep message cache. A    *
+ * client sends `messages` messages the testee cannot handle yet, each one   *
+ * followed by a work item. The testee stashes the former while processing  *
+ * the latter, then changes its behavior and drains its cache. This repeats *
+ * for `rounds` rounds.                                                       *
+ *                                                                            *
+ * Usage: deep_stash [messages] [rounds]                                      *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using stash_atom = atom_constant<atom("stash")>;
+using done_atom = atom_constant<atom("done")>;
+
+// handles `n` work items while stashing everything else, then drains the
+// `n` stashed messages and reports to `listener`
+behavior testee(event_based_actor* self, actor listener, size_t n) {
+  auto work = std::make_shared<size_t>(0);
+  auto drained = std::make_shared<size_t>(0);
+  return {
+    [=](uint64_t) {
+      if (++*work < n)
+        return;
+      *work = 0;
+      self->become(
+        keep_behavior,
+        [=](stash_atom, uint64_t) {
+          if (++*drained < n)
+            return;
+          *drained = 0;
+          self->unbecome();
+          self->send(listener, done_atom::value);
+        }
+      );
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: deep_stash [messages] [rounds]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t messages = 10000;
+  size_t rounds = 5;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    messages = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    rounds = std::stoul(argv[2]);
+  }
+  auto t0 = clock_type::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    auto t = spawn(testee, self, messages);
+    for (size_t round = 0; round < rounds; ++round) {
+      for (size_t i = 0; i < messages; ++i) {
+        self->send(t, stash_atom::value, static_cast<uint64_t>(i));
+        self->send(t, static_cast<uint64_t>(i));
+      }
+      self->receive(
+        [](done_atom) {
+          // nop
+        }
+      );
+    }
+    self->send_exit(t, exit_reason::user_shutdown);
+  }
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto total = messages * rounds * 2;
+  cout << total << " messages with up to " << messages << " stashed in "
+       << ms.count() << " ms (" << (total * 1000 / (ms.count() + 1))
+       << " messages/s)" << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,125 @@
+/******************************************************************************\
+ * This benchmark publishes `publishes` messages to a local group with        *
+ * `subscribers` event-based subscribers and reports how many publishes per   *
+ * second the publisher achieves as well as the end-to-end delivery rate.     *
+ * With `churn` set to 1, a second thread keeps joining and leaving the group *
+ * while publishing and the benchmark reports how many membership changes it  *
+ * completed in the meantime.                                                 *
+ *                                                                            *
+ * Usage: group_fanout [subscribers] [publishes] [churn (0|1)]                *
+\******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using tick_atom = atom_constant<atom("tick")>;
+
+using done_atom = atom_constant<atom("done")>;
+
+// reports `done_atom` to `sink` after receiving `publishes` ticks
+behavior subscriber(event_based_actor* self, actor sink, size_t publishes) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](tick_atom) {
+      if (++*received == publishes) {
+        self->send(sink, done_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: group_fanout [subscribers] [publishes] [churn (0|1)]"
+       << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t subscribers = 10000;
+  size_t publishes = 100;
+  bool churn = false;
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    subscribers = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    publishes = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    churn = std::stoul(argv[3]) != 0;
+  }
+  if (subscribers == 0 || publishes == 0) {
+    usage();
+    return 1;
+  }
+  auto grp = group::anonymous();
+  { // lifetime scope of self
+    scoped_actor self;
+    for (size_t i = 0; i < subscribers; ++i) {
+      spawn_in_group(grp, subscriber, self, publishes);
+    }
+    std::atomic<bool> publishing{true};
+    size_t changes = 0;
+    std::thread churner;
+    if (churn) {
+      churner = std::thread{[&] {
+        scoped_actor member;
+        while (publishing) {
+          member->join(grp);
+          member->leave(grp);
+          changes += 2;
+        }
+      }};
+    }
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < publishes; ++i) {
+      anon_send(grp, tick_atom::value);
+    }
+    auto t1 = clock_type::now();
+    publishing = false;
+    if (churner.joinable()) {
+      churner.join();
+    }
+    for (size_t i = 0; i < subscribers; ++i) {
+      self->receive(
+        [](done_atom) {
+          // nop
+        }
+      );
+    }
+    auto t2 = clock_type::now();
+    auto per_sec = [](size_t n, clock_type::duration d) {
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(d);
+      return us.count() > 0 ? n * 1000000 / us.count() : 0;
+    };
+    cout << "subscribers:  " << subscribers << endl
+         << "publishes/s:  " << per_sec(publishes, t1 - t0) << endl
+         << "deliveries/s: "
+         << per_sec(publishes * subscribers, t2 - t0) << endl;
+    if (churn) {
+      cout << "changes:      " << changes << endl;
+    }
+  }
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,132 @@
+/******************************************************************************\
+ * This benchmark sends `messages` messages to each of `workers` actors that  *
+ * write a debug log statement per message and reports the message rate. Mode *
+ * is one of: log, nolog (same workload without log statements). The logger   *
+ * writes to actor_log_*.log in the working directory.                        *
+ *                                                                            *
+ * Usage: log_heavy [log|nolog] [workers] [messages]                          *
+\******************************************************************************/
+
+#include "caf/config.hpp"
+
+// enable log statements of this benchmark, regardless of the build setup
+#undef CAF_LOG_LEVEL
+#define CAF_LOG_LEVEL 3
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+class worker : public event_based_actor {
+public:
+  worker(actor sink, size_t messages, bool enable_log)
+      : sink_(std::move(sink)),
+        messages_(messages),
+        received_(0),
+        enable_log_(enable_log) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [=](int x) {
+        ++received_;
+        if (enable_log_) {
+          CAF_LOG_DEBUG("received " << CAF_ARG(x) << ", " << CAF_ARG(received_)
+                        << " of " << messages_ << " messages");
+        }
+        if (received_ == messages_) {
+          send(sink_, done_atom::value);
+          quit();
+        }
+      }
+    };
+  }
+
+private:
+  actor sink_;
+  size_t messages_;
+  size_t received_;
+  bool enable_log_;
+};
+
+void usage() {
+  cout << "usage: log_heavy [log|nolog] [workers] [messages]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string mode = "log";
+  size_t workers = 100;
+  size_t messages = 10000;
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    mode = argv[1];
+    if (mode != "log" && mode != "nolog") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    workers = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    messages = std::stoul(argv[3]);
+  }
+  if (workers == 0 || messages == 0) {
+    usage();
+    return 1;
+  }
+  clock_type::duration elapsed;
+  { // lifetime scope of self
+    scoped_actor self;
+    std::vector<actor> xs;
+    for (size_t i = 0; i < workers; ++i) {
+      xs.push_back(spawn<worker>(self, messages, mode == "log"));
+    }
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < messages; ++i) {
+      for (auto& x : xs) {
+        anon_send(x, static_cast<int>(i));
+      }
+    }
+    for (size_t i = 0; i < workers; ++i) {
+      self->receive(
+        [](done_atom) {
+          // nop
+        }
+      );
+    }
+    elapsed = clock_type::now() - t0;
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+  auto total = workers * messages;
+  cout << mode << ": " << total << " messages in " << us.count() / 1000
+       << " ms, " << (us.count() > 0 ? total * 1000000 / us.count() : 0)
+       << " msg/s" << endl;
+  await_all_actors_done();
+  // includes writing all pending log records
+  auto t1 = clock_type::now();
+  shutdown();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    clock_type::now() - t1);
+  cout << "shutdown (incl. log flush): " << ms.count() << " ms" << endl;
+}
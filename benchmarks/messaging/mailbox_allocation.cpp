@@ -0,0 +1,97 @@
+/******************************************************************************\
+ * This benchmark floods a single sink with messages from several producers. *
+ * Each message allocates a mailbox element and its content on the thread    *
+ * of the producer, while the sink releases it on another thread, i.e., the  *
+ * benchmark stresses the remote-free path of the memory caches. Prints the  *
+ * message throughput and the peak resident set size of the process.         *
+ *                                                                            *
+ * Usage: mailbox_allocation [producers] [messages per producer]             *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <iostream>
+
+#include <sys/resource.h>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using tick_atom = atom_constant<atom("tick")>;
+using done_atom = atom_constant<atom("done")>;
+
+behavior sink(event_based_actor* self, size_t total, actor listener) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](tick_atom, uint64_t, const std::string&) {
+      if (++*received == total) {
+        self->send(listener, done_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+void producer(event_based_actor* self, actor dest, size_t n) {
+  std::string payload = "payload";
+  for (size_t i = 0; i < n; ++i) {
+    self->send(dest, tick_atom::value, static_cast<uint64_t>(i), payload);
+  }
+}
+
+long peak_rss_kb() {
+  rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_maxrss;
+}
+
+void usage() {
+  cout << "usage: mailbox_allocation [producers] [messages per producer]"
+       << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t producers = 4;
+  size_t messages = 1000000;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    producers = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    messages = std::stoul(argv[2]);
+  }
+  auto t0 = clock_type::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    auto dest = spawn(sink, producers * messages, self);
+    for (size_t i = 0; i < producers; ++i) {
+      spawn(producer, dest, messages);
+    }
+    self->receive(
+      [](done_atom) {
+        // nop
+      }
+    );
+  }
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto total = producers * messages;
+  cout << producers << " producers, " << total << " messages in "
+       << ms.count() << " ms (" << (total * 1000 / (ms.count() + 1))
+       << " msg/s), peak RSS: " << peak_rss_kb() << " kB" << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,157 @@
+/******************************************************************************\
+ * This benchmark overloads a slow consumer with `messages` messages of 1 KB *
+ * from `producers` threads and reports how many messages the consumer       *
+ * handled, the largest mailbox size it observed, and the peak memory usage  *
+ * of the process. Policy is one of: unbounded, drop_newest, drop_oldest,    *
+ * reject. Bounded policies use a capacity of `capacity` messages.           *
+ *                                                                            *
+ * Usage: mailbox_overload [policy] [messages] [producers] [capacity]         *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+#include <iostream>
+
+#include <sys/resource.h>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+using payload = std::vector<char>;
+
+// burns some cycles for each message and answers `done_atom`
+// with the number of handled messages and the largest mailbox size
+class consumer : public event_based_actor {
+public:
+  consumer(size_t capacity, overflow_policy policy)
+      : handled_(0),
+        max_size_(0) {
+    if (capacity > 0)
+      bound_mailbox(capacity, policy);
+  }
+
+  behavior make_behavior() override {
+    return {
+      [=](const payload& x) {
+        ++handled_;
+        max_size_ = std::max(max_size_, mailbox().count());
+        uint64_t y = x.size();
+        for (int i = 0; i < 5000; ++i)
+          y = y * 31 + static_cast<uint64_t>(i);
+        if (y == 42)
+          cout << "this never happens" << endl;
+      },
+      [=](done_atom) {
+        return make_message(handled_, max_size_);
+      }
+    };
+  }
+
+private:
+  size_t handled_;
+  size_t max_size_;
+};
+
+void usage() {
+  cout << "usage: mailbox_overload [unbounded|drop_newest|drop_oldest|reject] "
+          "[messages] [producers] [capacity]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string policy = "drop_newest";
+  size_t messages = 200000;
+  size_t producers = 2;
+  size_t capacity = local_actor::default_mailbox_capacity;
+  overflow_policy op = overflow_policy::reject;
+  if (argc > 5) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    policy = argv[1];
+  }
+  if (argc > 2) {
+    messages = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    producers = std::stoul(argv[3]);
+  }
+  if (argc > 4) {
+    capacity = std::stoul(argv[4]);
+  }
+  if (policy == "unbounded") {
+    capacity = 0;
+  } else if (policy == "drop_newest") {
+    op = overflow_policy::drop_newest;
+  } else if (policy == "drop_oldest") {
+    op = overflow_policy::drop_oldest;
+  } else if (policy == "reject") {
+    op = overflow_policy::reject;
+  } else {
+    usage();
+    return 1;
+  }
+  auto t0 = clock_type::now();
+  size_t handled = 0;
+  size_t max_size = 0;
+  { // lifetime scope of self
+    scoped_actor self;
+    auto c = spawn<consumer>(capacity, op);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i) {
+      threads.emplace_back([=] {
+        payload x(1024);
+        for (size_t j = 0; j < messages / producers; ++j)
+          anon_send(c, x);
+      });
+    }
+    for (auto& t : threads)
+      t.join();
+    // our request can get dropped as well, so we retry until it arrives
+    auto done = false;
+    while (! done) {
+      self->sync_send(c, done_atom::value).await(
+        [&](size_t x, size_t y) {
+          handled = x;
+          max_size = y;
+          done = true;
+        },
+        [](const sync_exited_msg& x) {
+          if (x.reason != exit_reason::mailbox_overflow)
+            throw std::logic_error("consumer terminated unexpectedly");
+          // rejected, try again
+        },
+        after(std::chrono::milliseconds(100)) >> [] {
+          // dropped, try again
+        }
+      );
+    }
+    anon_send_exit(c, exit_reason::user_shutdown);
+  }
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  rusage usage_info;
+  getrusage(RUSAGE_SELF, &usage_info);
+  cout << policy << ": handled " << handled << " of " << messages
+       << " messages in " << ms.count() << " ms, max. mailbox size: "
+       << max_size << ", max. RSS: " << (usage_info.ru_maxrss / 1024) << " MB"
+       << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,157 @@
+/******************************************************************************\
+ * This benchmark measures how fast a single actor drains its mailbox while  *
+ * `producers` threads send `messages` messages each. On Linux, it also       *
+ * reports hardware cache misses of the whole process if the kernel allows   *
+ * reading performance counters.                                              *
+ *                                                                            *
+ * Usage: mailbox_throughput [producers] [messages]                           *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+#ifdef CAF_LINUX
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+// counts cache misses of this process and all threads it starts afterwards
+class cache_miss_counter {
+public:
+  cache_miss_counter() : fd_(-1) {
+#   ifdef CAF_LINUX
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#   endif
+  }
+
+  ~cache_miss_counter() {
+#   ifdef CAF_LINUX
+    if (fd_ >= 0)
+      close(fd_);
+#   endif
+  }
+
+  bool available() const {
+    return fd_ >= 0;
+  }
+
+  void start() {
+#   ifdef CAF_LINUX
+    if (fd_ >= 0)
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#   endif
+  }
+
+  uint64_t stop() {
+    uint64_t result = 0;
+#   ifdef CAF_LINUX
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &result, sizeof(result)) != sizeof(result))
+        result = 0;
+    }
+#   endif
+    return result;
+  }
+
+private:
+  int fd_;
+};
+
+behavior consumer(event_based_actor* self, actor listener, size_t total) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](uint64_t) {
+      if (++*received == total) {
+        self->send(listener, done_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: mailbox_throughput [producers] [messages]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t producers = 4;
+  size_t messages = 1000000;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    producers = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    messages = std::stoul(argv[2]);
+  }
+  // must be created before CAF starts any thread to count all of them
+  cache_miss_counter counter;
+  counter.start();
+  auto t0 = clock_type::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    auto c = spawn(consumer, self, producers * messages);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < producers; ++i) {
+      threads.emplace_back([=] {
+        for (size_t j = 0; j < messages; ++j)
+          anon_send(c, static_cast<uint64_t>(j));
+      });
+    }
+    for (auto& t : threads)
+      t.join();
+    self->receive(
+      [](done_atom) {
+        // nop
+      }
+    );
+  }
+  auto t1 = clock_type::now();
+  auto misses = counter.stop();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto total = producers * messages;
+  cout << total << " messages from " << producers << " producers in "
+       << ms.count() << " ms (" << (total * 1000 / (ms.count() + 1))
+       << " messages/s), ";
+  if (counter.available())
+    cout << misses << " cache misses (" << (misses / total) << " per message)";
+  else
+    cout << "cache misses not available";
+  cout << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,117 @@
+/******************************************************************************\
+ * This benchmark delivers `messages` messages to `receivers` event-based     *
+ * actors and reports how many deliveries per second the sender achieves.     *
+ * Mode is one of: per_receiver (one `enqueue(sender, mid, msg, host)` call   *
+ * per receiver) or batch (`mailbox_element::make_n` allocating all elements  *
+ * of a message at once).                                                     *
+ *                                                                            *
+ * Usage: multicast [per_receiver|batch] [receivers] [messages]               *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using tick_atom = atom_constant<atom("tick")>;
+
+using done_atom = atom_constant<atom("done")>;
+
+// reports `done_atom` to `sink` after receiving `messages` ticks
+behavior receiver(event_based_actor* self, actor sink, size_t messages) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](tick_atom) {
+      if (++*received == messages) {
+        self->send(sink, done_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: multicast [per_receiver|batch] [receivers] [messages]"
+       << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string mode = "batch";
+  size_t receivers = 1000;
+  size_t messages = 1000;
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    mode = argv[1];
+    if (mode != "per_receiver" && mode != "batch") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    receivers = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    messages = std::stoul(argv[3]);
+  }
+  if (receivers == 0 || messages == 0) {
+    usage();
+    return 1;
+  }
+  { // lifetime scope of self
+    scoped_actor self;
+    std::vector<actor> xs;
+    for (size_t i = 0; i < receivers; ++i) {
+      xs.push_back(spawn(receiver, self, messages));
+    }
+    auto msg = make_message(tick_atom::value);
+    auto sender = self->address();
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < messages; ++i) {
+      if (mode == "batch") {
+        auto j = xs.begin();
+        mailbox_element::make_n(xs.size(), sender, invalid_message_id, msg,
+                                [&](mailbox_element_ptr ptr) {
+          (*j++)->enqueue(std::move(ptr), nullptr);
+        });
+      } else {
+        for (auto& x : xs) {
+          x->enqueue(sender, invalid_message_id, msg, nullptr);
+        }
+      }
+    }
+    auto t1 = clock_type::now();
+    for (size_t i = 0; i < receivers; ++i) {
+      self->receive(
+        [](done_atom) {
+          // nop
+        }
+      );
+    }
+    auto t2 = clock_type::now();
+    auto per_sec = [](size_t n, clock_type::duration d) {
+      auto us = std::chrono::duration_cast<std::chrono::microseconds>(d);
+      return us.count() > 0 ? n * 1000000 / us.count() : 0;
+    };
+    cout << mode << ": " << receivers << " receivers" << endl
+         << "enqueues/s:   " << per_sec(messages * receivers, t1 - t0) << endl
+         << "deliveries/s: " << per_sec(messages * receivers, t2 - t0) << endl;
+  }
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,112 @@
+/******************************************************************************\
+ * This benchmark measures response handling in an actor with many           *
+ * outstanding requests. An aggregator sends `requests` requests to a worker *
+ * and waits for all responses before starting the next of `rounds` rounds. *
+ * The worker answers once it has received all requests of a round, newest   *
+ * first, since event-based actors handle the most recent response first.   *
+ *                                                                            *
+ * Usage: pending_responses [requests] [rounds]                               *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using done_atom = atom_constant<atom("done")>;
+
+// collects `n` requests and then answers them in reverse order, i.e.,
+// each response completes the most recent request of the aggregator
+behavior worker(event_based_actor* self, size_t n) {
+  auto promises = std::make_shared<std::vector<response_promise>>();
+  return {
+    [=](uint64_t) {
+      promises->push_back(self->make_response_promise());
+      if (promises->size() < n)
+        return;
+      for (auto i = promises->rbegin(); i != promises->rend(); ++i)
+        i->deliver(make_message(uint64_t{0}));
+      promises->clear();
+    }
+  };
+}
+
+void aggregator(event_based_actor* self, actor listener, size_t requests,
+                size_t rounds) {
+  auto w = spawn(worker, requests);
+  auto pending = std::make_shared<size_t>(0);
+  auto remaining_rounds = std::make_shared<size_t>(rounds);
+  auto run_round = std::make_shared<std::function<void ()>>();
+  *run_round = [=] {
+    *pending = requests;
+    for (size_t i = 0; i < requests; ++i) {
+      self->sync_send(w, static_cast<uint64_t>(i)).then(
+        [=](uint64_t) {
+          if (--*pending > 0)
+            return;
+          if (--*remaining_rounds > 0) {
+            (*run_round)();
+            return;
+          }
+          self->send(listener, done_atom::value);
+          self->send_exit(w, exit_reason::user_shutdown);
+          // break the cycle between `run_round` and its closure
+          *run_round = nullptr;
+          self->quit();
+        }
+      );
+    }
+  };
+  (*run_round)();
+}
+
+void usage() {
+  cout << "usage: pending_responses [requests] [rounds]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t requests = 10000;
+  size_t rounds = 20;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    requests = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    rounds = std::stoul(argv[2]);
+  }
+  auto t0 = clock_type::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    spawn(aggregator, self, requests, rounds);
+    self->receive(
+      [](done_atom) {
+        // nop
+      }
+    );
+  }
+  auto t1 = clock_type::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  auto total = requests * rounds;
+  cout << total << " responses with " << requests << " outstanding requests in "
+       << ms.count() << " ms (" << (total * 1000 / (ms.count() + 1))
+       << " responses/s)" << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,112 @@
+/******************************************************************************\
+ * This benchmark runs `threads` threads performing `iterations` rounds of    *
+ * registry operations each. Every round registers an actor under a new ID,   *
+ * looks up `lookups` IDs registered by any thread, and finally erases the    *
+ * new ID again, i.e., mimics spawning, addressing (e.g., by BASP), and       *
+ * terminating actors. Reports the total number of operations per second.     *
+ *                                                                            *
+ * Usage: actor_registry [threads] [iterations] [lookups]                     *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/actor_registry.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+behavior dummy() {
+  return {
+    others >> [] {
+      // nop
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: actor_registry [threads] [iterations] [lookups]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t threads = 4;
+  size_t iterations = 100000;
+  size_t lookups = 10;
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    threads = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    iterations = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    lookups = std::stoul(argv[3]);
+  }
+  if (threads == 0) {
+    usage();
+    return 1;
+  }
+  auto reg = detail::singletons::get_actor_registry();
+  // registering an actor under an ID of its own would require spawning
+  // (and terminating) one actor per round, hence each thread registers
+  // a dummy actor under new IDs instead; since each registration attaches
+  // a cleanup functor to the actor, threads start a new dummy actor every
+  // `rounds_per_dummy` rounds
+  const size_t rounds_per_dummy = 1024;
+  std::vector<std::vector<actor>> dummies(threads);
+  // start far above regular actor IDs
+  actor_id first_id = 1000000000;
+  auto t0 = clock_type::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      abstract_actor_ptr ptr;
+      for (size_t i = 0; i < iterations; ++i) {
+        if (i % rounds_per_dummy == 0) {
+          dummies[t].push_back(spawn(dummy));
+          ptr = actor_cast<abstract_actor_ptr>(dummies[t].back());
+        }
+        auto id = static_cast<actor_id>(first_id + i * threads + t);
+        reg->put(id, ptr);
+        for (size_t j = 0; j < lookups; ++j) {
+          // look up recently registered IDs of all threads
+          auto other = id - static_cast<actor_id>(j * 7 % (i * threads + 1));
+          static_cast<void>(reg->get_entry(other));
+        }
+        reg->erase(id, exit_reason::normal);
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  auto t1 = clock_type::now();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+  auto ops = threads * iterations * (lookups + 2);
+  cout << threads << " threads: " << ops << " ops in " << us.count() / 1000
+       << " ms, " << (us.count() > 0 ? ops * 1000000 / us.count() : 0)
+       << " ops/s" << endl;
+  for (auto& vec : dummies) {
+    for (auto& d : vec) {
+      anon_send_exit(d, exit_reason::user_shutdown);
+    }
+  }
+  await_all_actors_done();
+  shutdown();
+}
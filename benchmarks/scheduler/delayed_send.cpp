@@ -0,0 +1,85 @@
+/******************************************************************************\
+ * This benchmark measures the cost of scheduling and cancelling delayed      *
+ * messages while many other timers are pending. It first schedules a large   *
+ * number of long-running timers and then repeatedly schedules and cancels    *
+ * short timers, e.g., as actors with receive timeouts do on every message.   *
+ *                                                                            *
+ * Usage: delayed_send [pending] [iterations]                                 *
+\******************************************************************************/
+
+#include <vector>
+#include <chrono>
+#include <string>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+void usage() {
+  cout << "usage: delayed_send [pending] [iterations]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t pending = 1000000;
+  size_t iterations = 1000000;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    pending = std::stoul(argv[1]);
+  }
+  if (argc > 2) {
+    iterations = std::stoul(argv[2]);
+  }
+  auto sink = spawn([](event_based_actor*) -> behavior {
+    return {
+      others >> [] {
+        // nop
+      }
+    };
+  });
+  auto sched = detail::singletons::get_scheduling_coordinator();
+  auto msg = make_message(atom("tick"));
+  std::vector<scheduler::abstract_coordinator::timer_handle> hdls;
+  hdls.reserve(pending);
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < pending; ++i) {
+    // spread timers over all levels of the wheel
+    auto d = std::chrono::milliseconds(1000 + (i * 7919) % 3600000);
+    hdls.push_back(sched->delayed_send(d, invalid_actor_addr, sink,
+                                       invalid_message_id, msg));
+  }
+  auto t1 = clock_type::now();
+  for (size_t i = 0; i < iterations; ++i) {
+    auto hdl = sched->delayed_send(std::chrono::milliseconds(500),
+                                   invalid_actor_addr, sink,
+                                   invalid_message_id, msg);
+    sched->cancel_delayed_send(hdl);
+  }
+  auto t2 = clock_type::now();
+  for (auto& hdl : hdls) {
+    sched->cancel_delayed_send(hdl);
+  }
+  auto t3 = clock_type::now();
+  auto ns = [](clock_type::duration d, size_t n) {
+    auto x = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return n > 0 ? static_cast<double>(x) / n : 0.;
+  };
+  cout << "schedule:          " << ns(t1 - t0, pending) << " ns/op" << endl
+       << "schedule + cancel: " << ns(t2 - t1, iterations) << " ns/op" << endl
+       << "cancel:            " << ns(t3 - t2, pending) << " ns/op" << endl;
+  anon_send_exit(sink, exit_reason::user_shutdown);
+  await_all_actors_done();
+  shutdown();
+}
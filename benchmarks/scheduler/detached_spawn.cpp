@@ -0,0 +1,85 @@
+/******************************************************************************\
+ * This benchmark spawns `actors` detached actors one after another, sends    *
+ * each one a request and waits for its reply before spawning the next one.   *
+ * It reports the spawn rate, i.e., mostly the cost of acquiring a thread for *
+ * each actor. Type is one of: detached, blocking (blocking_api actors).      *
+ *                                                                            *
+ * Usage: detached_spawn [detached|blocking] [actors]                         *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+behavior event_based_worker(event_based_actor* self) {
+  return {
+    [=](int x) {
+      self->quit();
+      return x + 1;
+    }
+  };
+}
+
+void blocking_worker(blocking_actor* self) {
+  self->receive(
+    [](int x) {
+      return x + 1;
+    }
+  );
+}
+
+void usage() {
+  cout << "usage: detached_spawn [detached|blocking] [actors]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string type = "detached";
+  size_t actors = 10000;
+  if (argc > 3) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    type = argv[1];
+    if (type != "detached" && type != "blocking") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    actors = std::stoul(argv[2]);
+  }
+  auto t0 = clock_type::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    for (size_t i = 0; i < actors; ++i) {
+      auto worker = type == "detached" ? spawn<detached>(event_based_worker)
+                                       : spawn<blocking_api>(blocking_worker);
+      self->sync_send(worker, static_cast<int>(i)).await(
+        [](int) {
+          // nop
+        }
+      );
+    }
+  }
+  auto t1 = clock_type::now();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0);
+  cout << type << ": " << actors << " actors in " << us.count() / 1000
+       << " ms, " << (us.count() > 0 ? actors * 1000000 / us.count() : 0)
+       << " actors/s" << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,116 @@
+/******************************************************************************\
+ * This benchmark passes `tokens` tokens around a ring of `actors` actors for *
+ * `rounds` rounds and reports the message rate. Mode is one of: disabled,    *
+ * enabled (collects runtime metrics and prints them at the end).             *
+ *                                                                            *
+ * Usage: metrics_overhead [mode] [actors] [tokens] [rounds]                  *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using next_atom = atom_constant<atom("next")>;
+
+// forwards tokens to the next actor until a token completed `rounds` rounds
+behavior ring_node(event_based_actor* self, actor sink) {
+  return {
+    [=](next_atom, const actor& next) {
+      self->become(
+        [=](int remaining) {
+          if (remaining == 0)
+            self->send(sink, remaining);
+          else
+            self->send(next, remaining - 1);
+        }
+      );
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: metrics_overhead [disabled|enabled] "
+          "[actors] [tokens] [rounds]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string mode = "disabled";
+  size_t actors = 100;
+  size_t tokens = 1;
+  size_t rounds = 5000;
+  if (argc > 5) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    mode = argv[1];
+    if (mode != "disabled" && mode != "enabled") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    actors = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    tokens = std::stoul(argv[3]);
+  }
+  if (argc > 4) {
+    rounds = std::stoul(argv[4]);
+  }
+  if (actors == 0 || tokens == 0) {
+    usage();
+    return 1;
+  }
+  metrics::enable(mode == "enabled");
+  clock_type::duration elapsed;
+  { // lifetime scope of self
+    scoped_actor self;
+    std::vector<actor> xs;
+    for (size_t i = 0; i < actors; ++i) {
+      xs.push_back(spawn(ring_node, self));
+    }
+    for (size_t i = 0; i < actors; ++i) {
+      anon_send(xs[i], next_atom::value, xs[(i + 1) % actors]);
+    }
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < tokens; ++i) {
+      anon_send(xs[i % actors], static_cast<int>(rounds * actors));
+    }
+    for (size_t i = 0; i < tokens; ++i) {
+      self->receive(
+        [](int) {
+          // nop
+        }
+      );
+    }
+    elapsed = clock_type::now() - t0;
+    for (auto& x : xs) {
+      anon_send_exit(x, exit_reason::user_shutdown);
+    }
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+  auto total = tokens * (rounds * actors + 1);
+  cout << mode << ": " << total << " messages in " << us.count() / 1000
+       << " ms, " << (us.count() > 0 ? total * 1000000 / us.count() : 0)
+       << " msg/s" << endl;
+  if (metrics::enabled()) {
+    cout << to_string(metrics::take_snapshot());
+  }
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,131 @@
+/******************************************************************************\
+ * This benchmark passes `tokens` tokens around a ring of `actors` actors for *
+ * `rounds` rounds, i.e., each resume handles only a few messages, and        *
+ * reports the message rate. Mode is one of: default (no profiling),          *
+ * profiled (measures each resume), sampled (measures every 100th resume).    *
+ * Profiler output goes to `file`.                                            *
+ *                                                                            *
+ * Usage: profiler_overhead [mode] [actors] [tokens] [rounds] [file]          *
+\******************************************************************************/
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+#include "caf/scheduler/profiled_coordinator.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using next_atom = atom_constant<atom("next")>;
+
+// forwards tokens to the next actor until a token completed `rounds` rounds
+behavior ring_node(event_based_actor* self, actor sink) {
+  return {
+    [=](next_atom, const actor& next) {
+      self->become(
+        [=](int remaining) {
+          if (remaining == 0)
+            self->send(sink, remaining);
+          else
+            self->send(next, remaining - 1);
+        }
+      );
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: profiler_overhead [default|profiled|sampled] "
+          "[actors] [tokens] [rounds] [file]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string mode = "default";
+  size_t actors = 100;
+  size_t tokens = 100;
+  size_t rounds = 100;
+  std::string file = "/dev/null";
+  if (argc > 6) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    mode = argv[1];
+    if (mode != "default" && mode != "profiled" && mode != "sampled") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    actors = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    tokens = std::stoul(argv[3]);
+  }
+  if (argc > 4) {
+    rounds = std::stoul(argv[4]);
+  }
+  if (argc > 5) {
+    file = argv[5];
+  }
+  if (actors == 0 || tokens == 0) {
+    usage();
+    return 1;
+  }
+  auto workers = std::max(std::thread::hardware_concurrency(), 4u);
+  auto mt = std::numeric_limits<size_t>::max();
+  if (mode == "profiled") {
+    set_scheduler(new scheduler::profiled_coordinator<>{
+      file, std::chrono::milliseconds{1000}, workers, mt, 1});
+  } else if (mode == "sampled") {
+    set_scheduler(new scheduler::profiled_coordinator<>{
+      file, std::chrono::milliseconds{1000}, workers, mt, 100});
+  }
+  clock_type::duration elapsed;
+  { // lifetime scope of self
+    scoped_actor self;
+    std::vector<actor> xs;
+    for (size_t i = 0; i < actors; ++i) {
+      xs.push_back(spawn(ring_node, self));
+    }
+    for (size_t i = 0; i < actors; ++i) {
+      anon_send(xs[i], next_atom::value, xs[(i + 1) % actors]);
+    }
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < tokens; ++i) {
+      anon_send(xs[i % actors], static_cast<int>(rounds * actors));
+    }
+    for (size_t i = 0; i < tokens; ++i) {
+      self->receive(
+        [](int) {
+          // nop
+        }
+      );
+    }
+    elapsed = clock_type::now() - t0;
+    for (auto& x : xs) {
+      anon_send_exit(x, exit_reason::user_shutdown);
+    }
+  }
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+  auto total = tokens * (rounds * actors + 1);
+  cout << mode << ": " << total << " messages in " << us.count() / 1000
+       << " ms, " << (us.count() > 0 ? total * 1000000 / us.count() : 0)
+       << " msg/s" << endl;
+  await_all_actors_done();
+  shutdown();
+}
@@ -0,0 +1,100 @@
+/******************************************************************************\
+ * This benchmark runs a recursive fork/join workload and reports how many    *
+ * jobs workers stole from workers sharing a cache, from workers on the same  *
+ * NUMA node, and from workers on other nodes when running the work-stealing  *
+ * scheduler in topology-aware mode.                                          *
+ *                                                                            *
+ * Usage: steal_locality [depth] [workers] [topology_aware (0|1)]             *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using coordinator_type = scheduler::coordinator<policy::work_stealing>;
+
+// spawns two children per level and sums up the results of the leaves
+behavior tree_node(event_based_actor* self, actor parent, int depth) {
+  if (depth == 0) {
+    // burn some cycles to give other workers a chance to steal
+    uint64_t x = 0;
+    for (int i = 0; i < 10000; ++i) {
+      x = x * 31 + static_cast<uint64_t>(i);
+    }
+    self->send(parent, static_cast<int>(x & 1) + 1);
+    self->quit();
+    return {};
+  }
+  spawn(tree_node, self, depth - 1);
+  spawn(tree_node, self, depth - 1);
+  auto pending = std::make_shared<int>(2);
+  auto sum = std::make_shared<int>(0);
+  return {
+    [=](int x) {
+      *sum += x;
+      if (--*pending == 0) {
+        self->send(parent, *sum);
+        self->quit();
+      }
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  int depth = 16;
+  size_t workers = std::thread::hardware_concurrency();
+  bool topology_aware = true;
+  if (argc > 1) {
+    depth = std::stoi(argv[1]);
+  }
+  if (argc > 2) {
+    workers = static_cast<size_t>(std::stoul(argv[2]));
+  }
+  if (argc > 3) {
+    topology_aware = std::stoi(argv[3]) != 0;
+  }
+  auto sched = new coordinator_type(workers,
+                                    std::numeric_limits<size_t>::max());
+  sched->data().cfg.topology_aware = topology_aware;
+  set_scheduler(sched);
+  auto t0 = std::chrono::steady_clock::now();
+  { // lifetime scope of self
+    scoped_actor self;
+    spawn(tree_node, self, depth);
+    self->receive(
+      [&](int) {
+        // nop
+      }
+    );
+  }
+  await_all_actors_done();
+  auto t1 = std::chrono::steady_clock::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
+  cout << "depth: " << depth << ", workers: " << workers
+       << ", topology-aware: " << std::boolalpha << topology_aware
+       << ", runtime: " << ms.count() << " ms" << endl;
+  const char* names[] = {"shared cache", "same node", "remote node"};
+  size_t totals[detail::num_cpu_distances] = {};
+  for (size_t i = 0; i < workers; ++i) {
+    auto& wd = sched->worker_by_id(i)->data();
+    for (size_t j = 0; j < detail::num_cpu_distances; ++j) {
+      totals[j] += wd.steals[j].load();
+    }
+  }
+  for (size_t j = 0; j < detail::num_cpu_distances; ++j) {
+    cout << "steals from " << names[j] << ": " << totals[j] << endl;
+  }
+  shutdown();
+}
@@ -0,0 +1,137 @@
+/******************************************************************************\
+ * This benchmark lets a supervisor keep `children` actors alive while it     *
+ * restarts one of them `rounds` times, then terminates the supervisor and    *
+ * all of its children. Mode is one of: link (children are linked to the      *
+ * supervisor, which traps exits) or monitor (children monitor the supervisor *
+ * and demonitor it before quitting, while the supervisor monitors them).     *
+ * It reports restarts per second and the time for tearing everything down.   *
+ *                                                                            *
+ * Usage: supervisor_churn [link|monitor] [children] [rounds]                 *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using stop_atom = atom_constant<atom("stop")>;
+
+behavior linked_child() {
+  return {
+    others >> [] {
+      // nop
+    }
+  };
+}
+
+behavior monitoring_child(event_based_actor* self, actor supervisor) {
+  self->monitor(supervisor);
+  return {
+    [=](stop_atom) {
+      self->demonitor(supervisor);
+      self->quit();
+    },
+    [=](const down_msg&) {
+      self->quit();
+    }
+  };
+}
+
+void usage() {
+  cout << "usage: supervisor_churn [link|monitor] [children] [rounds]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  std::string mode = "link";
+  size_t children = 50000;
+  size_t rounds = 10000;
+  if (argc > 4) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    mode = argv[1];
+    if (mode != "link" && mode != "monitor") {
+      usage();
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    children = std::stoul(argv[2]);
+  }
+  if (argc > 3) {
+    rounds = std::stoul(argv[3]);
+  }
+  if (children == 0) {
+    usage();
+    return 1;
+  }
+  clock_type::time_point t1;
+  clock_type::time_point t2;
+  { // lifetime scope of self
+    scoped_actor self;
+    self->trap_exit(true);
+    auto start = [&]() -> actor {
+      if (mode == "link") {
+        return self->spawn<linked>(linked_child);
+      }
+      return self->spawn<monitored>(monitoring_child, self);
+    };
+    std::vector<actor> xs;
+    for (size_t i = 0; i < children; ++i) {
+      xs.push_back(start());
+    }
+    auto t0 = clock_type::now();
+    for (size_t i = 0; i < rounds; ++i) {
+      auto& x = xs[i % children];
+      if (mode == "link") {
+        self->send_exit(x, exit_reason::user_shutdown);
+        self->receive(
+          [](const exit_msg&) {
+            // nop
+          }
+        );
+      } else {
+        self->send(x, stop_atom::value);
+        self->receive(
+          [](const down_msg&) {
+            // nop
+          }
+        );
+      }
+      x = start();
+    }
+    t1 = clock_type::now();
+    cout << mode << ": " << rounds << " restarts with " << children
+         << " children in "
+         << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0)
+            .count()
+         << " ms, "
+         << static_cast<size_t>(rounds
+                                / std::chrono::duration<double>(t1 - t0)
+                                  .count())
+         << " restarts/s" << endl;
+    // linked children ignore normal exits
+    self->planned_exit_reason(exit_reason::user_shutdown);
+    t1 = clock_type::now();
+  }
+  await_all_actors_done();
+  t2 = clock_type::now();
+  cout << "teardown: "
+       << std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count()
+       << " ms" << endl;
+  shutdown();
+}
@@ -0,0 +1,105 @@
+/******************************************************************************\
+ * This benchmark measures how long it takes for an idle scheduler to pick up *
+ * a new message. An external thread periodically sends a timestamp to an     *
+ * actor after an idle period, which forwards it to a second actor that       *
+ * records the end-to-end latency. Running it with a huge spin budget mimics  *
+ * the old polling strategy, a small spin budget parks workers quickly.       *
+ *                                                                            *
+ * Usage: wakeup_latency [samples] [idle_ms] [spin_attempts] [workers]        *
+\******************************************************************************/
+
+#include <vector>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <cstdint>
+#include <iostream>
+#include <algorithm>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+int64_t now_ns() {
+  auto t = clock_type::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
+
+behavior ping(event_based_actor* self, actor pong) {
+  return {
+    [=](int64_t timestamp) {
+      self->send(pong, timestamp);
+    }
+  };
+}
+
+behavior pong(event_based_actor* self) {
+  auto samples = std::make_shared<std::vector<int64_t>>();
+  return {
+    [=](int64_t timestamp) {
+      samples->push_back(now_ns() - timestamp);
+    },
+    [=](get_atom) -> message {
+      auto& xs = *samples;
+      if (xs.empty()) {
+        return make_message(int64_t{0}, int64_t{0}, int64_t{0});
+      }
+      std::sort(xs.begin(), xs.end());
+      auto at = [&](double percentile) {
+        auto i = static_cast<size_t>(percentile * (xs.size() - 1));
+        return xs[i] / 1000;
+      };
+      self->quit();
+      return make_message(at(.5), at(.99), xs.back() / 1000);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t samples = 1000;
+  size_t idle_ms = 2;
+  policy::work_stealing::config cfg;
+  size_t workers = std::thread::hardware_concurrency();
+  if (argc > 1) {
+    samples = static_cast<size_t>(std::stoul(argv[1]));
+  }
+  if (argc > 2) {
+    idle_ms = static_cast<size_t>(std::stoul(argv[2]));
+  }
+  if (argc > 3) {
+    cfg.spin_attempts = static_cast<size_t>(std::stoul(argv[3]));
+  }
+  if (argc > 4) {
+    workers = static_cast<size_t>(std::stoul(argv[4]));
+  }
+  set_scheduler<>(workers, std::numeric_limits<size_t>::max(), cfg);
+  auto pg = spawn(pong);
+  auto p = spawn(ping, pg);
+  for (size_t i = 0; i < samples; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(idle_ms));
+    anon_send(p, now_ns());
+  }
+  { // lifetime scope of self
+    scoped_actor self;
+    self->sync_send(pg, get_atom::value).await(
+      [&](int64_t p50, int64_t p99, int64_t max) {
+        cout << "samples: " << samples << ", idle period: " << idle_ms
+             << " ms, spin attempts: " << cfg.spin_attempts << endl
+             << "wake-up latency (us): p50 = " << p50 << ", p99 = " << p99
+             << ", max = " << max << endl;
+      }
+    );
+  }
+  anon_send_exit(p, exit_reason::user_shutdown);
+  await_all_actors_done();
+  shutdown();
+}
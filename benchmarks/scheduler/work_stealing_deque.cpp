@@ -0,0 +1,160 @@
+/******************************************************************************\
+ * This benchmark compares the spinlocked, linked-list based                  *
+ * double_ended_queue with the lock-free work_stealing_deque that backs the   *
+ * job queue of policy::work_stealing.                                        *
+ *                                                                            *
+ * Usage: work_stealing_deque [max_thieves] [num_jobs]                        *
+\******************************************************************************/
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf::detail;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct job {
+  size_t value;
+};
+
+// unifies the interface of both queues: the owner pushes and takes LIFO,
+// thieves take the oldest element
+struct old_queue {
+  double_ended_queue<job> q;
+  static const char* name() {
+    return "double_ended_queue";
+  }
+  void push(job* x) {
+    q.prepend(x);
+  }
+  job* take() {
+    return q.take_head();
+  }
+  job* steal() {
+    return q.take_tail();
+  }
+};
+
+struct new_queue {
+  work_stealing_deque<job> q;
+  static const char* name() {
+    return "work_stealing_deque";
+  }
+  void push(job* x) {
+    q.push(x);
+  }
+  job* take() {
+    return q.take();
+  }
+  job* steal() {
+    return q.steal();
+  }
+};
+
+template <class Queue>
+double owner_with_thieves(size_t num_thieves, std::vector<job>& jobs) {
+  Queue q;
+  std::atomic<bool> done{false};
+  std::atomic<size_t> consumed{0};
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i) {
+    thieves.emplace_back([&] {
+      size_t n = 0;
+      while (! done) {
+        if (q.steal()) {
+          ++n;
+        }
+      }
+      consumed += n;
+    });
+  }
+  auto t0 = clock_type::now();
+  size_t n = 0;
+  // push bursts of 8 jobs and run half of them ourselves
+  for (size_t i = 0; i < jobs.size(); i += 8) {
+    for (size_t j = i; j < i + 8 && j < jobs.size(); ++j) {
+      q.push(&jobs[j]);
+    }
+    for (size_t j = 0; j < 4; ++j) {
+      if (q.take()) {
+        ++n;
+      }
+    }
+  }
+  while (q.take()) {
+    ++n;
+  }
+  done = true;
+  for (auto& t : thieves) {
+    t.join();
+  }
+  auto t1 = clock_type::now();
+  consumed += n;
+  if (consumed != jobs.size()) {
+    cout << "*** lost or duplicated jobs: " << consumed << " of "
+         << jobs.size() << endl;
+  }
+  std::chrono::duration<double> secs = t1 - t0;
+  return static_cast<double>(jobs.size()) / secs.count();
+}
+
+template <class Queue>
+double steal_from_long_queue(std::vector<job>& jobs) {
+  Queue q;
+  for (auto& x : jobs) {
+    q.push(&x);
+  }
+  auto t0 = clock_type::now();
+  size_t n = 0;
+  while (q.steal()) {
+    ++n;
+  }
+  auto t1 = clock_type::now();
+  std::chrono::duration<double> secs = t1 - t0;
+  return static_cast<double>(n) / secs.count();
+}
+
+void print_row(const char* name, size_t thieves, double ops) {
+  cout << std::setw(22) << std::left << name
+       << std::setw(10) << std::right << thieves
+       << std::setw(16) << static_cast<size_t>(ops) << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t max_thieves = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  size_t num_jobs = 1000000;
+  if (argc > 1) {
+    max_thieves = static_cast<size_t>(std::stoul(argv[1]));
+  }
+  if (argc > 2) {
+    num_jobs = static_cast<size_t>(std::stoul(argv[2]));
+  }
+  std::vector<job> jobs(num_jobs);
+  cout << "owner pushing and popping with concurrent thieves (jobs/s)" << endl;
+  for (size_t t = 0; t <= max_thieves; t = t == 0 ? 1 : t * 2) {
+    print_row(old_queue::name(), t, owner_with_thieves<old_queue>(t, jobs));
+    print_row(new_queue::name(), t, owner_with_thieves<new_queue>(t, jobs));
+  }
+  // stealing from the old queue is O(n), keep its input reasonably short
+  std::vector<job> few_jobs(std::min(num_jobs, size_t{20000}));
+  cout << endl << "stealing " << few_jobs.size()
+       << " jobs from a single queue (steals/s)" << endl;
+  print_row(old_queue::name(), 1, steal_from_long_queue<old_queue>(few_jobs));
+  print_row(new_queue::name(), 1, steal_from_long_queue<new_queue>(few_jobs));
+}
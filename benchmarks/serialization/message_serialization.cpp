@@ -0,0 +1,130 @@
+/******************************************************************************\
+ * This benchmark compares the throughput and the size of serialized          *
+ * messages for two wire formats. The legacy format writes the full type name *
+ * of each message, e.g., `@<>+@atom+@i32`, and resolves all element types by *
+ * name. The compact format writes type numbers for builtin types and 64-bit  *
+ * type IDs for announced types.                                              *
+ *                                                                            *
+ * Usage: message_serialization [iterations]                                  *
+\******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iterator>
+
+#include "caf/all.hpp"
+#include "caf/binary_serializer.hpp"
+#include "caf/binary_deserializer.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using buffer = std::vector<char>;
+
+struct foo {
+  int a;
+  int b;
+};
+
+bool operator==(const foo& lhs, const foo& rhs) {
+  return lhs.a == rhs.a && lhs.b == rhs.b;
+}
+
+void legacy_serialize(const message& msg, serializer& sink) {
+  std::string tname = msg.empty() ? "@<>" : msg.tuple_type_names();
+  auto uti = uniform_type_info::from(tname);
+  sink.begin_object(uti);
+  for (size_t i = 0; i < msg.size(); ++i) {
+    uniform_type_info::from(msg.uniform_name_at(i))->serialize(msg.at(i),
+                                                               &sink);
+  }
+  sink.end_object();
+}
+
+message legacy_deserialize(deserializer& source) {
+  auto uti = source.begin_object();
+  auto uval = uti->create();
+  uti->deserialize(uval->val, &source);
+  source.end_object();
+  return *reinterpret_cast<message*>(uval->val);
+}
+
+void compact_serialize(const message& msg, serializer& sink) {
+  msg.serialize(sink);
+}
+
+message compact_deserialize(deserializer& source) {
+  message result;
+  result.deserialize(source);
+  return result;
+}
+
+template <class Serialize, class Deserialize>
+void run(const char* name, const message& msg, size_t n, Serialize ser,
+         Deserialize deser) {
+  buffer buf;
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < n; ++i) {
+    buf.clear();
+    binary_serializer bs{std::back_inserter(buf)};
+    ser(msg, bs);
+  }
+  auto t1 = clock_type::now();
+  for (size_t i = 0; i < n; ++i) {
+    binary_deserializer bd{buf.data(), buf.size()};
+    auto res = deser(bd);
+    static_cast<void>(res);
+  }
+  auto t2 = clock_type::now();
+  binary_deserializer bd{buf.data(), buf.size()};
+  if (deser(bd) != msg) {
+    cout << name << ": deserialized message differs from original" << endl;
+  }
+  auto ns = [n](clock_type::duration d) {
+    auto x = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    return static_cast<double>(x) / n;
+  };
+  cout << name << ": " << buf.size() << " bytes, serialize "
+       << ns(t1 - t0) << " ns/msg, deserialize " << ns(t2 - t1) << " ns/msg"
+       << endl;
+}
+
+void usage() {
+  cout << "usage: message_serialization [iterations]" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  size_t iterations = 1000000;
+  if (argc > 2) {
+    usage();
+    return 1;
+  }
+  if (argc > 1) {
+    iterations = std::stoul(argv[1]);
+  }
+  announce<foo>("foo", &foo::a, &foo::b);
+  std::vector<std::pair<std::string, message>> msgs{
+    {"(atom, i32)         ", make_message(get_atom::value, 42)},
+    {"(atom, str, i32)    ", make_message(get_atom::value,
+                                          std::string{"hello"}, 42)},
+    {"(atom, foo)         ", make_message(get_atom::value, foo{1, 2})}
+  };
+  for (auto& x : msgs) {
+    cout << x.first << endl;
+    run("  legacy ", x.second, iterations, legacy_serialize,
+        legacy_deserialize);
+    run("  compact", x.second, iterations, compact_serialize,
+        compact_deserialize);
+  }
+  shutdown();
+}
@@ -70,7 +70,7 @@ public:
   /// Returns the logical actor address.
   actor_addr address() const;
 
-  /// Detaches the first attached object that matches `what`.
+  /// Detaches all attached objects that match `what`.
   size_t detach(const attachable::token& what);
 
   /// Links this actor to `whom`.
@@ -140,6 +140,8 @@ protected:
   /// Creates a proxy instance for a proxy running on `nid`.
   abstract_actor(actor_id aid, node_id nid);
 
+  ~abstract_actor();
+
   /// Called by the runtime system to perform cleanup actions for this actor.
   /// Subtypes should always call this member function when overriding it.
   virtual void cleanup(uint32_t reason);
@@ -261,15 +263,11 @@ protected:
 
   bool remove_backlink_impl(const actor_addr& other);
 
-  inline void attach_impl(attachable_ptr& ptr) {
-    ptr->next.swap(attachables_head_);
-    attachables_head_.swap(ptr);
-  }
+  void attach_impl(attachable_ptr& ptr);
 
-  static size_t detach_impl(const attachable::token& what,
-                            attachable_ptr& ptr,
-                            bool stop_on_first_hit = false,
-                            bool dry_run = false);
+  size_t detach_impl(const attachable::token& what,
+                     bool stop_on_first_hit = false,
+                     bool dry_run = false);
 
   // cannot be changed after construction
   const actor_id id_;
@@ -284,9 +282,13 @@ protected:
   // only used in blocking and thread-mapped actors
   mutable std::condition_variable cv_;
 
-  // attached functors that are executed on cleanup (monitors, links, etc)
+  // attached functors that are executed on cleanup (functors, etc.)
   attachable_ptr attachables_head_;
 
+  // monitors and links, hashed by observer (allocated on first use)
+  struct observer_index;
+  std::unique_ptr<observer_index> observers_;
+
   // identifies the execution unit this actor is currently executed by
   execution_unit* host_;
 
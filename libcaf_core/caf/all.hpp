@@ -33,6 +33,7 @@
 #include "caf/extend.hpp"
 #include "caf/channel.hpp"
 #include "caf/message.hpp"
+#include "caf/metrics.hpp"
 #include "caf/node_id.hpp"
 #include "caf/announce.hpp"
 #include "caf/anything.hpp"
@@ -76,6 +77,7 @@
 #include "caf/message_builder.hpp"
 #include "caf/message_handler.hpp"
 #include "caf/response_handle.hpp"
+#include "caf/overflow_policy.hpp"
 #include "caf/system_messages.hpp"
 #include "caf/abstract_channel.hpp"
 #include "caf/may_have_timeout.hpp"
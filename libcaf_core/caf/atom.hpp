@@ -138,6 +138,9 @@ using spawn_atom = atom_constant<atom("SPAWN")>;
 /// Atom to signalize an actor to migrate its state to another actor.
 using migrate_atom = atom_constant<atom("MIGRATE")>;
 
+/// Atom to signalize backpressure from an actor with a full mailbox.
+using overflow_atom = atom_constant<atom("OVERFLOW")>;
+
 } // namespace caf
 
 namespace std {
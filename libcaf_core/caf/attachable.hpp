@@ -79,6 +79,10 @@ public:
   /// Returns `true` if `what` selects this instance, otherwise `false`.
   virtual bool matches(const token& what);
 
+  /// Returns the type ID number of the tokens selecting this instance,
+  /// i.e., one of the constants defined in `token`.
+  virtual size_t subtype() const;
+
   /// Returns `true` if `what` selects this instance, otherwise `false`.
   template <class T>
   bool matches(const T& what) {
@@ -57,6 +57,8 @@ public:
 
   const uniform_type_info* begin_object() override;
   void end_object() override;
+  void begin_message(std::vector<const uniform_type_info*>& types) override;
+  void end_message() override;
   size_t begin_sequence() override;
   void end_sequence() override;
   void read_value(primitive_variant& storage) override;
@@ -51,6 +51,13 @@ public:
 
   void end_object() override;
 
+  /// Writes the number of elements followed by the type of each element.
+  /// Builtin types are identified by their type number, announced types
+  /// by their type ID.
+  void begin_message(const message& msg) override;
+
+  void end_message() override;
+
   void begin_sequence(size_t list_size) override;
 
   void end_sequence() override;
@@ -50,6 +50,7 @@
 // - CAF_DEPRECATED to annotate deprecated functions
 // - CAF_PUSH_WARNINGS/CAF_POP_WARNINGS to surround "noisy" header includes
 // - CAF_ANNOTATE_FALLTHROUGH to suppress warnings in switch/case statements
+// - CAF_PREFETCH to hint that memory at a given address is read soon
 // - CAF_COMPILER_VERSION to retrieve the compiler version in CAF_VERSION format
 // - One of the following:
 //   + CAF_CLANG
@@ -103,6 +104,7 @@
 #  define CAF_POP_WARNINGS                                                     \
     _Pragma("clang diagnostic pop")
 #  define CAF_ANNOTATE_FALLTHROUGH [[clang::fallthrough]]
+#  define CAF_PREFETCH(addr) __builtin_prefetch(addr)
 #  define CAF_COMPILER_VERSION                                                 \
     (__clang_major__ * 10000 + __clang_minor__ * 100 + __clang_patchlevel__)
 #elif defined(__GNUC__)
@@ -118,6 +120,7 @@
 #  define CAF_POP_WARNINGS                                                     \
     _Pragma("GCC diagnostic pop")
 #  define CAF_ANNOTATE_FALLTHROUGH static_cast<void>(0)
+#  define CAF_PREFETCH(addr) __builtin_prefetch(addr)
 #  define CAF_COMPILER_VERSION                                                 \
      (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
 #elif defined(_MSC_VER)
@@ -127,6 +130,7 @@
 #  define CAF_PUSH_NON_VIRTUAL_DTOR_WARNING
 #  define CAF_POP_WARNINGS
 #  define CAF_ANNOTATE_FALLTHROUGH static_cast<void>(0)
+#  define CAF_PREFETCH(addr) static_cast<void>(addr)
 #  define CAF_COMPILER_VERSION _MSC_FULL_VER
 #  pragma warning( disable : 4624 )
 #  pragma warning( disable : 4800 )
@@ -137,6 +141,7 @@
 #  define CAF_PUSH_WARNINGS
 #  define CAF_POP_WARNINGS
 #  define CAF_ANNOTATE_FALLTHROUGH static_cast<void>(0)
+#  define CAF_PREFETCH(addr) static_cast<void>(addr)
 #endif
 
 // This OS-specific block defines one of the following:
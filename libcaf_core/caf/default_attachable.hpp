@@ -42,6 +42,16 @@ public:
 
   bool matches(const token& what) override;
 
+  size_t subtype() const override;
+
+  inline const actor_addr& observer() const {
+    return observer_;
+  }
+
+  inline observe_type type() const {
+    return type_;
+  }
+
   inline static attachable_ptr make_monitor(actor_addr observer) {
     return attachable_ptr{new default_attachable(std::move(observer), monitor)};
   }
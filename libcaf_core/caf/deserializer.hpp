@@ -21,6 +21,7 @@
 #define CAF_DESERIALIZER_HPP
 
 #include <string>
+#include <vector>
 #include <cstddef>
 
 #include "caf/primitive_variant.hpp"
@@ -48,6 +49,14 @@ public:
   /// Ends deserialization of an object.
   virtual void end_object() = 0;
 
+  /// Begins deserialization of a message and stores the types of its
+  /// elements in `types`. The default implementation reads an object
+  /// named after the element types, e.g., `@<>+@i32+@str`.
+  virtual void begin_message(std::vector<const uniform_type_info*>& types);
+
+  /// Ends deserialization of a message.
+  virtual void end_message();
+
   /// Begins deserialization of a sequence.
   /// @returns The size of the sequence.
   virtual size_t begin_sequence() = 0;
@@ -33,6 +33,7 @@
 
 #include "caf/detail/shared_spinlock.hpp"
 #include "caf/detail/singleton_mixin.hpp"
+#include "caf/detail/double_ended_queue.hpp"
 
 namespace caf {
 namespace detail {
@@ -98,17 +99,42 @@ public:
   void initialize();
 
 private:
-  using entries = std::unordered_map<actor_id, value_type>;
+  // actors are spread across shards by their ID, each shard having its
+  // own lock, to keep concurrent lookups and updates from contending
+  static constexpr size_t num_shards = 64;
+
+  // maps consecutive IDs of a shard to neighboring buckets
+  struct shard_hash {
+    inline size_t operator()(actor_id key) const {
+      return static_cast<size_t>(key / num_shards);
+    }
+  };
+
+  using entries = std::unordered_map<actor_id, value_type, shard_hash>;
+
+  struct shard {
+    mutable detail::shared_spinlock mtx;
+    entries data;
+    // keeps the locks of neighboring shards on different cache lines
+    char pad[CAF_CACHE_LINE_SIZE];
+  };
 
   actor_registry();
 
+  inline shard& shard_for(actor_id key) {
+    return shards_[key % num_shards];
+  }
+
+  inline const shard& shard_for(actor_id key) const {
+    return shards_[key % num_shards];
+  }
+
   std::atomic<size_t> running_;
 
   std::mutex running_mtx_;
   std::condition_variable running_cv_;
 
-  mutable detail::shared_spinlock instances_mtx_;
-  entries entries_;
+  shard shards_[num_shards];
 
   named_entries named_entries_;
   mutable detail::shared_spinlock named_entries_mtx_;
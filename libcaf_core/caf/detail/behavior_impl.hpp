@@ -21,6 +21,7 @@
 #define CAF_DETAIL_BEHAVIOR_IMPL_HPP
 
 #include <tuple>
+#include <memory>
 #include <iterator>
 #include <type_traits>
 
@@ -67,6 +68,10 @@ class behavior_impl : public ref_counted {
 public:
   using pointer = intrusive_ptr<behavior_impl>;
 
+  /// Behaviors with at least this many match cases dispatch messages
+  /// via an index instead of testing each case in turn.
+  static constexpr size_t index_threshold = 8;
+
   ~behavior_impl();
 
   behavior_impl(duration tout = duration{});
@@ -102,10 +107,23 @@ public:
     return std::distance(begin_, end_);
   }
 
+  /// Returns whether any match case accepts messages with type token `token`,
+  /// i.e., whether `invoke` can possibly succeed for such messages.
+  bool may_match(uint32_t token) const;
+
 protected:
+  /// Builds the dispatch index for behaviors with at least `index_threshold`
+  /// match cases. Subclasses call this after initializing `begin_` and `end_`.
+  void init_index();
+
   iterator begin_;
   iterator end_;
   duration timeout_;
+
+private:
+  struct dispatch_index;
+
+  std::unique_ptr<dispatch_index> index_;
 };
 
 template <size_t Pos, size_t Size>
@@ -161,6 +179,7 @@ private:
     defaut_bhvr_impl_init<0, num_cases>::init(arr_, cases_);
     begin_ = arr_.data();
     end_ = begin_ + arr_.size();
+    init_index();
   }
 
   Tuple cases_;
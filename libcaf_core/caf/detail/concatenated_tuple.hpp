@@ -55,6 +55,8 @@ public:
 
   uint16_t type_nr_at(size_t pos) const override;
 
+  const uniform_type_info* type_at(size_t pos) const override;
+
   concatenated_tuple(std::initializer_list<cow_ptr> xs);
 
   concatenated_tuple(const concatenated_tuple&) = default;
@@ -0,0 +1,80 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_CPU_TOPOLOGY_HPP
+#define CAF_DETAIL_CPU_TOPOLOGY_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace caf {
+namespace detail {
+
+/// Describes a logical CPU and its position in the memory hierarchy.
+struct cpu_info {
+  /// Logical CPU ID as used by the operating system.
+  int id;
+  /// Physical package (socket) of the CPU.
+  int package;
+  /// NUMA node of the CPU.
+  int node;
+  /// Physical core within the package, shared by SMT siblings.
+  int core;
+  /// Lowest ID of all CPUs sharing the L2 cache with this CPU.
+  int l2;
+  /// Lowest ID of all CPUs sharing the L3 cache with this CPU.
+  int l3;
+};
+
+/// Classifies the distance between two CPUs from the perspective
+/// of a worker that steals jobs from another worker.
+enum class cpu_distance : size_t {
+  /// CPUs share an L2 or L3 cache.
+  shared_cache,
+  /// CPUs are on the same NUMA node but do not share a cache.
+  same_node,
+  /// CPUs are on different NUMA nodes.
+  remote
+};
+
+/// Number of distinct values in `cpu_distance`.
+constexpr size_t num_cpu_distances = 3;
+
+/// Returns the distance between `x` and `y`.
+cpu_distance distance(const cpu_info& x, const cpu_info& y);
+
+/// Reads the CPU topology of all online CPUs from the operating system.
+/// Returns an empty vector if the topology is not available, e.g.,
+/// on platforms other than Linux.
+std::vector<cpu_info> get_cpu_topology();
+
+/// Selects CPUs for `num_workers` workers, preferring physical cores over
+/// SMT siblings and keeping workers with adjacent IDs close to each other.
+/// Assigns CPUs round-robin if there are more workers than CPUs.
+std::vector<cpu_info> select_worker_cpus(std::vector<cpu_info> topology,
+                                         size_t num_workers);
+
+/// Pins the calling thread to the logical CPU `id`.
+/// @returns `true` on success, `false` otherwise.
+bool pin_this_thread(int id);
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_CPU_TOPOLOGY_HPP
@@ -65,6 +65,8 @@ public:
 
   uint16_t type_nr_at(size_t pos) const override;
 
+  const uniform_type_info* type_at(size_t pos) const override;
+
   inline const cow_ptr& decorated() const {
     return decorated_;
   }
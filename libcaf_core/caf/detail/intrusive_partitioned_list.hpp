@@ -88,7 +88,7 @@ public:
     }
   };
 
-  intrusive_partitioned_list() {
+  intrusive_partitioned_list() : size_(0) {
     head_.next = &separator_;
     separator_.prev = &head_;
     separator_.next = &tail_;
@@ -142,6 +142,7 @@ public:
     val->next = next.ptr;
     prev->next = val;
     next->prev = val;
+    ++size_;
     return val;
   }
 
@@ -163,6 +164,7 @@ public:
     auto prev = res->prev;
     prev->next = next;
     next->prev = prev;
+    --size_;
     return res;
   }
 
@@ -224,6 +226,7 @@ public:
       // it's safe, i.e., if invoke_message returned im_skipped
       prev->next = next;
       next->prev = prev;
+      --size_;
       switch (self->invoke_message(tmp, bhvr, mid)) {
         case im_dropped:
           move_on(false);
@@ -235,6 +238,7 @@ public:
             // re-integrate tmp and move on
             prev->next = tmp.get();
             next->prev = tmp.release();
+            ++size_;
             move_on(true);
           }
           else {
@@ -258,11 +262,11 @@ public:
   }
 
   size_t count(size_t max_count = std::numeric_limits<size_t>::max()) {
-    auto r1 = count(first_begin(), first_end(), max_count);
-    return r1 + count(second_begin(), second_end(), max_count - r1);
+    return std::min(size_, max_count);
   }
 
 private:
+  size_t size_;
   value_type head_;
   value_type separator_;
   value_type tail_;
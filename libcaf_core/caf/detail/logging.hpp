@@ -20,6 +20,7 @@
 #ifndef CAF_DETAIL_LOGGING_HPP
 #define CAF_DETAIL_LOGGING_HPP
 
+#include <atomic>
 #include <thread>
 #include <cstring>
 #include <sstream>
@@ -53,6 +54,25 @@ namespace detail {
 
 class singletons;
 
+/// Static information about a single logging statement. Each statement
+/// creates one instance with static storage duration, i.e., log records
+/// only carry a pointer to it and the writer thread formats them.
+struct log_call_site {
+  int level;
+  const char* function_name;
+  const char* file_name;
+  int line_num;
+};
+
+/// Returns the log level for one of the names in `CAF_LVL_NAME`.
+constexpr int log_level_of(const char* level_name) {
+  return level_name[0] == 'E' ? 0
+         : level_name[0] == 'W' ? 1
+         : level_name[0] == 'I' ? 2
+         : level_name[0] == 'D' ? 3
+         : 4;
+}
+
 class logging {
 public:
   friend class detail::singletons;
@@ -64,22 +84,34 @@ public:
   // returns the previously set actor id
   actor_id set_aid(actor_id aid);
 
-  virtual void log(const char* level, const char* class_name,
-                   const char* function_name, const char* file_name,
-                   int line_num, const std::string& msg) = 0;
+  /// Returns whether statements of given level currently produce output.
+  static inline bool accepts(int lvl) {
+    return lvl <= level_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the current log level.
+  static int level();
+
+  /// Sets the log level at runtime. Statements above `CAF_LOG_LEVEL`
+  /// remain disabled, since the compiler removes them.
+  static void set_level(int lvl);
+
+  /// Enqueues a log record for the writer thread, which formats it and
+  /// demangles `class_name` lazily. Both `site` and `class_name` must
+  /// have static storage duration.
+  virtual void log(const log_call_site& site, const char* class_name,
+                   std::string msg) = 0;
 
   class trace_helper {
   public:
-    trace_helper(std::string class_name, const char* fun_name,
-                 const char* file_name, int line_num, const std::string& msg);
+    trace_helper(const log_call_site& site, const char* class_name,
+                 std::string msg);
 
     ~trace_helper();
 
   private:
-    std::string class_;
-    const char* fun_name_;
-    const char* file_name_;
-    int line_num_;
+    const log_call_site* site_;
+    const char* class_;
   };
 
 protected:
@@ -96,8 +128,7 @@ protected:
   }
 
 private:
-  detail::shared_spinlock aids_lock_;
-  std::unordered_map<std::thread::id, actor_id> aids_;
+  static std::atomic<int> level_;
 };
 
 struct oss_wr {
@@ -173,14 +204,20 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
 #define CAF_SET_AID(unused) caf_set_aid_dummy()
 #else
 #define CAF_LOG_IMPL(lvlname, classname, funname, message)                     \
-  if (strcmp(lvlname, "ERROR") == 0) {                                         \
-    CAF_PRINT_ERROR_IMPL(lvlname, classname, funname, message);                \
-  }                                                                            \
-  caf::detail::singletons::get_logger()->log(lvlname, classname, funname,      \
-                                             __FILE__, __LINE__,               \
-                                             (caf::detail::oss_wr{}            \
-                                              << std::boolalpha                \
-                                              << message).str())
+  do {                                                                         \
+    static const caf::detail::log_call_site caf_log_site{                      \
+      caf::detail::log_level_of(lvlname), funname, __FILE__, __LINE__          \
+    };                                                                         \
+    if (caf_log_site.level == CAF_ERROR) {                                     \
+      CAF_PRINT_ERROR_IMPL(lvlname, classname, funname, message);              \
+    }                                                                          \
+    if (caf::detail::logging::accepts(caf_log_site.level)) {                   \
+      caf::detail::singletons::get_logger()->log(caf_log_site, classname,      \
+                                                 (caf::detail::oss_wr{}        \
+                                                  << std::boolalpha            \
+                                                  << message).str());          \
+    }                                                                          \
+  } while (false)
 #define CAF_PUSH_AID(aid_arg)                                                  \
   auto CAF_UNIFYN(caf_aid_tmp)                                                 \
     = caf::detail::singletons::get_logger()->set_aid(aid_arg);                 \
@@ -213,9 +250,14 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
 #define CAF_PRINT4(arg0, arg1, arg2, arg3)
 #else
 #define CAF_PRINT4(lvlname, classname, funname, msg)                           \
-  caf::detail::logging::trace_helper CAF_UNIFYN(caf_log_trace_)  {             \
-    classname, funname, __FILE__, __LINE__,                                    \
-      (caf::detail::oss_wr{} << msg).str()                                     \
+  static const caf::detail::log_call_site CAF_UNIFYN(caf_trace_site_) {        \
+    CAF_TRACE, funname, __FILE__, __LINE__                                     \
+  };                                                                           \
+  caf::detail::logging::trace_helper CAF_UNIFYN(caf_log_trace_) {              \
+    CAF_UNIFYN(caf_trace_site_), classname,                                    \
+    caf::detail::logging::accepts(CAF_TRACE)                                   \
+      ? (caf::detail::oss_wr{} << msg).str()                                   \
+      : std::string{}                                                          \
   }
 #endif
 
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_MAILBOX_CACHE_INDEX_HPP
+#define CAF_DETAIL_MAILBOX_CACHE_INDEX_HPP
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "caf/fwd.hpp"
+#include "caf/message_id.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Indexes the skipped messages in the cache of an actor. Ordinary messages
+/// are grouped by their type token, while responses are indexed by their
+/// message ID, since only the awaited response can match. This allows an
+/// actor to re-try only messages a behavior can possibly match after
+/// changing its state instead of re-scanning its whole cache.
+///
+/// Each element has a key denoting its position in the cache. Keys of high
+/// priority elements are smaller than the keys of all normal elements if
+/// the actor is priority aware. Otherwise, keys follow insertion order.
+/// The index never owns its elements.
+/// @note This class is not thread-safe.
+class mailbox_cache_index {
+public:
+  struct entry {
+    uint64_t key;
+    mailbox_element* ptr;
+  };
+
+  using bucket = std::deque<entry>;
+
+  mailbox_cache_index();
+
+  mailbox_cache_index(const mailbox_cache_index&) = delete;
+  mailbox_cache_index& operator=(const mailbox_cache_index&) = delete;
+
+  /// Adds `ptr` as most recent element of its priority class.
+  void push(mailbox_element* ptr, bool high_priority);
+
+  /// Re-inserts `x` at its previous position after removing it via
+  /// `take_response` or `take_next`.
+  void restore(const entry& x);
+
+  /// Removes the oldest response with ID `mid` and stores it in `x`.
+  bool take_response(message_id mid, entry& x);
+
+  /// Stores pointers to all buckets with elements `bhvr` may match in `xs`.
+  /// Pointers to buckets remain valid until `clear` is called.
+  void candidates(const behavior& bhvr, std::vector<bucket*>& xs);
+
+  /// Removes the element with the smallest key greater than `min_key`
+  /// from the buckets in `xs` and stores it in `x`.
+  bool take_next(const std::vector<bucket*>& xs, uint64_t min_key, entry& x);
+
+  /// Removes all elements.
+  void clear();
+
+private:
+  uint64_t next_high_key_;
+  uint64_t next_key_;
+  std::unordered_map<uint32_t, bucket> buckets_;
+  std::unordered_multimap<uint64_t, entry> responses_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_MAILBOX_CACHE_INDEX_HPP
@@ -21,6 +21,8 @@
 #define CAF_DETAIL_MEMORY_HPP
 
 #include <new>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -50,10 +52,22 @@ constexpr size_t s_max_elements = 20;       // don't create > 20 elements
 
 using embedded_storage = std::pair<intrusive_ptr<ref_counted>, void*>;
 
+/// Usage statistics of a memory cache.
+struct memory_cache_stats {
+  /// Number of objects currently in use.
+  size_t live;
+  /// Number of free slots the owning thread can reuse without draining
+  /// its remote-free queue or allocating a new slab.
+  size_t cached;
+  /// Number of objects released by a thread other than the owner so far.
+  size_t remote_freed;
+};
+
 class memory_cache {
 public:
   virtual ~memory_cache();
   virtual embedded_storage new_embedded_storage() = 0;
+  virtual memory_cache_stats stats() const = 0;
 };
 
 template <class T>
@@ -98,13 +112,34 @@ public:
     return unbox_rc_storage(new embedded_t(std::forward<Ts>(xs)...));
   }
 
+  // Creates `n` objects from copies of `xs` and calls `f` for each.
+  template <class T, class F, class... Ts>
+  static void create_n(size_t n, F f, const Ts&... xs) {
+    for (size_t i = 0; i < n; ++i)
+      f(create<T>(xs...));
+  }
+
   static inline memory_cache* get_cache_map_entry(const std::type_info*) {
     return nullptr;
   }
+
+  static inline memory_cache_stats thread_stats() {
+    return {0, 0, 0};
+  }
+
+  template <class T>
+  static memory_cache_stats stats_for() {
+    return {0, 0, 0};
+  }
 };
 
 #else // CAF_NO_MEM_MANAGEMENT
 
+// Caches objects of type `T` in slabs owned by a single thread. Objects
+// released by the owning thread go straight back to its free list, all
+// other threads push released objects to a lock-free stack that the owner
+// drains once its free list runs empty. Slabs are never returned to the
+// system before the owning thread terminates and all objects are released.
 template <class T>
 class basic_memory_cache : public memory_cache {
 public:
@@ -135,49 +170,194 @@ public:
     }
   };
 
-  class storage : public ref_counted {
+  class slab;
+
+  // Storage for a single instance, the embedded object keeps a reference
+  // to its slot and the slot goes back to its slab once released.
+  class slot : public ref_counted {
   public:
-    storage() : pos_(0) {
+    slot() : parent(nullptr), next(nullptr) {
       // nop
     }
 
-    ~storage() {
+    ~slot() {
       // nop
     }
 
-    bool has_next() {
-      return pos_ < dsize;
+    void request_deletion(bool) noexcept override {
+      parent->release(this);
     }
 
-    embedded_t* next() {
-      return &(data_[pos_++].instance);
+    void reset() {
+      rc_.store(1, std::memory_order_relaxed);
     }
 
-  private:
-    size_t pos_;
-    wrapper data_[dsize];
+    slab* parent;
+    slot* next;
+    wrapper data;
   };
 
-  embedded_storage new_embedded_storage() override {
-    // allocate cache on-the-fly
-    if (! cache_) {
-      cache_.reset(new storage, false); // starts with ref count of 1
-      CAF_ASSERT(cache_->unique());
+  class slab : public ref_counted {
+  public:
+    slab()
+        : owner_(std::this_thread::get_id()),
+          orphaned_(false),
+          free_(nullptr),
+          cached_(0),
+          live_(0),
+          remote_(nullptr),
+          remote_freed_(0) {
+      // nop
+    }
+
+    ~slab() {
+      for (auto chunk : chunks_)
+        delete[] chunk;
+    }
+
+    // Returns a free slot with a reference count of 1. Called only
+    // by the owning thread.
+    slot* acquire() {
+      if (! free_)
+        drain();
+      if (! free_)
+        grow();
+      auto res = free_;
+      free_ = res->next;
+      --cached_;
+      live_.fetch_add(1, std::memory_order_relaxed);
+      // each live slot keeps its slab alive
+      ref();
+      res->reset();
+      return res;
+    }
+
+    // Returns `n` free slots with a reference count of 1 each, linked via
+    // their `next` pointer. Updates the counters of this slab only once.
+    // Called only by the owning thread.
+    slot* acquire_n(size_t n) {
+      slot* res = nullptr;
+      for (size_t i = 0; i < n; ++i) {
+        if (! free_)
+          drain();
+        if (! free_)
+          grow();
+        auto x = free_;
+        free_ = x->next;
+        x->reset();
+        x->next = res;
+        res = x;
+      }
+      cached_ -= n;
+      live_.fetch_add(n, std::memory_order_relaxed);
+      ref(n);
+      return res;
+    }
+
+    void release(slot* x) noexcept {
+      live_.fetch_sub(1, std::memory_order_relaxed);
+      if (std::this_thread::get_id() == owner_
+          && ! orphaned_.load(std::memory_order_acquire)) {
+        x->next = free_;
+        free_ = x;
+        ++cached_;
+      } else {
+        auto head = remote_.load(std::memory_order_relaxed);
+        do {
+          x->next = head;
+        } while (! remote_.compare_exchange_weak(head, x,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+        remote_freed_.fetch_add(1, std::memory_order_relaxed);
+      }
+      // may destroy this slab (including `x`) if the owner is gone
+      deref();
+    }
+
+    // Marks this slab as abandoned by its owner, i.e., all
+    // subsequently released slots go to the remote-free stack.
+    void orphan() {
+      orphaned_.store(true, std::memory_order_release);
+    }
+
+    memory_cache_stats stats() const {
+      return {live_.load(std::memory_order_relaxed), cached_,
+              remote_freed_.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    // moves all slots from the remote-free stack to the local free list
+    void drain() {
+      auto x = remote_.exchange(nullptr, std::memory_order_acquire);
+      while (x) {
+        auto next = x->next;
+        x->next = free_;
+        free_ = x;
+        ++cached_;
+        x = next;
+      }
     }
-    auto res = cache_->next();
-    if (cache_->has_next()) {
-      return {cache_, res};
+
+    void grow() {
+      auto chunk = new slot[dsize];
+      chunks_.push_back(chunk);
+      for (size_t i = 0; i < dsize; ++i) {
+        chunk[i].parent = this;
+        chunk[i].next = free_;
+        free_ = &chunk[i];
+      }
+      cached_ += dsize;
     }
-    // we got the last element out of the cache; pass the reference to the
-    // client to avoid pointless increase/decrease ops on the reference count
+
+    std::thread::id owner_;
+    std::atomic<bool> orphaned_;
+    // accessed only by the owning thread
+    slot* free_;
+    size_t cached_;
+    std::vector<slot*> chunks_;
+    // accessed by all threads
+    std::atomic<size_t> live_;
+    std::atomic<slot*> remote_;
+    std::atomic<size_t> remote_freed_;
+  };
+
+  basic_memory_cache() : slab_(new slab, false) {
+    // nop
+  }
+
+  ~basic_memory_cache() {
+    slab_->orphan();
+  }
+
+  embedded_storage new_embedded_storage() override {
+    // pass the initial reference of the slot to the client
+    auto x = slab_->acquire();
     embedded_storage result;
-    result.first.reset(cache_.detach(), false);
-    result.second = res;
+    result.first.reset(x, false);
+    result.second = &(x->data.instance);
     return result;
   }
 
+  // calls `f` with a new embedded storage for `n` objects
+  template <class F>
+  void new_embedded_storage_n(size_t n, F f) {
+    auto x = slab_->acquire_n(n);
+    while (x) {
+      auto next = x->next;
+      embedded_storage es;
+      es.first.reset(x, false);
+      es.second = &(x->data.instance);
+      f(std::move(es));
+      x = next;
+    }
+  }
+
+  memory_cache_stats stats() const override {
+    return slab_->stats();
+  }
+
 private:
-  intrusive_ptr<storage> cache_;
+  intrusive_ptr<slab> slab_;
 };
 
 class memory {
@@ -205,8 +385,42 @@ public:
     return ptr;
   }
 
+  // Creates `n` objects from copies of `xs` and calls `f` for each. Takes
+  // all slots from the cache in a single batch, i.e., looks up the cache
+  // and updates its counters only once.
+  template <class T, class F, class... Ts>
+  static void create_n(size_t n, F f, const Ts&... xs) {
+    using embedded_t =
+      typename std::conditional<
+        T::memory_cache_flag == needs_embedding,
+        embedded<T>,
+        T
+       >::type;
+    if (n == 0)
+      return;
+    auto mc = static_cast<basic_memory_cache<T>*>(
+      get_or_set_cache_map_entry<T>());
+    mc->new_embedded_storage_n(n, [&](embedded_storage es) {
+      auto ptr = reinterpret_cast<embedded_t*>(es.second);
+      new (ptr) embedded_t(std::move(es.first), xs...);
+      f(static_cast<T*>(ptr));
+    });
+  }
+
   static memory_cache* get_cache_map_entry(const std::type_info* tinf);
 
+  /// Returns the accumulated statistics of all caches of this thread.
+  static memory_cache_stats thread_stats();
+
+  /// Returns the statistics of the cache for `T` of this thread.
+  template <class T>
+  static memory_cache_stats stats_for() {
+    auto mc = get_cache_map_entry(&typeid(T));
+    if (! mc)
+      return {0, 0, 0};
+    return mc->stats();
+  }
+
 private:
 
   static void add_cache_map_entry(const std::type_info* tinf,
@@ -71,6 +71,10 @@ public:
 
   virtual uint16_t type_nr_at(size_t pos) const = 0;
 
+  // returns the type of the element at position `pos` or `nullptr`
+  // if the type has not been announced
+  virtual const uniform_type_info* type_at(size_t pos) const = 0;
+
   /****************************************************************************
    *                               nested types                               *
    ****************************************************************************/
@@ -0,0 +1,111 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
+#define CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+#include "caf/behavior.hpp"
+#include "caf/message_id.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Maps the response IDs of outstanding requests to their response
+/// handlers. Lookups use an open-addressing hash table with linear probing,
+/// i.e., they run in O(1) regardless of the number of outstanding requests.
+/// Entries additionally form a list ordered by insertion, whereas `front`
+/// always returns the most recent request that is still pending. Entries
+/// are stored in separate nodes, i.e., references to an entry remain valid
+/// until it gets erased, even if the table grows in the meantime.
+/// @note This class is not thread-safe.
+class pending_response_table {
+public:
+  using value_type = std::pair<message_id, behavior>;
+
+  pending_response_table();
+
+  ~pending_response_table();
+
+  pending_response_table(const pending_response_table&) = delete;
+  pending_response_table& operator=(const pending_response_table&) = delete;
+
+  /// Adds `mid` as most recent request.
+  /// @pre `find(mid) == nullptr`
+  value_type& emplace(message_id mid, behavior bhvr);
+
+  /// Returns the entry for `mid` or `nullptr` if no such entry exists.
+  value_type* find(message_id mid) const;
+
+  /// Removes the entry for `mid` and returns whether such an entry existed.
+  bool erase(message_id mid);
+
+  /// Removes all entries.
+  void clear();
+
+  /// Returns the most recent pending request.
+  /// @pre `! empty()`
+  inline value_type& front() {
+    return head_->value;
+  }
+
+  /// Returns the most recent pending request.
+  /// @pre `! empty()`
+  inline const value_type& front() const {
+    return head_->value;
+  }
+
+  inline bool empty() const {
+    return size_ == 0;
+  }
+
+  inline size_t size() const {
+    return size_;
+  }
+
+private:
+  struct node {
+    value_type value;
+    node* prev;
+    node* next;
+  };
+
+  size_t slot_of(message_id mid) const;
+
+  size_t find_slot(message_id mid) const;
+
+  void insert_slot(node* ptr);
+
+  void grow();
+
+  // open-addressing hash table with a load factor of at most 50%
+  std::vector<node*> slots_;
+  size_t shift_;
+  size_t size_;
+  // most recent entry, nodes are linked in descending insertion order
+  node* head_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
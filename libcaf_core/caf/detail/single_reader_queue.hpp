@@ -28,6 +28,7 @@
 #include <atomic>
 #include <memory>
 #include <limits>
+#include <algorithm>
 #include <condition_variable> // std::cv_status
 
 #include "caf/detail/intrusive_partitioned_list.hpp"
@@ -66,6 +67,34 @@ public:
     return take_head();
   }
 
+  /// Dequeues up to `max_count` elements in FIFO order and passes each of
+  /// them to `f`, stopping early if `f` returns `false`. Fetches new data at
+  /// most once, i.e., `f` sees a single pre-reversed chunk of elements.
+  /// Calls `prefetch` with the next element in line (if any) before passing
+  /// the current element to `f`, allowing the caller to overlap memory
+  /// accesses for the next element with processing the current one.
+  /// @returns The number of elements passed to `f`.
+  /// @warning Call only from the reader (owner).
+  template <class F, class Prefetch>
+  size_t consume(size_t max_count, F f, Prefetch prefetch) {
+    if (head_ == nullptr && ! fetch_new_data())
+      return 0;
+    size_t consumed = 0;
+    // `f` may close the queue, hence we re-read `head_` in each iteration
+    while (head_ != nullptr && consumed < max_count) {
+      auto x = head_;
+      head_ = x->next;
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      ++dequeued_;
+      if (head_ != nullptr)
+        prefetch(*head_);
+      ++consumed;
+      if (! f(x))
+        break;
+    }
+    return consumed;
+  }
+
   /// Tries to enqueue a new element to the mailbox.
   /// @warning Call only from the reader (owner).
   enqueue_result enqueue(pointer new_element) {
@@ -79,10 +108,14 @@ public:
       }
       // a dummy is never part of a non-empty list
       new_element->next = is_dummy(e) ? nullptr : e;
+      // count optimistically, since `new_element` belongs to the reader
+      // as soon as the CAS succeeds
+      size_.fetch_add(1, std::memory_order_relaxed);
       if (stack_.compare_exchange_strong(e, new_element)) {
         return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
                                               : enqueue_result::success;
       }
+      size_.fetch_sub(1, std::memory_order_relaxed);
       // continue with new value of e
     }
   }
@@ -99,6 +132,46 @@ public:
     return ! is_dummy(ptr);
   }
 
+  /// Returns the approximate number of elements that were enqueued but not
+  /// yet dequeued by the reader, not counting the cache. The result can be
+  /// off by the number of concurrent writers, but is safe to call from any
+  /// thread at the cost of a single relaxed load.
+  size_t size() const {
+    return size_.load(std::memory_order_relaxed);
+  }
+
+  /// Drops the oldest elements until at most `max_size` elements wait for
+  /// the reader, calling `f` on each dropped element before deleting it.
+  /// Elements for which `is_droppable` returns `false` are never dropped.
+  /// @returns The number of dropped elements.
+  /// @warning Call only from the reader (owner).
+  template <class Predicate, class F>
+  size_t shrink(size_t max_size, Predicate is_droppable, const F& f) {
+    if (size() <= max_size)
+      return 0;
+    fetch_new_data();
+    size_t dropped = 0;
+    pointer prev = nullptr;
+    auto i = head_;
+    while (i != nullptr && size() > max_size) {
+      auto next = i->next;
+      if (is_droppable(*i)) {
+        if (prev)
+          prev->next = next;
+        else
+          head_ = next;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        f(*i);
+        delete_(i);
+        ++dropped;
+      } else {
+        prev = i;
+      }
+      i = next;
+    }
+    return dropped;
+  }
+
   /// Queries whether this queue is empty.
   /// @warning Call only from the reader (owner).
   bool empty() {
@@ -151,7 +224,7 @@ public:
     cache_.clear(f);
   }
 
-  single_reader_queue() : head_(nullptr) {
+  single_reader_queue() : size_(0), head_(nullptr), dequeued_(0) {
     stack_ = stack_empty_dummy();
   }
 
@@ -161,18 +234,17 @@ public:
     }
   }
 
+  /// Returns how many elements the reader took from this queue so far,
+  /// not counting elements that were removed via `shrink`.
+  /// @warning Call only from the reader (owner).
+  size_t dequeued() const {
+    return dequeued_;
+  }
+
+  /// Returns the number of elements in this queue, including its cache.
+  /// @warning Call only from the reader (owner).
   size_t count(size_t max_count = std::numeric_limits<size_t>::max()) {
-    size_t res = cache_.count(max_count);
-    if (res >= max_count) {
-      return res;
-    }
-    fetch_new_data();
-    auto ptr = head_;
-    while (ptr && res < max_count) {
-      ptr = ptr->next;
-      ++res;
-    }
-    return res;
+    return std::min(cache_.count() + size(), max_count);
   }
 
   // note: the cache is intended to be used by the owner, the queue itself
@@ -238,10 +310,14 @@ private:
   // exposed to "outside" access
   std::atomic<pointer> stack_;
 
+  // approximates the number of elements in `stack_` and `head_`
+  std::atomic<size_t> size_;
+
   // accessed only by the owner
   pointer head_;
   deleter_type delete_;
   intrusive_partitioned_list<value_type, deleter_type> cache_;
+  size_t dequeued_;
 
   // atomically sets stack_ back and enqueues all elements to the cache
   bool fetch_new_data(pointer end_ptr) {
@@ -285,6 +361,8 @@ private:
     if (head_ != nullptr || fetch_new_data()) {
       auto result = head_;
       head_ = head_->next;
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      ++dequeued_;
       return result;
     }
     return nullptr;
@@ -297,6 +375,7 @@ private:
       f(*head_);
       delete_(head_);
       head_ = next;
+      size_.fetch_sub(1, std::memory_order_relaxed);
     }
   }
 
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TIMER_SERVICE_HPP
+#define CAF_DETAIL_TIMER_SERVICE_HPP
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <condition_variable>
+
+#include "caf/channel.hpp"
+#include "caf/message.hpp"
+#include "caf/duration.hpp"
+#include "caf/actor_addr.hpp"
+#include "caf/message_id.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/intrusive_ptr.hpp"
+
+#include "caf/detail/timer_wheel.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Delivers delayed messages using a hierarchical timer wheel that is driven
+/// by a single background thread. Scheduling and cancelling a message is O(1)
+/// and only briefly locks the wheel, i.e., clients never wait for the
+/// background thread.
+class timer_service {
+public:
+  using clock_type = std::chrono::steady_clock;
+
+  /// A delayed message stored in the timer wheel.
+  class entry : public ref_counted, public timer_wheel::node {
+  public:
+    entry(actor_addr from, channel to, message_id mid, message msg);
+
+    ~entry();
+
+    actor_addr from;
+    channel to;
+    message_id mid;
+    message msg;
+  };
+
+  /// Identifies a scheduled message for cancellation.
+  using handle = intrusive_ptr<entry>;
+
+  /// Creates a timer service that checks for expired messages at most
+  /// once per `resolution`.
+  explicit timer_service(clock_type::duration resolution
+                         = std::chrono::milliseconds(1));
+
+  ~timer_service();
+
+  timer_service(const timer_service&) = delete;
+  timer_service& operator=(const timer_service&) = delete;
+
+  /// Starts the background thread.
+  void start();
+
+  /// Stops the background thread and discards all pending messages.
+  void stop();
+
+  /// Sends `msg` as `from` to `to` after `rel_time`.
+  handle schedule(const duration& rel_time, actor_addr from, channel to,
+                  message_id mid, message msg);
+
+  /// Discards the message identified by `hdl` unless it has already been sent.
+  /// @returns `true` if the message was discarded, `false` otherwise.
+  bool cancel(const handle& hdl);
+
+  /// Returns the number of messages waiting for their timeout.
+  size_t pending() const;
+
+private:
+  void run();
+
+  // returns the first tick not earlier than `tp`
+  uint64_t tick_of(clock_type::time_point tp) const;
+
+  clock_type::time_point time_of(uint64_t tick) const;
+
+  clock_type::time_point start_;
+  clock_type::duration resolution_;
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+  timer_wheel wheel_;
+  // tick at which the background thread wakes up next, guarded by mtx_
+  uint64_t wakeup_tick_;
+  bool running_;
+  std::thread thread_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TIMER_SERVICE_HPP
@@ -0,0 +1,158 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TIMER_WHEEL_HPP
+#define CAF_DETAIL_TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace caf {
+namespace detail {
+
+/// A hierarchical hashed timer wheel as described in "Hashed and Hierarchical
+/// Timing Wheels" by Varghese and Lauck. Time is measured in abstract ticks.
+/// The wheel consists of `num_levels` levels with `num_slots` slots each,
+/// whereas one slot on level `n` covers `num_slots^n` ticks. Timers move
+/// down one level at a time whenever the current tick reaches their slot.
+/// Inserting and erasing a timer is O(1). Timers are intrusive, i.e.,
+/// the wheel never allocates and never takes ownership of its nodes.
+/// @note This class is not thread-safe.
+class timer_wheel {
+public:
+  static constexpr size_t slot_bits = 8;
+  static constexpr size_t num_slots = size_t{1} << slot_bits;
+  static constexpr size_t num_levels = 4;
+
+  /// Base class for timers stored in the wheel.
+  class node {
+  public:
+    friend class timer_wheel;
+
+    node() : tick_(0), level_(0), prev_(nullptr), next_(nullptr) {
+      // nop
+    }
+
+    node(const node&) = delete;
+    node& operator=(const node&) = delete;
+
+    /// Returns the tick at which this timer expires.
+    inline uint64_t tick() const {
+      return tick_;
+    }
+
+    /// Returns whether this timer is currently stored in a wheel.
+    inline bool linked() const {
+      return next_ != nullptr;
+    }
+
+  private:
+    uint64_t tick_;
+    size_t level_;
+    node* prev_;
+    node* next_;
+  };
+
+  /// Creates a wheel with `now` as current tick.
+  explicit timer_wheel(uint64_t now = 0);
+
+  timer_wheel(const timer_wheel&) = delete;
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  /// Returns the current tick.
+  inline uint64_t now() const {
+    return now_;
+  }
+
+  /// Returns the number of timers in the wheel.
+  inline size_t size() const {
+    return size_;
+  }
+
+  /// Returns whether the wheel contains no timer.
+  inline bool empty() const {
+    return size_ == 0;
+  }
+
+  /// Adds `ptr` to the wheel, expiring at `tick` or at the next tick
+  /// if `tick` is not in the future.
+  /// @pre `! ptr->linked()`
+  void insert(node* ptr, uint64_t tick);
+
+  /// Removes `ptr` from the wheel without expiring it.
+  /// @returns `false` if `ptr` was not stored in the wheel, `true` otherwise.
+  bool erase(node* ptr);
+
+  /// Returns a lower bound for the next tick at which either a timer
+  /// expires or timers move down one level. Returns `UINT64_MAX`
+  /// if the wheel is empty.
+  uint64_t next_tick() const;
+
+  /// Advances the current tick to `tick` and calls `f` for each expired timer
+  /// in order of expiry. Expired timers are no longer linked when calling `f`.
+  template <class F>
+  void advance(uint64_t tick, F f) {
+    while (now_ < tick && size_ > 0) {
+      auto next = next_tick();
+      if (next > tick) {
+        break;
+      }
+      now_ = next;
+      cascade();
+      auto& sentinel = slots_[0][now_ & slot_mask];
+      while (sentinel.next_ != &sentinel) {
+        auto ptr = sentinel.next_;
+        unlink(ptr);
+        f(ptr);
+      }
+    }
+    if (now_ < tick) {
+      now_ = tick;
+    }
+  }
+
+private:
+  static constexpr uint64_t slot_mask = num_slots - 1;
+
+  // stores `ptr` in the slot matching its tick
+  void place(node* ptr);
+
+  // removes `ptr` from its slot
+  void unlink(node* ptr);
+
+  // moves timers from higher levels down to the current tick
+  void cascade();
+
+  // current tick
+  uint64_t now_;
+
+  // number of stored timers
+  size_t size_;
+
+  // number of stored timers per level
+  size_t level_sizes_[num_levels];
+
+  // each slot is a circular list with a sentinel node
+  node slots_[num_levels][num_slots];
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TIMER_WHEEL_HPP
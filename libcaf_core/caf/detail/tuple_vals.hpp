@@ -23,6 +23,7 @@
 #include <tuple>
 #include <stdexcept>
 
+#include "caf/detail/memory.hpp"
 #include "caf/detail/type_list.hpp"
 
 #include "caf/detail/message_data.hpp"
@@ -68,6 +69,11 @@ struct tuple_vals_type_helper<T, 0> {
   }
 };
 
+inline const uniform_type_info* tuple_vals_type_at(const tuple_vals_rtti& x) {
+  return x.first != 0 ? uniform_typeid_by_nr(x.first)
+                      : uniform_typeid(*x.second, true);
+}
+
 template <class... Ts>
 class tuple_vals : public message_data {
 public:
@@ -77,6 +83,8 @@ public:
 
   using data_type = std::tuple<Ts...>;
 
+  static constexpr auto memory_cache_flag = needs_embedding;
+
   tuple_vals(const tuple_vals&) = default;
 
   template <class... Us>
@@ -99,7 +107,7 @@ public:
   }
 
   message_data::cow_ptr copy() const override {
-    return message_data::cow_ptr(new tuple_vals(*this), false);
+    return message_data::cow_ptr(memory::create<tuple_vals>(*this), false);
   }
 
   const void* at(size_t pos) const override {
@@ -139,6 +147,10 @@ public:
     return types_[pos].first;
   }
 
+  const uniform_type_info* type_at(size_t pos) const override {
+    return tuple_vals_type_at(types_[pos]);
+  }
+
 private:
   data_type data_;
   std::array<tuple_vals_rtti, sizeof...(Ts)> types_;
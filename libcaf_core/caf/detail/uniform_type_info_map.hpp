@@ -57,6 +57,9 @@ public:
 
   virtual pointer by_rtti(const std::type_info& ti) const = 0;
 
+  // returns the user-defined type with `type_id() == id` or `nullptr`
+  virtual pointer by_type_id(uint64_t id) const = 0;
+
   virtual std::vector<pointer> get_all() const = 0;
 
   virtual pointer insert(const std::type_info*, uniform_type_info_ptr) = 0;
@@ -0,0 +1,201 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+#define CAF_DETAIL_WORK_STEALING_DEQUE_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/config.hpp"
+
+#include "caf/detail/double_ended_queue.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A lock-free, array-based work-stealing deque based on
+/// "Dynamic Circular Work-Stealing Deque" by Chase and Lev (SPAA'05) using
+/// the memory orderings from "Correct and Efficient Work-Stealing for Weak
+/// Memory Models" by Le et al. (PPoPP'13). The owner pushes and pops at the
+/// bottom without any allocation as long as the deque does not need to grow,
+/// while any number of thieves can steal the oldest element from the top
+/// in O(1). Buffers grow by doubling their capacity and are never shrunk.
+/// Retired buffers are kept alive until the deque is destroyed, because
+/// thieves may still read from them.
+template <class T>
+class work_stealing_deque {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+  using size_type = size_t;
+
+  /// Creates a deque with an initial capacity of at least `init_capacity`,
+  /// rounded up to the next power of two.
+  explicit work_stealing_deque(size_type init_capacity = 64)
+      : top_(0),
+        bottom_(0) {
+    size_type cap = 2;
+    while (cap < init_capacity) {
+      cap <<= 1;
+    }
+    buffers_.emplace_back(new buffer(cap));
+    buf_ = buffers_.back().get();
+  }
+
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  /// Pushes `value` to the bottom of the deque.
+  /// @warning Call only from the owner.
+  void push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto a = buf_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<index_type>(a->capacity) - 1) {
+      a = grow(a, t, b);
+    }
+    a->store(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Pops the most recently pushed element from the bottom of the deque,
+  /// returns `nullptr` if the deque is empty.
+  /// @warning Call only from the owner.
+  pointer take() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto a = buf_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // deque was already empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto result = a->load(b);
+    if (t == b) {
+      // last element, race against thieves
+      if (! top_.compare_exchange_strong(t, t + 1,
+                                         std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        result = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  /// Steals the oldest element from the top of the deque, returns `nullptr`
+  /// if the deque is empty or if another thread won the race for the element.
+  /// @note Safe to call from any thread.
+  pointer steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    auto a = buf_.load(std::memory_order_acquire);
+    auto result = a->load(t);
+    if (! top_.compare_exchange_strong(t, t + 1,
+                                       std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return result;
+  }
+
+  /// Returns an approximation of the number of elements in the deque.
+  /// @note Safe to call from any thread.
+  size_type size() const {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+
+  /// Checks whether the deque appears empty.
+  /// @note Safe to call from any thread.
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /// Returns the capacity of the current buffer.
+  size_type capacity() const {
+    return buf_.load(std::memory_order_relaxed)->capacity;
+  }
+
+private:
+  using index_type = int64_t;
+
+  struct buffer {
+    size_type capacity;
+    size_type mask;
+    std::unique_ptr<std::atomic<pointer>[]> slots;
+
+    explicit buffer(size_type cap)
+        : capacity(cap),
+          mask(cap - 1),
+          slots(new std::atomic<pointer>[cap]) {
+      // nop
+    }
+
+    pointer load(index_type i) const {
+      return slots[static_cast<size_type>(i) & mask]
+             .load(std::memory_order_relaxed);
+    }
+
+    void store(index_type i, pointer x) {
+      slots[static_cast<size_type>(i) & mask]
+      .store(x, std::memory_order_relaxed);
+    }
+  };
+
+  // precondition: called by the owner
+  buffer* grow(buffer* a, index_type t, index_type b) {
+    buffers_.emplace_back(new buffer(a->capacity * 2));
+    auto na = buffers_.back().get();
+    for (auto i = t; i < b; ++i) {
+      na->store(i, a->load(i));
+    }
+    buf_.store(na, std::memory_order_release);
+    return na;
+  }
+
+  // read by thieves and written by thieves and the owner
+  std::atomic<index_type> top_;
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)];
+  // written only by the owner
+  std::atomic<index_type> bottom_;
+  std::atomic<buffer*> buf_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<index_type>)
+             - sizeof(std::atomic<buffer*>)];
+  // owns the current buffer as well as all retired buffers (owner only)
+  std::vector<std::unique_ptr<buffer>> buffers_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_WORK_STEALING_DEQUE_HPP
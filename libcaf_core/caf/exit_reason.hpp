@@ -44,6 +44,10 @@ static constexpr uint32_t unknown = 0x00006;
 /// Indicates that an actor pool unexpectedly ran out of workers.
 static constexpr uint32_t out_of_workers = 0x00007;
 
+/// Indicates that a synchronous request was rejected because the
+/// mailbox of the receiver was full. The receiver is still alive.
+static constexpr uint32_t mailbox_overflow = 0x00008;
+
 /// Indicates that the actor was forced to shutdown by a user-generated event.
 static constexpr uint32_t user_shutdown = 0x00010;
 
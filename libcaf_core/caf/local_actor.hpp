@@ -24,7 +24,6 @@
 #include <cstdint>
 #include <exception>
 #include <functional>
-#include <forward_list>
 
 #include "caf/fwd.hpp"
 
@@ -48,6 +47,7 @@
 #include "caf/message_handler.hpp"
 #include "caf/response_promise.hpp"
 #include "caf/message_priority.hpp"
+#include "caf/overflow_policy.hpp"
 #include "caf/check_typed_input.hpp"
 #include "caf/invoke_message_result.hpp"
 
@@ -55,7 +55,10 @@
 #include "caf/detail/disposer.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/typed_actor_util.hpp"
+#include "caf/detail/timer_service.hpp"
 #include "caf/detail/single_reader_queue.hpp"
+#include "caf/detail/mailbox_cache_index.hpp"
+#include "caf/detail/pending_response_table.hpp"
 #include "caf/detail/memory_cache_flag_type.hpp"
 
 namespace caf {
@@ -69,6 +72,9 @@ public:
 
   static constexpr auto memory_cache_flag = detail::needs_embedding;
 
+  /// Denotes the mailbox capacity of actors spawned with `bounded_mailbox`.
+  static constexpr size_t default_mailbox_capacity = 1000;
+
   ~local_actor();
 
   /****************************************************************************
@@ -314,6 +320,23 @@ public:
     set_flag(value, trap_exit_flag);
   }
 
+  /// Bounds the mailbox of this actor to `capacity` messages and applies
+  /// `policy` to messages arriving while the mailbox is full. A capacity
+  /// of 0 removes the bound. The bound is approximate, i.e., concurrent
+  /// senders can exceed it by a few messages.
+  void bound_mailbox(size_t capacity,
+                     overflow_policy policy = overflow_policy::reject);
+
+  /// Returns the capacity of the mailbox or 0 if the mailbox is unbounded.
+  inline size_t mailbox_capacity() const {
+    return mailbox_capacity_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns how this actor treats messages arriving at a full mailbox.
+  inline overflow_policy mailbox_overflow_policy() const {
+    return overflow_policy_.load(std::memory_order_relaxed);
+  }
+
   /// Returns the currently processed message.
   /// @warning Only set during callback invocation. Calling this member function
   ///          is undefined behavior (dereferencing a `nullptr`) when not in a
@@ -473,7 +496,8 @@ public:
     return req_id.response_id();
   }
 
-  void request_sync_timeout_msg(const duration& dr, message_id mid);
+  detail::timer_service::handle request_sync_timeout_msg(const duration& dr,
+                                                         message_id mid);
 
   // returns 0 if last_dequeued() is an asynchronous or sync request message,
   // a response id generated from the request id otherwise
@@ -595,7 +619,7 @@ public:
                                        behavior& fun,
                                        message_id awaited_response);
 
-  using pending_response = std::pair<message_id, behavior>;
+  using pending_response = detail::pending_response_table::value_type;
 
   message_id new_request_id(message_priority mp);
 
@@ -628,6 +652,14 @@ public:
 
   void push_to_cache(mailbox_element_ptr);
 
+  // applies the overflow policy if the mailbox is full, returns `true`
+  // if `ptr` was consumed, i.e., must not be enqueued
+  bool handle_overflow(mailbox_element_ptr& ptr, execution_unit* eu);
+
+  // drops the oldest messages if the mailbox exceeds its capacity
+  // and the actor uses `overflow_policy::drop_oldest`
+  void shrink_mailbox();
+
   bool invoke_from_cache();
 
   bool invoke_from_cache(behavior&, message_id);
@@ -646,7 +678,7 @@ protected:
   message_id last_request_id_;
 
   // identifies all IDs of sync messages waiting for a response
-  std::forward_list<pending_response> pending_responses_;
+  detail::pending_response_table pending_responses_;
 
   // points to dummy_node_ if no callback is currently invoked,
   // points to the node under processing otherwise
@@ -658,12 +690,24 @@ protected:
   // identifies the timeout messages we are currently waiting for
   uint32_t timeout_id_;
 
+  // allows us to cancel the active timeout before it expires
+  detail::timer_service::handle timeout_handle_;
+
   // used by both event-based and blocking actors
   detail::behavior_stack bhvr_stack_;
 
   // used by both event-based and blocking actors
   mailbox_type mailbox_;
 
+  // indexes the skipped messages in the cache of `mailbox_`
+  detail::mailbox_cache_index cache_index_;
+
+  // maximum number of messages in `mailbox_`, 0 if unbounded
+  std::atomic<size_t> mailbox_capacity_;
+
+  // selects how `enqueue` handles messages to a full mailbox
+  std::atomic<overflow_policy> overflow_policy_;
+
   // used by functor-based actors to implemented make_behavior() or act()
   std::function<behavior (local_actor*)> initial_behavior_fac_;
 
@@ -690,8 +734,13 @@ private:
 
   void send_impl(message_id mid, abstract_channel* dest, message what) const;
 
-  void delayed_send_impl(message_id mid, const channel& whom,
-                         const duration& rtime, message data);
+  detail::timer_service::handle delayed_send_impl(message_id mid,
+                                                  const channel& whom,
+                                                  const duration& rtime,
+                                                  message data);
+
+  // discards the delayed timeout message of the active timeout, if any
+  void cancel_timeout();
 
   std::function<void()> sync_failure_handler_;
 };
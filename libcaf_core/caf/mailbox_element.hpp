@@ -21,6 +21,8 @@
 #define CAF_MAILBOX_ELEMENT_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
 
 #include "caf/extend.hpp"
 #include "caf/message.hpp"
@@ -42,9 +44,13 @@ class mailbox_element : public memory_managed {
 public:
   static constexpr auto memory_cache_flag = detail::needs_embedding;
 
+  /// Maximum number of elements `make_n` allocates at once.
+  static constexpr size_t max_batch_size = 64;
+
   mailbox_element* next; // intrusive next pointer
   mailbox_element* prev; // intrusive previous pointer
   bool marked;           // denotes if this node is currently processed
+  uint32_t enqueued;     // metrics timestamp of the enqueue operation or 0
   actor_addr sender;
   message_id mid;
   message msg;           // 'content field'
@@ -64,6 +70,30 @@ public:
 
   static unique_ptr make(actor_addr sender, message_id id, message msg);
 
+  /// Creates `n` elements sharing the content `msg` and calls `f` with
+  /// each one. Allocates all elements in a single batch and increases the
+  /// reference count of the content only once, e.g., for delivering
+  /// `msg` to a group or to all workers of a pool.
+  template <class F>
+  static void make_n(size_t n, const actor_addr& sender, message_id id,
+                     const message& msg, F f) {
+    auto data = msg.cvals().get();
+    if (data)
+      data->ref(n);
+    auto g = [&](mailbox_element* ptr) {
+      // adopt one of the references acquired above
+      ptr->msg.vals().reset(data, false);
+      f(unique_ptr{ptr});
+    };
+    // allocate in chunks to keep new elements in the cache until `f`
+    // passes them on, e.g., to the mailbox of a receiver
+    while (n > 0) {
+      auto chunk = std::min(n, max_batch_size);
+      detail::memory::create_n<mailbox_element>(chunk, g, sender, id);
+      n -= chunk;
+    }
+  }
+
   template <class... Ts>
   static unique_ptr make_joint(actor_addr sender, message_id id, Ts&&... xs) {
     using value_storage =
@@ -99,6 +99,10 @@ public:
   /// Returns the uniform type name for the element at position `p`.
   const char* uniform_name_at(size_t p) const;
 
+  /// Returns the type of the element at position `p` or `nullptr`
+  /// if the type has not been announced.
+  const uniform_type_info* type_at(size_t p) const;
+
   /// Returns @c true if `*this == other, otherwise false.
   bool equals(const message& other) const;
 
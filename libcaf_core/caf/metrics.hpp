@@ -0,0 +1,170 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#ifndef CAF_METRICS_HPP
+#define CAF_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// Collects runtime metrics of the scheduler, mailboxes, timers and the
+/// network layer. Collection is disabled by default, in which case each
+/// instrumented code path only checks a single flag. Counters and
+/// histograms are kept per thread and summed up when taking a snapshot,
+/// i.e., updating them never synchronizes threads.
+class metrics {
+public:
+  metrics() = delete;
+
+  enum counter_id : size_t {
+    /// Jobs a worker stole from another worker.
+    worker_steals,
+    /// Nanoseconds workers spent waiting for a job.
+    worker_idle_ns,
+    /// Transitions of actor mailboxes to the blocked state.
+    mailbox_blocked,
+    /// Transitions of actor mailboxes from the blocked state.
+    mailbox_unblocked,
+    /// Calls to receive data from a socket.
+    net_read_calls,
+    /// Bytes received from sockets.
+    net_bytes_read,
+    /// Calls to send data to a socket.
+    net_write_calls,
+    /// Bytes sent to sockets.
+    net_bytes_written,
+    num_counters
+  };
+
+  enum gauge_id : size_t {
+    /// Delayed messages waiting for their timeout.
+    pending_timers,
+    num_gauges
+  };
+
+  enum histogram_id : size_t {
+    /// Mailbox depth of actors when taking a message out of their mailbox.
+    mailbox_depth,
+    /// Microseconds between enqueueing and dequeueing a message.
+    mailbox_latency_us,
+    num_histograms
+  };
+
+  /// Number of buckets per histogram. Values below 4 have their own bucket,
+  /// larger values share a bucket with values that have the same two bits
+  /// after the most significant bit, i.e., bucket bounds have a relative
+  /// error of at most 25%.
+  static constexpr size_t histogram_buckets = 252;
+
+  /// A consistent view of all metrics at one point in time.
+  struct snapshot {
+    struct histogram {
+      uint64_t count;
+      uint64_t sum;
+      std::vector<uint64_t> buckets;
+
+      /// Returns the lower bound of the bucket containing the
+      /// `p`-th percentile, e.g., `percentile(0.99)`.
+      uint64_t percentile(double p) const;
+    };
+
+    uint64_t counters[num_counters];
+    int64_t gauges[num_gauges];
+    histogram histograms[num_histograms];
+  };
+
+  /// Queries whether metrics are collected.
+  static inline bool enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /// Enables or disables collecting metrics. Gauges keep their last value
+  /// while disabled and update on their next change after enabling.
+  static void enable(bool value = true);
+
+  /// Adds `n` to counter `x`.
+  static inline void add(counter_id x, uint64_t n = 1) {
+    if (enabled())
+      add_impl(x, n);
+  }
+
+  /// Sets gauge `x` to `value`.
+  static inline void set(gauge_id x, int64_t value) {
+    if (enabled())
+      gauges_[x].store(value, std::memory_order_relaxed);
+  }
+
+  /// Adds `value` to histogram `x`.
+  static inline void record(histogram_id x, uint64_t value) {
+    if (enabled())
+      record_impl(x, value);
+  }
+
+  /// Returns a timestamp for measuring latencies in microseconds. Wraps
+  /// around after about 71 minutes, i.e., differences between two
+  /// timestamps are valid as long as they are shorter than that.
+  static inline uint32_t timestamp() {
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(t);
+    return static_cast<uint32_t>(us.count());
+  }
+
+  /// Returns the index of the bucket for `value`.
+  static size_t bucket_of(uint64_t value);
+
+  /// Returns the smallest value stored in bucket `index`.
+  static uint64_t lower_bound_of(size_t index);
+
+  static const char* name(counter_id x);
+
+  static const char* name(gauge_id x);
+
+  static const char* name(histogram_id x);
+
+  /// Sums up the values of all threads.
+  static snapshot take_snapshot();
+
+  /// Spawns a hidden actor that responds to `get_atom` with a
+  /// `metrics::snapshot`.
+  static actor spawn_reporter();
+
+private:
+  static void add_impl(counter_id x, uint64_t n);
+
+  static void record_impl(histogram_id x, uint64_t value);
+
+  static std::atomic<bool> enabled_;
+
+  static std::atomic<int64_t> gauges_[num_gauges];
+};
+
+/// Renders `x` in a line-based text format with one `name value` pair per
+/// line, e.g., for exporting to monitoring systems.
+std::string to_string(const metrics::snapshot& x);
+
+} // namespace caf
+
+#endif // CAF_METRICS_HPP
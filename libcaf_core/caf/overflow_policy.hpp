@@ -0,0 +1,51 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_OVERFLOW_POLICY_HPP
+#define CAF_OVERFLOW_POLICY_HPP
+
+#include <cstdint>
+
+namespace caf {
+
+/// Selects how an actor with a bounded mailbox treats
+/// messages that arrive while its mailbox is full.
+/// @note Responses and system messages such as `exit_msg` and
+///       `down_msg` are never dropped.
+enum class overflow_policy : uint32_t {
+  /// Drops the new message.
+  drop_newest,
+  /// Accepts the new message and drops the oldest messages
+  /// in the mailbox as soon as the actor runs again. Drops the
+  /// new message if the mailbox holds twice its capacity, i.e.,
+  /// if senders outpace the actor.
+  drop_oldest,
+  /// Drops the new message and answers synchronous requests with a
+  /// `sync_exited_msg` using `exit_reason::mailbox_overflow`.
+  reject,
+  /// Accepts the new message and sends `{'OVERFLOW', addr}` to the sender,
+  /// where `addr` is the address of the receiver. Senders are expected to
+  /// slow down in response, i.e., the mailbox is only bounded if all
+  /// senders cooperate.
+  backpressure
+};
+
+} // namespace caf
+
+#endif // CAF_OVERFLOW_POLICY_HPP
@@ -21,7 +21,6 @@
 #define CAF_POLICY_PROFILED_HPP
 
 #include "caf/resumable.hpp"
-#include "caf/abstract_actor.hpp"
 
 namespace caf {
 
@@ -34,37 +33,25 @@ class profiled_coordinator;
 
 namespace policy {
 
-/// An enhancement of CAF's scheduling policy which records fine-grained
+/// An enhancement of CAF's scheduling policy which records per-actor
 /// resource utiliziation for worker threads and actors in the parent
 /// coordinator of the workers.
 template <class Policy>
 struct profiled : Policy {
   using coordinator_type = scheduler::profiled_coordinator<profiled<Policy>>;
 
-  static actor_id id_of(resumable* job) {
-    auto ptr = dynamic_cast<abstract_actor*>(job);
-    return ptr ? ptr->id() : 0;
-  }
-
   template <class Worker>
   void before_resume(Worker* worker, resumable* job) {
     Policy::before_resume(worker, job);
     auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->start_measuring(worker->id(), id_of(job));
+    parent->start_measuring(worker->id(), job);
   }
 
   template <class Worker>
   void after_resume(Worker* worker, resumable* job) {
     Policy::after_resume(worker, job);
     auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->stop_measuring(worker->id(), id_of(job));
-  }
-
-  template <class Worker>
-  void after_completion(Worker* worker, resumable* job) {
-    Policy::after_completion(worker, job);
-    auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->remove_job(id_of(job));
+    parent->stop_measuring(worker->id(), job);
   }
 };
 
@@ -58,6 +58,11 @@ public:
   template <class Worker>
   resumable* dequeue(Worker* self);
 
+  /// Called once by each worker from its own thread before
+  /// dequeueing the first job, e.g., to set the thread's CPU affinity.
+  template <class Worker>
+  void init_worker_thread(Worker* self);
+
   /// Performs cleanup action before a shutdown takes place.
   template <class Worker>
   void before_shutdown(Worker* self);
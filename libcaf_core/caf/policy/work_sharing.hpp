@@ -105,6 +105,11 @@ public:
     return job;
   }
 
+  template <class Worker>
+  void init_worker_thread(Worker*) {
+    // nop
+  }
+
   template <class Worker>
   void before_shutdown(Worker*) {
     // nop
@@ -20,15 +20,23 @@
 #ifndef CAF_POLICY_WORK_STEALING_HPP
 #define CAF_POLICY_WORK_STEALING_HPP
 
-#include <deque>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 #include <random>
+#include <vector>
 #include <cstddef>
+#include <utility>
+#include <condition_variable>
 
+#include "caf/metrics.hpp"
 #include "caf/resumable.hpp"
 
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/work_stealing_deque.hpp"
 
 namespace caf {
 namespace policy {
@@ -46,34 +54,96 @@ namespace policy {
 /// worker makes sure that at least one job is left in its exposed queue
 /// to allow other workers to steal it.
 ///
+/// Jobs enqueued by the worker itself go to a lock-free Chase-Lev deque [2]
+/// that the worker accesses without allocating and thieves steal from in
+/// O(1). Jobs from other threads as well as jobs that voluntarily released
+/// the CPU go to a separate inbox that is drained once the deque is empty.
+///
+/// Idle workers poll their queues and try to steal for a configurable number
+/// of attempts before parking. Parked workers consume no CPU time and are
+/// woken up one at a time as soon as new jobs arrive.
+///
+/// In the optional topology-aware mode, each worker is pinned to a CPU and
+/// steals from workers sharing a cache first, then from workers on the same
+/// NUMA node and only then from workers on other nodes. Since workers are
+/// pinned before allocating anything, their thread-local memory caches
+/// reside on their own NUMA node.
+///
 /// [1] http://dl.acm.org/citation.cfm?doid=2398857.2384639
+/// [2] http://dl.acm.org/citation.cfm?doid=1073970.1073974
 ///
 /// @extends scheduler_policy
 class work_stealing {
 public:
-  // A thead-safe queue implementation.
-  using queue_type = detail::double_ended_queue<resumable>;
+  // A lock-free owner/thief deque for jobs enqueued by the worker itself.
+  using queue_type = detail::work_stealing_deque<resumable>;
+
+  // A thead-safe queue implementation for jobs enqueued by other threads.
+  using inbox_type = detail::double_ended_queue<resumable>;
+
+  /// Configures how idle workers look for new jobs before parking.
+  struct config {
+    /// Number of polling attempts before an idle worker parks.
+    size_t spin_attempts;
+    /// Idle workers try to steal a job every `steal_interval` attempts.
+    size_t steal_interval;
+    /// Pins workers to CPUs and prefers nearby victims when stealing.
+    bool topology_aware;
+    inline config()
+        : spin_attempts(100),
+          steal_interval(10),
+          topology_aware(false) {
+      // nop
+    }
+  };
 
-  // The coordinator has only a counter for round-robin enqueue to its workers.
+  // The coordinator has a counter for round-robin enqueue to its workers
+  // and a parking lot for idle workers.
   struct coordinator_data {
     std::atomic<size_t> next_worker;
-    inline coordinator_data() : next_worker(0) {
+    // configures polling and parking of workers
+    config cfg;
+    // number of currently parked workers
+    std::atomic<size_t> sleepers;
+    // guards parking and unparking of workers
+    std::mutex lock;
+    // parked workers wait on this condition variable
+    std::condition_variable cv;
+    // CPUs assigned to workers in topology-aware mode
+    std::vector<detail::cpu_info> cpus;
+    // initializes `cpus` when the first worker starts
+    std::once_flag cpus_init;
+    inline coordinator_data() : next_worker(0), sleepers(0) {
       // nop
     }
   };
 
-  // Holds job job queue of a worker and a random number generator.
+  // Holds job job queues of a worker and a random number generator.
   struct worker_data {
     // This queue is exposed to other workers that may attempt to steal jobs
-    // from it and the central scheduling unit can push new jobs to the queue.
+    // from it, but only the worker itself can push new jobs to the queue.
     queue_type queue;
+    // The central scheduling unit and other threads push new jobs to this
+    // queue, which is exposed to thieves as well.
+    inbox_type inbox;
     // needed by our engine
     std::random_device rdevice;
     // needed to generate pseudo random numbers
     std::default_random_engine rengine;
+    // IDs of all other workers ordered by distance in topology-aware mode
+    std::vector<size_t> victims;
+    // `victims[0, tier_ends[0])` share a cache with this worker, followed
+    // by workers on the same NUMA node and workers on other nodes
+    size_t tier_ends[detail::num_cpu_distances];
+    // number of successful steals per distance in topology-aware mode,
+    // written only by this worker
+    std::atomic<size_t> steals[detail::num_cpu_distances];
     // initialize random engine
     inline worker_data() : rdevice(), rengine(rdevice()) {
-      // nop
+      for (size_t i = 0; i < detail::num_cpu_distances; ++i) {
+        tier_ends[i] = 0;
+        steals[i] = 0;
+      }
     }
   };
 
@@ -83,6 +153,66 @@ public:
     return self->data();
   }
 
+  // Takes the next job from the worker's own queues, preferring jobs
+  // enqueued by the worker itself over jobs from other threads.
+  template <class Worker>
+  resumable* take_local(Worker* self) {
+    auto job = d(self).queue.take();
+    return job ? job : d(self).inbox.take_head();
+  }
+
+  // Checks whether any worker of `self` has a job in one of its queues.
+  template <class Coordinator>
+  bool has_work(Coordinator* self) {
+    for (size_t i = 0; i < self->num_workers(); ++i) {
+      auto& wd = d(self->worker_by_id(i));
+      if (! wd.queue.empty() || ! wd.inbox.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Wakes up one parked worker if any. The fence pairs with the fence in
+  // `park` to make sure that either the enqueued job is visible to the worker
+  // or the worker is visible as sleeper to us.
+  template <class Coordinator>
+  void wake_one(Coordinator* self) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (d(self).sleepers.load(std::memory_order_relaxed) > 0) {
+      std::unique_lock<std::mutex> guard(d(self).lock);
+      d(self).cv.notify_one();
+    }
+  }
+
+  // Blocks the calling worker until there is work in the system.
+  template <class Worker>
+  void park(Worker* self) {
+    auto p = self->parent();
+    auto& pd = d(p);
+    std::unique_lock<std::mutex> guard(pd.lock);
+    pd.sleepers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (! has_work(p)) {
+      pd.cv.wait(guard);
+    }
+    pd.sleepers.fetch_sub(1);
+  }
+
+  // Steals the oldest job from the queues of `victim`.
+  template <class Worker>
+  resumable* steal_from(Worker* victim) {
+    auto& vd = d(victim);
+    auto job = vd.queue.steal();
+    if (! job && ! vd.inbox.empty()) {
+      job = vd.inbox.take_head();
+    }
+    if (job) {
+      metrics::add(metrics::worker_steals);
+    }
+    return job;
+  }
+
   // Goes on a raid in quest for a shiny new job.
   template <class Worker>
   resumable* try_steal(Worker* self) {
@@ -91,12 +221,43 @@ public:
       // you can't steal from yourself, can you?
       return nullptr;
     }
+    if (! d(self).victims.empty()) {
+      return try_steal_nearby(self);
+    }
     // roll the dice to pick a victim other than ourselves
     size_t victim = d(self).rengine() % (p->num_workers() - 1);
     if (victim == self->id())
       victim = p->num_workers() - 1;
-    // steal oldest element from the victim's queue
-    return d(p->worker_by_id(victim)).queue.take_tail();
+    // steal oldest element from the victim's queues
+    return steal_from(p->worker_by_id(victim));
+  }
+
+  // Visits victims in order of their distance, starting at a random
+  // victim within each tier to spread steals among equally close workers.
+  template <class Worker>
+  resumable* try_steal_nearby(Worker* self) {
+    auto p = self->parent();
+    auto& wd = d(self);
+    size_t first = 0;
+    for (size_t tier = 0; tier < detail::num_cpu_distances; ++tier) {
+      auto last = wd.tier_ends[tier];
+      auto n = last - first;
+      if (n > 0) {
+        auto offset = wd.rengine() % n;
+        for (size_t i = 0; i < n; ++i) {
+          auto victim = wd.victims[first + (offset + i) % n];
+          auto job = steal_from(p->worker_by_id(victim));
+          if (job) {
+            auto& counter = wd.steals[tier];
+            counter.store(counter.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+            return job;
+          }
+        }
+      }
+      first = last;
+    }
+    return nullptr;
   }
 
   template <class Coordinator>
@@ -107,64 +268,118 @@ public:
 
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
-    d(self).queue.append(job);
+    d(self).inbox.append(job);
+    wake_one(self->parent());
   }
 
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& q = d(self).queue;
+    q.push(job);
+    // the worker runs its only job itself, but more jobs than that are worth
+    // waking up a thief; missing a sleeper here is harmless, because
+    // this worker is going to run the job eventually
+    auto p = self->parent();
+    if (q.size() > 1 && d(p).sleepers.load(std::memory_order_relaxed) > 0) {
+      wake_one(p);
+    }
   }
 
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job) {
     // job has voluntarily released the CPU to let others run instead
-    // this means we are going to put this job to the very end of our queue
-    d(self).queue.append(job);
+    // this means we are going to put this job to the very end of our queues
+    d(self).inbox.append(job);
   }
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
-    // we wait for new jobs by polling our external queue: first, we
-    // assume an active work load on the machine and perform aggresive
-    // polling, then we relax our polling a bit and wait 50 us between
-    // dequeue attempts, finally we assume pretty much nothing is going
-    // on and poll every 10 ms; this strategy strives to minimize the
-    // downside of "busy waiting", which still performs much better than a
-    // "signalizing" implementation based on mutexes and conition variables
-    struct poll_strategy {
-      size_t attempts;
-      size_t step_size;
-      size_t steal_interval;
-      std::chrono::microseconds sleep_duration;
-    };
-    poll_strategy strategies[3] = {
-      // aggressive polling  (100x) without sleep interval
-      {100, 1, 10, std::chrono::microseconds{0}},
-      // moderate polling (500x) with 50 us sleep interval
-      {500, 1, 5,  std::chrono::microseconds{50}},
-      // relaxed polling (infinite attempts) with 10 ms sleep interval
-      {101, 0, 1,  std::chrono::microseconds{10000}}
-    };
-    resumable* job = nullptr;
-    for (auto& strat : strategies) {
-      for (size_t i = 0; i < strat.attempts; i += strat.step_size) {
-        job = d(self).queue.take_head();
+    auto job = take_local(self);
+    if (job) {
+      return job;
+    }
+    if (! metrics::enabled()) {
+      return await_job(self);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    job = await_job(self);
+    auto idle = std::chrono::steady_clock::now() - t0;
+    using std::chrono::nanoseconds;
+    metrics::add(metrics::worker_idle_ns,
+                 static_cast<uint64_t>(
+                   std::chrono::duration_cast<nanoseconds>(idle).count()));
+    return job;
+  }
+
+  // Waits for a new job after the worker ran out of local jobs.
+  template <class Worker>
+  resumable* await_job(Worker* self) {
+    // we wait for new jobs by polling our queues and trying to steal from
+    // others for a configurable number of attempts, assuming an active work
+    // load on the machine; afterwards we assume pretty much nothing is going
+    // on and park the worker until someone enqueues a new job
+    auto& cfg = d(self->parent()).cfg;
+    auto steal_interval = std::max(cfg.steal_interval, size_t{1});
+    for (;;) {
+      for (size_t i = 0; i < cfg.spin_attempts; ++i) {
+        auto job = take_local(self);
         if (job) {
           return job;
         }
         // try to steal every X poll attempts
-        if ((i % strat.steal_interval) == 0) {
+        if ((i % steal_interval) == 0) {
           job = try_steal(self);
           if (job) {
             return job;
           }
         }
-        std::this_thread::sleep_for(strat.sleep_duration);
+        std::this_thread::yield();
+      }
+      auto job = take_local(self);
+      if (job) {
+        return job;
       }
+      park(self);
+    }
+  }
+
+  template <class Worker>
+  void init_worker_thread(Worker* self) {
+    auto p = self->parent();
+    auto& pd = d(p);
+    if (! pd.cfg.topology_aware) {
+      return;
+    }
+    std::call_once(pd.cpus_init, [&] {
+      pd.cpus = detail::select_worker_cpus(detail::get_cpu_topology(),
+                                           p->num_workers());
+    });
+    if (pd.cpus.size() != p->num_workers()) {
+      // topology unavailable, fall back to random victims
+      return;
+    }
+    auto& cpu = pd.cpus[self->id()];
+    detail::pin_this_thread(cpu.id);
+    // sort all other workers by their distance to us
+    auto& wd = d(self);
+    size_t sizes[detail::num_cpu_distances] = {};
+    std::vector<std::pair<size_t, size_t>> xs;
+    for (size_t i = 0; i < p->num_workers(); ++i) {
+      if (i != self->id()) {
+        auto dist = static_cast<size_t>(detail::distance(cpu, pd.cpus[i]));
+        ++sizes[dist];
+        xs.emplace_back(dist, i);
+      }
+    }
+    std::stable_sort(xs.begin(), xs.end());
+    for (auto& x : xs) {
+      wd.victims.push_back(x.second);
+    }
+    size_t end = 0;
+    for (size_t i = 0; i < detail::num_cpu_distances; ++i) {
+      end += sizes[i];
+      wd.tier_ends[i] = end;
     }
-    // unreachable, because the last strategy loops
-    // until a job has been dequeued
-    return nullptr;
   }
 
   template <class Worker>
@@ -189,7 +404,7 @@ public:
 
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
-    auto next = [&] { return d(self).queue.take_head(); };
+    auto next = [&] { return take_local(self); };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
     }
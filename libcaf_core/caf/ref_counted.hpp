@@ -44,6 +44,12 @@ public:
     rc_.fetch_add(1, std::memory_order_relaxed);
   }
 
+  /// Increases reference count by `n`, e.g., before handing
+  /// this object to `n` owners that adopt one reference each.
+  inline void ref(size_t n) noexcept {
+    rc_.fetch_add(n, std::memory_order_relaxed);
+  }
+
   /// Decreases reference count by one and calls `request_deletion`
   /// when it drops to zero.
   void deref() noexcept;
@@ -32,6 +32,8 @@
 #include "caf/duration.hpp"
 #include "caf/actor_addr.hpp"
 
+#include "caf/detail/timer_service.hpp"
+
 namespace caf {
 namespace scheduler {
 
@@ -56,13 +58,27 @@ public:
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Identifies a delayed message.
+  using timer_handle = detail::timer_service::handle;
+
+  /// Sends `data` to `to` after `rel_time` unless the returned
+  /// handle is passed to `cancel_delayed_send` before.
   template <class Duration, class... Data>
-  void delayed_send(Duration rel_time, actor_addr from, channel to,
-                    message_id mid, message data) {
-    timer_->enqueue(invalid_actor_addr, invalid_message_id,
-                     make_message(duration{rel_time}, std::move(from),
-                                  std::move(to), mid, std::move(data)),
-                     nullptr);
+  timer_handle delayed_send(Duration rel_time, actor_addr from, channel to,
+                            message_id mid, message data) {
+    return timer_.schedule(duration{rel_time}, std::move(from),
+                           std::move(to), mid, std::move(data));
+  }
+
+  /// Discards a delayed message unless it has already been sent.
+  /// @returns `true` if the message was discarded, `false` otherwise.
+  inline bool cancel_delayed_send(const timer_handle& hdl) {
+    return timer_.cancel(hdl);
+  }
+
+  /// Returns the number of delayed messages waiting for their timeout.
+  inline size_t pending_delayed_sends() const {
+    return timer_.pending();
   }
 
   inline size_t max_throughput() const {
@@ -97,7 +113,7 @@ protected:
 
   size_t num_workers_;
 
-  actor timer_;
+  detail::timer_service timer_;
   actor printer_;
 };
 
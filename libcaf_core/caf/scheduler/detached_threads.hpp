@@ -21,7 +21,9 @@
 #ifndef CAF_SCHEDULER_DETACHED_THREADS_HPP
 #define CAF_SCHEDULER_DETACHED_THREADS_HPP
 
+#include <chrono>
 #include <cstddef>
+#include <functional>
 
 namespace caf {
 namespace scheduler {
@@ -32,9 +34,25 @@ void inc_detached_threads();
 /// Decreases count for detached threads by one.
 void dec_detached_threads();
 
-/// Blocks the caller until all detached threads are done.
+/// Blocks the caller until all detached threads are done
+/// and stops all idle threads of the pool.
 void await_detached_threads();
 
+/// Runs `f` in its own thread. Reuses an idle thread of the pool if
+/// available and starts a new thread otherwise. The number of threads
+/// running at the same time is not limited, since detached actors
+/// can block each other.
+void run_detached(std::function<void ()> f);
+
+/// Configures how many threads the pool keeps for reuse after finishing
+/// their job and how long each one waits for a new job before terminating.
+/// The new limits apply to threads becoming idle afterwards.
+void set_detached_pool_limits(size_t max_idle,
+                              std::chrono::milliseconds idle_timeout);
+
+/// Returns the number of idle threads in the pool.
+size_t idle_detached_threads();
+
 } // namespace scheduler
 } // namespace caf
 
@@ -16,143 +16,98 @@
  * http://opensource.org/licenses/BSD-3-Clause and                            *
  * http://www.boost.org/LICENSE_1_0.txt.                                      *
  ******************************************************************************/
-
 #ifndef CAF_SCHEDULER_PROFILED_COORDINATOR_HPP
 #define CAF_SCHEDULER_PROFILED_COORDINATOR_HPP
 
-#include "caf/config.hpp"
-
-#if defined(CAF_MACOS) || defined(CAF_IOS)
-#include <mach/mach.h>
-#else
-#include <sys/resource.h>
-#endif // CAF_MACOS
-
-#include <cmath>
+#include <array>
 #include <mutex>
 #include <chrono>
+#include <limits>
 #include <vector>
+#include <cstdint>
 #include <fstream>
-#include <iomanip>
+#include <stdexcept>
 #include <unordered_map>
 
+#include "caf/local_actor.hpp"
+
 #include "caf/policy/profiled.hpp"
 #include "caf/policy/work_stealing.hpp"
 
 #include "caf/detail/logging.hpp"
+#include "caf/detail/double_ended_queue.hpp"
 
 namespace caf {
 namespace scheduler {
 
 /// A coordinator which keeps fine-grained profiling state about its workers
-/// and their jobs.
+/// and their jobs. Each worker aggregates its measurements without
+/// synchronization and periodically appends them to a CSV file with the
+/// columns:
+///
+/// - `clock`: UNIX timestamp in milliseconds
+/// - `type`: "actor" or "worker"
+/// - `id`: ID of the actor or the worker
+/// - `worker`: ID of the reporting worker
+/// - `resumes`: number of resumes
+/// - `messages`: number of messages taken from the mailbox
+/// - `samples`: number of measured resumes
+/// - `time`: nanoseconds spent in measured resumes
+/// - `depth_0`, `depth_1`, `depth_2`, `depth_4`, ...: histogram of the
+///   mailbox depth at the beginning of measured resumes
+///
+/// Each row covers the time since the previous flush of its worker. Hence,
+/// summing up all rows by `type` and `id` yields the totals, even for rows
+/// of multiple files. Setting `sample_interval` to `n` only measures every
+/// `n`th resume of a worker.
 template <class Policy = policy::profiled<policy::work_stealing>>
 class profiled_coordinator : public coordinator<Policy> {
 public:
   using super = coordinator<Policy>;
-  using clock_type = std::chrono::high_resolution_clock;
+  using clock_type = std::chrono::steady_clock;
 
-  using usec = std::chrono::microseconds;
   using msec = std::chrono::milliseconds;
 
-  class measurement {
-  public:
-#   if defined(CAF_MACOS) || defined(CAF_IOS)
-    static usec to_usec(const ::time_value_t& tv) {
-      return std::chrono::seconds(tv.seconds) + usec(tv.microseconds);
-    }
-#   else
-    static usec to_usec(const ::timeval& tv) {
-      return std::chrono::seconds(tv.tv_sec) + usec(tv.tv_usec);
-    }
-#   endif // CAF_MACOS
-
-    static measurement take() {
-      auto now = clock_type::now().time_since_epoch();
-      measurement m;
-      m.runtime = std::chrono::duration_cast<usec>(now);
-#     if defined(CAF_MACOS) || defined(CAF_IOS)
-      auto tself = ::mach_thread_self();
-      ::thread_basic_info info;
-      auto count = THREAD_BASIC_INFO_COUNT;
-      auto result = ::thread_info(tself, THREAD_BASIC_INFO,
-                                  reinterpret_cast<thread_info_t>(&info),
-                                  &count);
-      if (result == KERN_SUCCESS && (info.flags & TH_FLAGS_IDLE) == 0) {
-        m.usr = to_usec(info.user_time);
-        m.sys = to_usec(info.system_time);
-      }
-      ::mach_port_deallocate(mach_task_self(), tself);
-#     else
-      ::rusage ru;
-      ::getrusage(RUSAGE_THREAD, &ru);
-      m.usr = to_usec(ru.ru_utime);
-      m.sys = to_usec(ru.ru_stime);
-      m.mem = ru.ru_maxrss;
-#     endif // CAF_MACOS
-      return m;
-    }
-
-    measurement& operator+=(const measurement& other) {
-      runtime += other.runtime;
-      usr += other.usr;
-      sys += other.sys;
-      mem += other.mem;
-      return *this;
-    }
-
-    measurement& operator-=(const measurement& other) {
-      runtime -= other.runtime;
-      usr -= other.usr;
-      sys -= other.sys;
-      mem -= other.mem;
-      return *this;
-    }
-
-    friend measurement operator+(const measurement& x, const measurement& y) {
-      measurement tmp(x);
-      tmp += y;
-      return tmp;
-    }
-
-    friend measurement operator-(const measurement& x, const measurement& y) {
-      measurement tmp(x);
-      tmp -= y;
-      return tmp;
-    }
-
-    friend std::ostream& operator<<(std::ostream& out, const measurement& m) {
-      using std::setw;
-      out << setw(15) << m.runtime.count()
-          << setw(15) << m.usr.count()
-          << setw(15) << m.sys.count()
-          << m.mem;
-      return out;
-    }
-
-    usec runtime = usec::zero();
-    usec usr = usec::zero();
-    usec sys = usec::zero();
-    long mem = 0;
+  /// Number of buckets in the mailbox depth histogram, whereas bucket `i`
+  /// counts depths in [2^(i-1), 2^i) and the last bucket counts all
+  /// remaining depths.
+  static constexpr size_t depth_buckets = 16;
+
+  struct stats {
+    uint64_t resumes = 0;
+    uint64_t messages = 0;
+    uint64_t samples = 0;
+    clock_type::duration time = clock_type::duration::zero();
+    std::array<uint64_t, depth_buckets> depth = {{}};
   };
 
+  // only accessed by its worker until the coordinator stops
   struct worker_state {
-    actor_id current;
-    measurement job;
-    measurement worker;
-    clock_type::duration last_flush = clock_type::duration::zero();
+    local_actor* job = nullptr;
+    stats* job_stats = nullptr;
+    size_t dequeued = 0;
+    size_t countdown = 0;
+    bool measuring = false;
+    clock_type::time_point start;
+    clock_type::time_point last_flush;
+    stats worker;
+    std::unordered_map<actor_id, stats> actors;
+    // avoids false sharing between workers
+    char pad[CAF_CACHE_LINE_SIZE];
   };
 
   profiled_coordinator(const std::string& filename,
                        msec res = msec{1000},
                        size_t nw = std::max(std::thread::hardware_concurrency(),
                                             4u),
-                       size_t mt = std::numeric_limits<size_t>::max())
+                       size_t mt = std::numeric_limits<size_t>::max(),
+                       size_t sample_interval = 1)
       : super{nw, mt},
         file_{filename},
         resolution_{res},
+        sample_interval_{sample_interval > 0 ? sample_interval : 1},
         system_start_{std::chrono::system_clock::now()},
-        clock_start_{clock_type::now().time_since_epoch()} {
+        clock_start_{clock_type::now()} {
     if (! file_) {
       throw std::runtime_error{"failed to open CAF profiler file"};
     }
@@ -161,106 +116,125 @@ public:
   void initialize() override {
     super::initialize();
     worker_states_.resize(this->num_workers());
-    using std::setw;
-    file_.flags(std::ios::left);
-    file_ << setw(21) << "clock"     // UNIX timestamp in microseconds
-           << setw(10) << "type"      // "actor" or "worker"
-           << setw(10) << "id"        // ID of the above
-           << setw(15) << "time"      // duration of this sample (cumulative)
-           << setw(15) << "usr"       // time spent in user mode (cumulative)
-           << setw(15) << "sys"       // time spent in kernel model (cumulative)
-           << "mem"                   // used memory (cumulative)
-           << '\n';
+    for (auto& w : worker_states_) {
+      w.last_flush = clock_start_;
+    }
+    file_ << "clock,type,id,worker,resumes,messages,samples,time";
+    for (size_t i = 0; i < depth_buckets; ++i) {
+      file_ << ",depth_" << (i == 0 ? 0 : size_t{1} << (i - 1));
+    }
+    file_ << '\n';
   }
 
   void stop() override {
     CAF_LOG_TRACE("");
     super::stop();
-    auto now = clock_type::now().time_since_epoch();
-    auto wallclock = system_start_ + (now - clock_start_);
+    // all workers are done, i.e., we can safely access their state
+    auto now = clock_type::now();
     for (size_t i = 0; i < worker_states_.size(); ++i) {
-      record(wallclock, "worker", i, worker_states_[i].worker);
+      flush(i, now);
     }
+    file_.flush();
   }
 
-  void start_measuring(size_t worker, actor_id job) {
+  void start_measuring(size_t worker, resumable* job) {
     auto& w = worker_states_[worker];
-    w.current = job;
-    w.job = measurement::take();
+    w.job = dynamic_cast<local_actor*>(job);
+    if (w.job) {
+      // references to elements of an unordered map remain valid on rehash
+      w.job_stats = &w.actors[w.job->id()];
+      w.dequeued = w.job->mailbox().dequeued();
+    }
+    w.measuring = w.countdown == 0;
+    if (! w.measuring) {
+      --w.countdown;
+      return;
+    }
+    w.countdown = sample_interval_ - 1;
+    if (w.job) {
+      auto depth = w.job->mailbox().size();
+      ++w.job_stats->depth[depth_bucket(depth)];
+    }
+    w.start = clock_type::now();
   }
 
-  void stop_measuring(size_t worker, actor_id job) {
-    auto m = measurement::take();
+  void stop_measuring(size_t worker, resumable*) {
     auto& w = worker_states_[worker];
-    CAF_ASSERT(job == w.current);
-    auto delta = m - w.job;
-    // It's not possible that the wallclock timer is less than actual CPU time
-    // spent. Due to resolution mismatches of the C++ high-resolution clock and
-    // the system timers, this may appear to be the case sometimes. We "fix"
-    // this by adjusting the wallclock to the sum of user and system time, so
-    // that utilization never exceeds 100%.
-    if (delta.runtime < delta.usr + delta.sys) {
-      delta.runtime = delta.usr + delta.sys;
+    clock_type::time_point now;
+    auto delta = clock_type::duration::zero();
+    if (w.measuring) {
+      now = clock_type::now();
+      delta = now - w.start;
+      w.worker.time += delta;
+      ++w.worker.samples;
+    }
+    ++w.worker.resumes;
+    if (w.job) {
+      auto& x = *w.job_stats;
+      ++x.resumes;
+      auto messages = w.job->mailbox().dequeued() - w.dequeued;
+      x.messages += messages;
+      w.worker.messages += messages;
+      if (w.measuring) {
+        x.time += delta;
+        ++x.samples;
+      }
+      w.job = nullptr;
+      w.job_stats = nullptr;
     }
-    w.worker += delta;
-    report(job, delta);
-    if (m.runtime - w.last_flush >= resolution_) {
-      w.last_flush = m.runtime;
-      auto wallclock = system_start_ + (m.runtime - clock_start_);
-      std::lock_guard<std::mutex> file_guard{file_mtx_};
-      record(wallclock, "worker", worker, w.worker);
-      w.worker = {};
+    // checking the clock only when measuring keeps unsampled resumes cheap
+    if (w.measuring && now - w.last_flush >= resolution_) {
+      std::lock_guard<std::mutex> guard{file_mtx_};
+      flush(worker, now);
     }
   }
 
-  void remove_job(actor_id job) {
-    std::lock_guard<std::mutex> job_guard{job_mtx_};
-    auto j = jobs_.find(job);
-    if (j != jobs_.end()) {
-      if (job != 0) {
-        auto now = clock_type::now().time_since_epoch();
-        auto wallclock = system_start_ + (now - clock_start_);
-        std::lock_guard<std::mutex> file_guard{file_mtx_};
-        record(wallclock, "actor", job, j->second);
-      }
-      jobs_.erase(j);
+private:
+  static size_t depth_bucket(size_t depth) {
+    size_t result = 0;
+    while (depth > 0 && result < depth_buckets - 1) {
+      depth >>= 1;
+      ++result;
     }
+    return result;
   }
 
-  template <class Time, class Label>
-  void record(Time t, Label label, size_t id, const measurement& m) {
-    using std::setw;
-    file_ << setw(21) << t.time_since_epoch().count()
-           << setw(10) << label
-           << setw(10) << id
-           << m
-           << '\n';
+  void record(int64_t t, const char* type, size_t id, size_t worker,
+              const stats& x) {
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    file_ << t << ',' << type << ',' << id << ',' << worker << ','
+          << x.resumes << ',' << x.messages << ',' << x.samples << ','
+          << duration_cast<nanoseconds>(x.time).count();
+    for (auto count : x.depth) {
+      file_ << ',' << count;
+    }
+    file_ << '\n';
   }
 
-  void report(const actor_id& job, const measurement& m) {
-    std::lock_guard<std::mutex> job_guard{job_mtx_};
-    jobs_[job] += m;
-    if (m.runtime - last_flush_ >= resolution_) {
-      last_flush_ = m.runtime;
-      auto now = clock_type::now().time_since_epoch();
-      auto wallclock = system_start_ + (now - clock_start_);
-      std::lock_guard<std::mutex> file_guard{file_mtx_};
-      for (auto& j : jobs_) {
-        record(wallclock, "actor", j.first, j.second);
-        j.second = {};
-      }
+  // writes and resets the state of `worker`
+  void flush(size_t worker, clock_type::time_point now) {
+    using std::chrono::duration_cast;
+    auto& w = worker_states_[worker];
+    auto wallclock = system_start_ + duration_cast<
+                       std::chrono::system_clock::duration>(now - clock_start_);
+    auto t = duration_cast<msec>(wallclock.time_since_epoch()).count();
+    record(t, "worker", worker, worker, w.worker);
+    for (auto& kvp : w.actors) {
+      record(t, "actor", kvp.first, worker, kvp.second);
     }
+    w.worker = stats{};
+    w.actors.clear();
+    w.last_flush = now;
   }
 
-  std::mutex job_mtx_;
   std::mutex file_mtx_;
   std::ofstream file_;
   msec resolution_;
+  size_t sample_interval_;
   std::chrono::system_clock::time_point system_start_;
-  clock_type::duration clock_start_;
+  clock_type::time_point clock_start_;
   std::vector<worker_state> worker_states_;
-  std::unordered_map<actor_id, measurement> jobs_;
-  clock_type::duration last_flush_ = clock_type::duration::zero();
 };
 
 } // namespace scheduler
@@ -113,6 +113,7 @@ public:
 private:
   void run() {
     CAF_LOG_TRACE("worker with ID " << id_);
+    policy_.init_worker_thread(this);
     // scheduling loop
     for (;;) {
       auto job = policy_.dequeue(this);
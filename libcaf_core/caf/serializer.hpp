@@ -29,6 +29,7 @@
 
 namespace caf {
 
+class message;
 class actor_namespace;
 class uniform_type_info;
 
@@ -50,6 +51,14 @@ public:
   /// Ends serialization of an object.
   virtual void end_object() = 0;
 
+  /// Begins serialization of `msg`, which is followed by its elements.
+  /// The default implementation writes `msg` as an object named after
+  /// its element types, e.g., `@<>+@i32+@str`.
+  virtual void begin_message(const message& msg);
+
+  /// Ends serialization of a message.
+  virtual void end_message();
+
   /// Begins serialization of a sequence of size `num`.
   virtual void begin_sequence(size_t num) = 0;
 
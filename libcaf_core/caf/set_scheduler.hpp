@@ -54,6 +54,24 @@ void set_scheduler(size_t nw = std::thread::hardware_concurrency(),
   set_scheduler(new scheduler::coordinator<Policy>(nw, max_throughput));
 }
 
+/// Sets a user-defined scheduler using given policies and the
+/// policy-specific configuration `cfg`, e.g., to tune how long idle workers
+/// of the work-stealing scheduler poll for new jobs before parking.
+/// @note This function must be used before actor is spawned. Dynamically
+///       changing the scheduler at runtime is not supported.
+/// @throws std::logic_error if a scheduler is already defined
+/// @throws std::invalid_argument if `max_throughput == 0`
+template <class Policy = policy::work_stealing>
+void set_scheduler(size_t nw, size_t max_throughput,
+                   const typename Policy::config& cfg) {
+  if (max_throughput == 0) {
+    throw std::invalid_argument("max_throughput must not be 0");
+  }
+  auto ptr = new scheduler::coordinator<Policy>(nw, max_throughput);
+  ptr->data().cfg = cfg;
+  set_scheduler(ptr);
+}
+
 } // namespace caf
 
 #endif // CAF_SET_SCHEDULER_HPP
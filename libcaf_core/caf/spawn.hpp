@@ -60,6 +60,9 @@ intrusive_ptr<C> spawn_impl(execution_unit* host,
   if (has_priority_aware_flag(Os)) {
     ptr->is_priority_aware(true);
   }
+  if (has_bounded_mailbox_flag(Os)) {
+    ptr->bound_mailbox(C::default_mailbox_capacity);
+  }
   if (has_detach_flag(Os) || has_blocking_api_flag(Os)) {
     ptr->is_detached(true);
   }
@@ -37,7 +37,8 @@ enum class spawn_options : int {
   hide_flag = 0x08,
   blocking_api_flag = 0x10,
   priority_aware_flag = 0x20,
-  lazy_init_flag = 0x40
+  lazy_init_flag = 0x40,
+  bounded_mailbox_flag = 0x80
 };
 #endif
 
@@ -79,6 +80,12 @@ constexpr spawn_options priority_aware = spawn_options::priority_aware_flag;
 /// initialization until a message arrives.
 constexpr spawn_options lazy_init = spawn_options::lazy_init_flag;
 
+/// Causes the new actor to bound its mailbox to
+/// `local_actor::default_mailbox_capacity` messages, rejecting
+/// new messages while full. Use `local_actor::bound_mailbox`
+/// to select a different capacity or {@link overflow_policy}.
+constexpr spawn_options bounded_mailbox = spawn_options::bounded_mailbox_flag;
+
 /// Checks wheter `haystack` contains `needle`.
 /// @relates spawn_options
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
@@ -127,6 +134,12 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/// Checks wheter the {@link bounded_mailbox} flag is set in `opts`.
+/// @relates spawn_options
+constexpr bool has_bounded_mailbox_flag(spawn_options opts) {
+  return has_spawn_option(opts, bounded_mailbox);
+}
+
 /// @}
 
 /// @cond PRIVATE
@@ -23,6 +23,7 @@
 #include <map>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <string>
 #include <cstdint>
 #include <typeinfo>
@@ -253,6 +254,11 @@ public:
     return type_nr_;
   }
 
+  /// Returns a 64-bit hash of `name()` that identifies this type on all
+  /// platforms. Binary serializers use this ID for announced types
+  /// instead of writing their name.
+  uint64_t type_id() const;
+
 protected:
   uniform_type_info(uint16_t typenr = 0);
 
@@ -268,6 +274,8 @@ protected:
 
 private:
   uint16_t type_nr_;
+  // computed lazily, since name() is not available in the constructor
+  mutable std::atomic<uint64_t> type_id_;
 };
 
 /// @relates uniform_type_info
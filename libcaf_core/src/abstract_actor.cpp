@@ -22,7 +22,9 @@
 #include <map>
 #include <mutex>
 #include <atomic>
+#include <iterator>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "caf/atom.hpp"
 #include "caf/config.hpp"
@@ -30,6 +32,7 @@
 #include "caf/actor_addr.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/abstract_actor.hpp"
+#include "caf/mailbox_element.hpp"
 #include "caf/system_messages.hpp"
 #include "caf/default_attachable.hpp"
 
@@ -47,6 +50,13 @@ std::atomic<actor_id> ids_;
 
 } // namespace <anonymous>
 
+// monitors and links are stored in one hash map per observe type,
+// allowing supervisors to attach and detach thousands of them in O(1)
+struct abstract_actor::observer_index {
+  using map_type = std::unordered_multimap<actor_addr, attachable_ptr>;
+  map_type maps[2]; // indexed by default_attachable::observe_type
+};
+
 actor_id abstract_actor::latest_actor_id() {
   return ids_.load();
 }
@@ -72,6 +82,10 @@ abstract_actor::abstract_actor()
   // nop
 }
 
+abstract_actor::~abstract_actor() {
+  // nop
+}
+
 void abstract_actor::attach(attachable_ptr ptr) {
   CAF_LOG_TRACE("");
   if (ptr == nullptr) {
@@ -90,31 +104,73 @@ void abstract_actor::attach(attachable_ptr ptr) {
   ptr->actor_exited(this, reason);
 }
 
-size_t abstract_actor::detach_impl(const attachable::token& what,
-                                   attachable_ptr& ptr,
-                                   bool stop_on_hit,
-                                   bool dry_run) {
-  CAF_LOGF_TRACE("");
-  if (! ptr) {
-    CAF_LOGF_DEBUG("invalid ptr");
-    return 0;
+void abstract_actor::attach_impl(attachable_ptr& ptr) {
+  if (ptr->subtype() == attachable::token::observer) {
+    auto& x = static_cast<default_attachable&>(*ptr);
+    auto observer = x.observer();
+    auto type = x.type();
+    if (! observers_) {
+      observers_.reset(new observer_index);
+    }
+    observers_->maps[type].emplace(std::move(observer), std::move(ptr));
+    return;
   }
-  if (ptr->matches(what)) {
+  ptr->next.swap(attachables_head_);
+  attachables_head_.swap(ptr);
+}
+
+size_t abstract_actor::detach_impl(const attachable::token& what,
+                                   bool stop_on_hit, bool dry_run) {
+  CAF_LOG_TRACE("");
+  if (what.subtype == attachable::token::observer) {
+    if (! observers_) {
+      return 0;
+    }
+    using observe_token = default_attachable::observe_token;
+    auto& tk = *reinterpret_cast<const observe_token*>(what.ptr);
+    auto& xs = observers_->maps[tk.type];
+    auto range = xs.equal_range(tk.observer);
+    if (range.first == range.second) {
+      return 0;
+    }
+    if (stop_on_hit) {
+      range.second = std::next(range.first);
+    }
+    auto result = static_cast<size_t>(std::distance(range.first,
+                                                    range.second));
     if (! dry_run) {
-      CAF_LOGF_DEBUG("removed element");
+      CAF_LOG_DEBUG("removed " << result << " element(s)");
+      xs.erase(range.first, range.second);
+    }
+    return result;
+  }
+  size_t result = 0;
+  auto ptr = &attachables_head_;
+  while (*ptr) {
+    if (! (*ptr)->matches(what)) {
+      ptr = &(*ptr)->next;
+      continue;
+    }
+    ++result;
+    if (dry_run) {
+      ptr = &(*ptr)->next;
+    } else {
+      CAF_LOG_DEBUG("removed element");
       attachable_ptr next;
-      next.swap(ptr->next);
-      ptr.swap(next);
+      next.swap((*ptr)->next);
+      ptr->swap(next);
+    }
+    if (stop_on_hit) {
+      break;
     }
-    return stop_on_hit ? 1 : 1 + detach_impl(what, ptr, stop_on_hit, dry_run);
   }
-  return detach_impl(what, ptr->next, stop_on_hit, dry_run);
+  return result;
 }
 
 size_t abstract_actor::detach(const attachable::token& what) {
   CAF_LOG_TRACE("");
   guard_type guard{mtx_};
-  return detach_impl(what, attachables_head_);
+  return detach_impl(what);
 }
 
 void abstract_actor::is_registered(bool value) {
@@ -172,7 +228,7 @@ bool abstract_actor::establish_backlink_impl(const actor_addr& other) {
     guard_type guard{mtx_};
     reason = exit_reason_;
     if (reason == exit_reason::not_exited) {
-      if (detach_impl(tk, attachables_head_, true, true) == 0) {
+      if (detach_impl(tk, true, true) == 0) {
         auto tmp = default_attachable::make_link(other);
         attach_impl(tmp);
         return true;
@@ -197,7 +253,7 @@ bool abstract_actor::remove_link_impl(const actor_addr& other) {
   guard_type guard{mtx_};
   // remove_backlink returns true if this actor is linked to other
   auto ptr = actor_cast<abstract_actor_ptr>(other);
-  if (detach_impl(tk, attachables_head_, true) > 0) {
+  if (detach_impl(tk, true) > 0) {
     // tell remote side to remove link as well
     ptr->remove_backlink(address());
     return true;
@@ -210,7 +266,7 @@ bool abstract_actor::remove_backlink_impl(const actor_addr& other) {
   default_attachable::observe_token tk{other, default_attachable::link};
   if (other && other != this) {
     guard_type guard{mtx_};
-    return detach_impl(tk, attachables_head_, true) > 0;
+    return detach_impl(tk, true) > 0;
   }
   return false;
 }
@@ -224,6 +280,7 @@ void abstract_actor::cleanup(uint32_t reason) {
   CAF_ASSERT(reason != exit_reason::not_exited);
   // move everyhting out of the critical section before processing it
   attachable_ptr head;
+  std::unique_ptr<observer_index> observers;
   { // lifetime scope of guard
     guard_type guard{mtx_};
     if (exit_reason_ != exit_reason::not_exited) {
@@ -232,10 +289,31 @@ void abstract_actor::cleanup(uint32_t reason) {
     }
     exit_reason_ = reason;
     attachables_head_.swap(head);
+    observers_.swap(observers);
   }
   CAF_LOG_INFO_IF(! is_remote(), "cleanup actor with ID " << id_
                                 << "; exit reason = " << reason);
-  // send exit messages
+  // send down and exit messages, sharing one content among all observers
+  if (observers) {
+    auto notify = [&](observer_index::map_type& xs, message msg) {
+      auto i = xs.begin();
+      mailbox_element::make_n(xs.size(), address(),
+                              message_id{}.with_high_priority(), msg,
+                              [&](mailbox_element_ptr ptr) {
+        auto observer = actor_cast<abstract_actor_ptr>((i++)->first);
+        observer->enqueue(std::move(ptr), host_);
+      });
+    };
+    auto& monitors = observers->maps[default_attachable::monitor];
+    if (! monitors.empty()) {
+      notify(monitors, make_message(down_msg{address(), reason}));
+    }
+    auto& links = observers->maps[default_attachable::link];
+    if (! links.empty()) {
+      notify(links, make_message(exit_msg{address(), reason}));
+    }
+  }
+  // run remaining attachables
   for (attachable* i = head.get(); i != nullptr; i = i->next.get()) {
     i->actor_exited(this, reason);
   }
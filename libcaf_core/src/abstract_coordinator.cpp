@@ -52,93 +52,6 @@ namespace scheduler {
 
 namespace {
 
-using hrc = std::chrono::high_resolution_clock;
-
-struct delayed_msg {
-  actor_addr from;
-  channel to;
-  message_id mid;
-  message msg;
-};
-
-inline void deliver(delayed_msg& dm) {
-  dm.to->enqueue(dm.from, dm.mid, std::move(dm.msg), nullptr);
-}
-
-template <class Map, class... Ts>
-inline void insert_dmsg(Map& storage, const duration& d, Ts&&... xs) {
-  auto tout = hrc::now();
-  tout += d;
-  delayed_msg dmsg{std::forward<Ts>(xs)...};
-  storage.emplace(std::move(tout), std::move(dmsg));
-}
-
-class timer_actor : public blocking_actor {
-public:
-  inline mailbox_element_ptr dequeue() {
-    blocking_actor::await_data();
-    return next_message();
-  }
-
-  bool await_data(const hrc::time_point& tp) {
-    if (has_next_message()) {
-      return true;
-    }
-    return mailbox().synchronized_await(mtx_, cv_, tp);
-  }
-
-  mailbox_element_ptr try_dequeue(const hrc::time_point& tp) {
-    if (await_data(tp)) {
-      return next_message();
-    }
-    return mailbox_element_ptr{};
-  }
-
-  void act() override {
-    trap_exit(true);
-    // setup & local variables
-    bool received_exit = false;
-    mailbox_element_ptr msg_ptr;
-    std::multimap<hrc::time_point, delayed_msg> messages;
-    // message handling rules
-    message_handler mfun{
-      [&](const duration& d, actor_addr& from, channel& to,
-          message_id mid, message& msg) {
-         insert_dmsg(messages, d, std::move(from),
-                     std::move(to), mid, std::move(msg));
-      },
-      [&](const exit_msg&) {
-        received_exit = true;
-      },
-      others >> [&] {
-        CAF_LOG_ERROR("unexpected: " << to_string(msg_ptr->msg));
-      }
-    };
-    // loop
-    while (! received_exit) {
-      while (! msg_ptr) {
-        if (messages.empty())
-          msg_ptr = dequeue();
-        else {
-          auto tout = hrc::now();
-          // handle timeouts (send messages)
-          auto it = messages.begin();
-          while (it != messages.end() && (it->first) <= tout) {
-            deliver(it->second);
-            it = messages.erase(it);
-          }
-          // wait for next message or next timeout
-          if (it != messages.end()) {
-            msg_ptr = try_dequeue(it->first);
-          }
-        }
-      }
-      mfun(msg_ptr->msg);
-      msg_ptr.reset();
-    }
-  }
-};
-
 using string_sink = std::function<void (std::string&&)>;
 
 // the first value is the use count, the last ostream_handle that
@@ -326,19 +239,17 @@ abstract_coordinator* abstract_coordinator::create_singleton() {
 void abstract_coordinator::initialize() {
   CAF_LOG_TRACE("");
   // launch utility actors
-  timer_ = spawn<timer_actor, hidden + detached + blocking_api>();
+  timer_.start();
   printer_ = spawn<hidden + detached + blocking_api>(printer_loop);
 }
 
 void abstract_coordinator::stop_actors() {
   CAF_LOG_TRACE("");
+  timer_.stop();
   scoped_actor self{true};
-  self->monitor(timer_);
   self->monitor(printer_);
-  anon_send_exit(timer_, exit_reason::user_shutdown);
   anon_send_exit(printer_, exit_reason::user_shutdown);
-  int i = 0;
-  self->receive_for(i, 2)(
+  self->receive(
     [](const down_msg&) {
       // nop
     }
@@ -54,9 +54,11 @@ namespace {
 void broadcast_dispatch(actor_pool::uplock&, const actor_pool::actor_vec& vec,
                         mailbox_element_ptr& ptr, execution_unit* host) {
   CAF_ASSERT(!vec.empty());
-  for (size_t i = 1; i < vec.size(); ++i) {
-    vec[i]->enqueue(ptr->sender, ptr->mid, ptr->msg, host);
-  }
+  size_t i = 1;
+  mailbox_element::make_n(vec.size() - 1, ptr->sender, ptr->mid, ptr->msg,
+                          [&](mailbox_element_ptr x) {
+    vec[i++]->enqueue(std::move(x), host);
+  });
   vec.front()->enqueue(std::move(ptr), host);
 }
 
@@ -61,9 +61,10 @@ actor_registry::actor_registry() : running_(0) {
 }
 
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
-  shared_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end()) {
+  auto& s = shard_for(key);
+  shared_guard guard(s.mtx);
+  auto i = s.data.find(key);
+  if (i != s.data.end()) {
     return i->second;
   }
   CAF_LOG_DEBUG("key not found, assume the actor no longer exists: " << key);
@@ -75,9 +76,10 @@ void actor_registry::put(actor_id key, const abstract_actor_ptr& val) {
     return;
   }
   { // lifetime scope of guard
-    exclusive_guard guard(instances_mtx_);
-    if (! entries_.emplace(key,
-                           value_type{val, exit_reason::not_exited}).second) {
+    auto& s = shard_for(key);
+    exclusive_guard guard(s.mtx);
+    if (! s.data.emplace(key,
+                         value_type{val, exit_reason::not_exited}).second) {
       // already defined
       return;
     }
@@ -94,9 +96,10 @@ void actor_registry::put(actor_id key, const actor_addr& value) {
 }
 
 void actor_registry::erase(actor_id key, uint32_t reason) {
-  exclusive_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end()) {
+  auto& s = shard_for(key);
+  exclusive_guard guard(s.mtx);
+  auto i = s.data.find(key);
+  if (i != s.data.end()) {
     auto& entry = i->second;
     CAF_LOG_INFO("erased actor with ID " << key << ", reason " << reason);
     entry.first = nullptr;
@@ -42,4 +42,8 @@ bool attachable::matches(const token&) {
   return false;
 }
 
+size_t attachable::subtype() const {
+  return token::anonymous;
+}
+
 } // namespace caf
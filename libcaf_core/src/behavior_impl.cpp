@@ -19,6 +19,11 @@
 
 #include "caf/detail/behavior_impl.hpp"
 
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
 #include "caf/message_handler.hpp"
 
 namespace caf {
@@ -46,8 +51,9 @@ public:
       cases_.push_back(mci);
     for (auto mci : *y)
       cases_.push_back(mci);
-    begin_ = &cases_[0];
+    begin_ = cases_.data();
     end_ = begin_ + cases_.size();
+    init_index();
   }
 
 private:
@@ -58,6 +64,47 @@ private:
 
 } // namespace <anonymous>
 
+// Maps each type token to the positions of all match cases a message with
+// this token can possibly match, i.e., all cases with this token plus all
+// cases with wildcards, in the order of their definition. Messages with an
+// unknown token only visit cases with wildcards.
+struct behavior_impl::dispatch_index {
+  // an open-addressing hash table entry, unused if `first == last`
+  struct slot {
+    uint32_t token;
+    uint32_t first;
+    uint32_t last;
+  };
+
+  using range = std::pair<const uint32_t*, const uint32_t*>;
+
+  std::vector<slot> slots;
+  size_t shift;
+  std::vector<uint32_t> positions;
+  // positions of all cases with wildcards at the front of `positions`
+  uint32_t num_wildcards;
+
+  size_t slot_of(uint32_t token) const {
+    // Fibonacci hashing, uses the high bits of the product
+    return static_cast<uint32_t>(token * 2654435769u) >> shift;
+  }
+
+  range lookup(uint32_t token) const {
+    auto mask = slots.size() - 1;
+    for (auto i = slot_of(token); ; i = (i + 1) & mask) {
+      auto& x = slots[i];
+      if (x.first == x.last) {
+        return {positions.data(), positions.data() + num_wildcards};
+      }
+      if (x.token == token) {
+        return {positions.data() + x.first, positions.data() + x.last};
+      }
+    }
+  }
+};
+
+constexpr size_t behavior_impl::index_threshold;
+
 behavior_impl::~behavior_impl() {
   // nop
 }
@@ -66,9 +113,71 @@ behavior_impl::behavior_impl(duration tout) : timeout_(tout) {
   // nop
 }
 
+void behavior_impl::init_index() {
+  auto n = size();
+  if (n < index_threshold) {
+    return;
+  }
+  std::unique_ptr<dispatch_index> idx{new dispatch_index};
+  auto& positions = idx->positions;
+  std::vector<std::pair<uint32_t, uint32_t>> typed;
+  typed.reserve(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    if (begin_[i].has_wildcard) {
+      positions.push_back(i);
+    } else {
+      typed.emplace_back(begin_[i].type_token, i);
+    }
+  }
+  idx->num_wildcards = static_cast<uint32_t>(positions.size());
+  std::vector<uint32_t> wildcards{positions};
+  // group cases by token, keeping the order of definition within each group
+  std::sort(typed.begin(), typed.end());
+  size_t num_tokens = 0;
+  for (size_t i = 0; i < typed.size(); ++i) {
+    if (i == 0 || typed[i].first != typed[i - 1].first) {
+      ++num_tokens;
+    }
+  }
+  // keep the load factor of the table at or below 50%
+  size_t bits = 1;
+  while ((size_t{1} << bits) < num_tokens * 2) {
+    ++bits;
+  }
+  idx->shift = 32 - bits;
+  idx->slots.resize(size_t{1} << bits, dispatch_index::slot{0, 0, 0});
+  auto mask = idx->slots.size() - 1;
+  std::vector<uint32_t> group;
+  auto i = typed.begin();
+  while (i != typed.end()) {
+    auto token = i->first;
+    group.clear();
+    for (; i != typed.end() && i->first == token; ++i) {
+      group.push_back(i->second);
+    }
+    auto first = static_cast<uint32_t>(positions.size());
+    std::merge(group.begin(), group.end(), wildcards.begin(), wildcards.end(),
+               std::back_inserter(positions));
+    auto j = idx->slot_of(token);
+    while (idx->slots[j].first != idx->slots[j].last) {
+      j = (j + 1) & mask;
+    }
+    idx->slots[j] = dispatch_index::slot{
+      token, first, static_cast<uint32_t>(positions.size())};
+  }
+  index_ = std::move(idx);
+}
+
 bhvr_invoke_result behavior_impl::invoke(message& msg) {
   auto msg_token = msg.type_token();
   bhvr_invoke_result res;
+  if (index_) {
+    auto r = index_->lookup(msg_token);
+    for (auto i = r.first; i != r.second; ++i)
+      if (begin_[*i].ptr->invoke(res, msg) != match_case::no_match)
+        return res;
+    return none;
+  }
   for (auto i = begin_; i != end_; ++i)
     if ((i->has_wildcard || i->type_token == msg_token)
         && i->ptr->invoke(res, msg) != match_case::no_match)
@@ -76,6 +185,16 @@ bhvr_invoke_result behavior_impl::invoke(message& msg) {
   return none;
 }
 
+bool behavior_impl::may_match(uint32_t token) const {
+  if (index_) {
+    auto r = index_->lookup(token);
+    return r.first != r.second;
+  }
+  return std::any_of(begin_, end_, [=](const match_case_info& x) {
+    return x.has_wildcard || x.type_token == token;
+  });
+}
+
 void behavior_impl::handle_timeout() {
   // nop
 }
@@ -29,6 +29,7 @@
 #include "caf/binary_deserializer.hpp"
 
 #include "caf/detail/logging.hpp"
+#include "caf/detail/type_nr.hpp"
 #include "caf/detail/ieee_754.hpp"
 #include "caf/detail/singletons.hpp"
 #include "caf/detail/uniform_type_info_map.hpp"
@@ -223,6 +224,41 @@ void binary_deserializer::end_object() {
   // nop
 }
 
+void binary_deserializer::begin_message(
+    std::vector<const uniform_type_info*>& types) {
+  auto uti_map = detail::singletons::get_uniform_type_info_map();
+  uint32_t size;
+  pos_ = read_range(pos_, end_, size);
+  // each element needs at least two bytes for its type
+  range_check(pos_, end_, size * size_t{2});
+  types.reserve(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    uint16_t nr;
+    pos_ = read_range(pos_, end_, nr);
+    if (nr >= detail::type_nrs) {
+      throw std::runtime_error("received invalid type number");
+    }
+    if (nr) {
+      types.push_back(uti_map->by_type_nr(nr));
+      continue;
+    }
+    uint64_t id;
+    pos_ = read_range(pos_, end_, id);
+    auto uti = uti_map->by_type_id(id);
+    if (! uti) {
+      std::string err = "received type ID ";
+      err += std::to_string(id);
+      err += " but no such type is known";
+      throw std::runtime_error(err);
+    }
+    types.push_back(uti);
+  }
+}
+
+void binary_deserializer::end_message() {
+  // nop
+}
+
 size_t binary_deserializer::begin_sequence() {
   CAF_LOG_TRACE("");
   static_assert(sizeof(size_t) >= sizeof(uint32_t),
@@ -21,6 +21,8 @@
 
 #include "caf/binary_serializer.hpp"
 
+#include "caf/message.hpp"
+
 namespace caf {
 
 class binary_writer : public static_visitor<> {
@@ -108,6 +110,22 @@ void binary_serializer::end_object() {
   // nop
 }
 
+void binary_serializer::begin_message(const message& msg) {
+  binary_writer::write_int(out_, static_cast<uint32_t>(msg.size()));
+  for (size_t i = 0; i < msg.size(); ++i) {
+    auto uti = msg.type_at(i);
+    auto nr = uti->type_nr();
+    binary_writer::write_int(out_, nr);
+    if (! nr) {
+      binary_writer::write_int(out_, uti->type_id());
+    }
+  }
+}
+
+void binary_serializer::end_message() {
+  // nop
+}
+
 void binary_serializer::begin_sequence(size_t list_size) {
   binary_writer::write_int(out_, static_cast<uint32_t>(list_size));
 }
@@ -24,6 +24,8 @@
 #include "caf/detail/singletons.hpp"
 #include "caf/detail/actor_registry.hpp"
 
+#include "caf/scheduler/abstract_coordinator.hpp"
+
 namespace caf {
 
 blocking_actor::blocking_actor() {
@@ -56,10 +58,11 @@ void blocking_actor::dequeue(behavior& bhvr, message_id mid) {
   }
   // requesting an invalid timeout will reset our active timeout
   uint32_t timeout_id = 0;
+  detail::timer_service::handle sync_timeout;
   if (mid == invalid_message_id) {
     timeout_id = request_timeout(bhvr.timeout());
   } else {
-    request_sync_timeout_msg(bhvr.timeout(), mid);
+    sync_timeout = request_sync_timeout_msg(bhvr.timeout(), mid);
   }
   // read incoming messages
   for (;;) {
@@ -69,6 +72,9 @@ void blocking_actor::dequeue(behavior& bhvr, message_id mid) {
       case im_success:
         if (mid == invalid_message_id) {
           reset_timeout(timeout_id);
+        } else if (sync_timeout) {
+          auto sched_cd = detail::singletons::get_scheduling_coordinator();
+          sched_cd->cancel_delayed_send(sync_timeout);
         }
         return;
       case im_skipped:
@@ -73,6 +73,12 @@ uint16_t concatenated_tuple::type_nr_at(size_t pos) const {
   return selected.first->type_nr_at(selected.second);
 }
 
+const uniform_type_info* concatenated_tuple::type_at(size_t pos) const {
+  CAF_ASSERT(pos < size());
+  auto selected = select(pos);
+  return selected.first->type_at(selected.second);
+}
+
 std::pair<message_data*, size_t> concatenated_tuple::select(size_t pos) const {
   auto idx = pos;
   for (auto& m : data_) {
@@ -0,0 +1,201 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include <map>
+#include <tuple>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+#ifdef CAF_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+cpu_distance distance(const cpu_info& x, const cpu_info& y) {
+  if (x.l2 == y.l2 || x.l3 == y.l3) {
+    return cpu_distance::shared_cache;
+  }
+  if (x.node == y.node) {
+    return cpu_distance::same_node;
+  }
+  return cpu_distance::remote;
+}
+
+std::vector<cpu_info> select_worker_cpus(std::vector<cpu_info> topology,
+                                         size_t num_workers) {
+  std::vector<cpu_info> result;
+  if (topology.empty()) {
+    return result;
+  }
+  // rank each CPU among its SMT siblings to place workers on distinct
+  // physical cores before using hyperthreads
+  std::map<std::pair<int, int>, int> siblings;
+  std::vector<std::pair<int, cpu_info>> ranked;
+  for (auto& x : topology) {
+    ranked.emplace_back(siblings[std::make_pair(x.package, x.core)]++, x);
+  }
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [](const std::pair<int, cpu_info>& x,
+                      const std::pair<int, cpu_info>& y) {
+    return std::tie(x.first, x.second.node, x.second.package, x.second.l3,
+                    x.second.l2, x.second.id)
+           < std::tie(y.first, y.second.node, y.second.package, y.second.l3,
+                      y.second.l2, y.second.id);
+  });
+  for (size_t i = 0; i < num_workers; ++i) {
+    result.push_back(ranked[i % ranked.size()].second);
+  }
+  return result;
+}
+
+#ifdef CAF_LINUX
+
+namespace {
+
+const char sysfs_cpu_dir[] = "/sys/devices/system/cpu/";
+const char sysfs_node_dir[] = "/sys/devices/system/node/";
+
+bool read_file(const std::string& path, std::string& storage) {
+  std::ifstream f{path};
+  return static_cast<bool>(std::getline(f, storage));
+}
+
+int read_int(const std::string& path, int fallback) {
+  std::string str;
+  if (! read_file(path, str)) {
+    return fallback;
+  }
+  try {
+    return std::stoi(str);
+  }
+  catch (std::exception&) {
+    return fallback;
+  }
+}
+
+// parses lists such as "0-3,8,10-11"
+std::vector<int> read_cpu_list(const std::string& path) {
+  std::vector<int> result;
+  std::string str;
+  if (! read_file(path, str)) {
+    return result;
+  }
+  size_t pos = 0;
+  while (pos < str.size()) {
+    auto next = str.find(',', pos);
+    if (next == std::string::npos) {
+      next = str.size();
+    }
+    auto range = str.substr(pos, next - pos);
+    pos = next + 1;
+    try {
+      auto dash = range.find('-');
+      auto first = std::stoi(range.substr(0, dash));
+      auto last = dash == std::string::npos
+                  ? first
+                  : std::stoi(range.substr(dash + 1));
+      for (auto i = first; i <= last; ++i) {
+        result.push_back(i);
+      }
+    }
+    catch (std::exception&) {
+      // skip malformed ranges
+    }
+  }
+  return result;
+}
+
+// returns the lowest ID of all CPUs sharing the cache
+// at `level` with `cpu` or `cpu` if the cache is unknown
+int shared_cache_id(int cpu, int level) {
+  auto dir = sysfs_cpu_dir + ("cpu" + std::to_string(cpu)) + "/cache/index";
+  for (int i = 0;; ++i) {
+    auto idx = dir + std::to_string(i) + "/";
+    auto lvl = read_int(idx + "level", -1);
+    if (lvl < 0) {
+      return cpu;
+    }
+    std::string type;
+    if (lvl == level && read_file(idx + "type", type)
+        && type != "Instruction") {
+      auto cpus = read_cpu_list(idx + "shared_cpu_list");
+      return cpus.empty() ? cpu : *std::min_element(cpus.begin(), cpus.end());
+    }
+  }
+}
+
+} // namespace <anonymous>
+
+std::vector<cpu_info> get_cpu_topology() {
+  std::vector<cpu_info> result;
+  auto cpus = read_cpu_list(std::string{sysfs_cpu_dir} + "online");
+  if (cpus.empty()) {
+    return result;
+  }
+  std::map<int, int> nodes;
+  for (auto node : read_cpu_list(std::string{sysfs_node_dir} + "online")) {
+    auto path = sysfs_node_dir + ("node" + std::to_string(node)) + "/cpulist";
+    for (auto cpu : read_cpu_list(path)) {
+      nodes[cpu] = node;
+    }
+  }
+  for (auto cpu : cpus) {
+    auto dir = sysfs_cpu_dir + ("cpu" + std::to_string(cpu)) + "/topology/";
+    cpu_info x;
+    x.id = cpu;
+    x.package = read_int(dir + "physical_package_id", 0);
+    x.core = read_int(dir + "core_id", cpu);
+    auto i = nodes.find(cpu);
+    x.node = i != nodes.end() ? i->second : 0;
+    x.l2 = shared_cache_id(cpu, 2);
+    x.l3 = shared_cache_id(cpu, 3);
+    result.push_back(x);
+  }
+  return result;
+}
+
+bool pin_this_thread(int id) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(id, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpus) == 0;
+}
+
+#else // CAF_LINUX
+
+std::vector<cpu_info> get_cpu_topology() {
+  return {};
+}
+
+bool pin_this_thread(int) {
+  return false;
+}
+
+#endif // CAF_LINUX
+
+} // namespace detail
+} // namespace caf
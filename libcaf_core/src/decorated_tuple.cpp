@@ -71,6 +71,10 @@ uint16_t decorated_tuple::type_nr_at(size_t pos) const {
   return decorated_->type_nr_at(mapping_[pos]);
 }
 
+const uniform_type_info* decorated_tuple::type_at(size_t pos) const {
+  return decorated_->type_at(mapping_[pos]);
+}
+
 decorated_tuple::decorated_tuple(cow_ptr&& d, vector_type&& v)
     : decorated_(std::move(d)),
       mapping_(std::move(v)),
@@ -50,6 +50,10 @@ bool default_attachable::matches(const token& what) {
   return ot.observer == observer_ && ot.type == type_;
 }
 
+size_t default_attachable::subtype() const {
+  return attachable::token::observer;
+}
+
 default_attachable::default_attachable(actor_addr observer, observe_type type)
     : observer_(std::move(observer)),
       type_(type) {
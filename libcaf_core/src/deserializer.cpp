@@ -19,6 +19,13 @@
 
 #include "caf/deserializer.hpp"
 
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "caf/string_algorithms.hpp"
+#include "caf/uniform_type_info.hpp"
+
 namespace caf {
 
 deserializer::deserializer(actor_namespace* ns) : namespace_{ns} {
@@ -29,4 +36,24 @@ deserializer::~deserializer() {
   // nop
 }
 
+void deserializer::begin_message(std::vector<const uniform_type_info*>& types) {
+  auto uti = begin_object();
+  std::vector<std::string> elements;
+  split(elements, uti->name(), is_any_of("+"));
+  if (elements.empty() || elements.front() != "@<>") {
+    std::string err = "expected a message but got an object of type \"";
+    err += uti->name();
+    err += "\"";
+    throw std::runtime_error(err);
+  }
+  // ignore first element, because it's always "@<>"
+  for (size_t i = 1; i < elements.size(); ++i) {
+    types.push_back(uniform_type_info::from(elements[i]));
+  }
+}
+
+void deserializer::end_message() {
+  end_object();
+}
+
 } // namespace caf
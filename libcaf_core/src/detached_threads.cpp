@@ -20,7 +20,9 @@
 #include "caf/scheduler/detached_threads.hpp"
 
 #include <mutex>
+#include <deque>
 #include <atomic>
+#include <thread>
 #include <condition_variable>
 
 namespace caf {
@@ -32,8 +34,52 @@ std::atomic<size_t> s_detached;
 std::mutex s_detached_mtx;
 std::condition_variable s_detached_cv;
 
-} // namespace <anonymous>
+// state of the thread pool, guarded by s_pool_mtx
+std::mutex s_pool_mtx;
+std::condition_variable s_pool_cv;
+std::condition_variable s_pool_done_cv;
+std::deque<std::function<void ()>> s_pool_jobs;
+size_t s_pool_threads = 0;
+size_t s_pool_idle = 0;
+bool s_pool_shutdown = false;
+size_t s_pool_max_idle = 64;
+std::chrono::milliseconds s_pool_idle_timeout{10000};
+
+// returns the next job for an idle thread or an empty function
+// if the thread shall terminate, i.e., on timeout or shutdown
+std::function<void ()> next_detached_job(std::unique_lock<std::mutex>& guard) {
+  std::function<void ()> result;
+  if (s_pool_shutdown || s_pool_idle >= s_pool_max_idle)
+    return result;
+  ++s_pool_idle;
+  auto timeout = std::chrono::steady_clock::now() + s_pool_idle_timeout;
+  while (s_pool_jobs.empty() && ! s_pool_shutdown)
+    if (s_pool_cv.wait_until(guard, timeout) == std::cv_status::timeout)
+      break;
+  --s_pool_idle;
+  // check for new jobs first, since run_detached relies on idle
+  // threads to pick up all jobs it enqueued
+  if (! s_pool_jobs.empty()) {
+    result = std::move(s_pool_jobs.front());
+    s_pool_jobs.pop_front();
+  }
+  return result;
+}
 
+void detached_thread_loop(std::function<void ()> f) {
+  while (f) {
+    f();
+    f = nullptr;
+    std::unique_lock<std::mutex> guard{s_pool_mtx};
+    f = next_detached_job(guard);
+    if (! f) {
+      --s_pool_threads;
+      s_pool_done_cv.notify_all();
+    }
+  }
+}
+
+} // namespace <anonymous>
 
 void inc_detached_threads() {
   ++s_detached;
@@ -48,10 +94,46 @@ void dec_detached_threads() {
 }
 
 void await_detached_threads() {
-  std::unique_lock<std::mutex> guard{s_detached_mtx};
-  while (s_detached != 0) {
-    s_detached_cv.wait(guard);
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{s_detached_mtx};
+    while (s_detached != 0) {
+      s_detached_cv.wait(guard);
+    }
   }
+  // stop all idle threads and allow restarting the pool afterwards
+  std::unique_lock<std::mutex> guard{s_pool_mtx};
+  s_pool_shutdown = true;
+  s_pool_cv.notify_all();
+  while (s_pool_threads != 0) {
+    s_pool_done_cv.wait(guard);
+  }
+  s_pool_shutdown = false;
+}
+
+void run_detached(std::function<void ()> f) {
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{s_pool_mtx};
+    // each idle thread picks up at most one job
+    if (s_pool_idle > s_pool_jobs.size()) {
+      s_pool_jobs.push_back(std::move(f));
+      s_pool_cv.notify_one();
+      return;
+    }
+    ++s_pool_threads;
+  }
+  std::thread{detached_thread_loop, std::move(f)}.detach();
+}
+
+void set_detached_pool_limits(size_t max_idle,
+                              std::chrono::milliseconds idle_timeout) {
+  std::unique_lock<std::mutex> guard{s_pool_mtx};
+  s_pool_max_idle = max_idle;
+  s_pool_idle_timeout = idle_timeout;
+}
+
+size_t idle_detached_threads() {
+  std::unique_lock<std::mutex> guard{s_pool_mtx};
+  return s_pool_idle;
 }
 
 } // namespace scheduler
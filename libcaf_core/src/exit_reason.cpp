@@ -31,12 +31,13 @@ constexpr const char* s_names_table[] = {
   "unhandled_sync_failure",
   "-invalid-",
   "unknown",
-  "out_of_workers"
+  "out_of_workers",
+  "mailbox_overflow"
 };
 } // namespace <anonymous>
 
 const char* as_string(uint32_t value) {
-  if (value <= out_of_workers) {
+  if (value <= mailbox_overflow) {
     return s_names_table[value];
   }
   switch (value) {
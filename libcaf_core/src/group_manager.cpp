@@ -19,6 +19,9 @@
 
 #include <set>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include <sstream>
 #include <stdexcept>
 #include <condition_variable>
@@ -41,7 +44,6 @@ namespace detail {
 namespace {
 
 using exclusive_guard = unique_lock<detail::shared_spinlock>;
-using shared_guard = shared_lock<detail::shared_spinlock>;
 using upgrade_guard = upgrade_lock<detail::shared_spinlock>;
 using upgrade_to_unique_guard = upgrade_to_unique_lock<detail::shared_spinlock>;
 
@@ -73,15 +75,20 @@ void await_all_locals_down(std::initializer_list<actor> xs) {
 
 class local_group : public abstract_group {
 public:
+  using subscriber_vector = std::vector<actor_addr>;
+
+  using subscriber_snapshot = std::shared_ptr<const subscriber_vector>;
+
   void send_all_subscribers(const actor_addr& sender, const message& msg,
                             execution_unit* host) {
     CAF_LOG_TRACE(CAF_TARG(sender, to_string) << ", "
                   << CAF_TARG(msg, to_string));
-    shared_guard guard(mtx_);
-    for (auto& s : subscribers_) {
-      actor_cast<abstract_actor_ptr>(s)->enqueue(sender, invalid_message_id,
-                                                 msg, host);
-    }
+    auto xs = subscribers();
+    auto i = xs->begin();
+    mailbox_element::make_n(xs->size(), sender, invalid_message_id, msg,
+                            [&](mailbox_element_ptr ptr) {
+      (*i++)->enqueue(std::move(ptr), host);
+    });
   }
 
   void enqueue(const actor_addr& sender, message_id, message msg,
@@ -89,13 +96,16 @@ public:
     CAF_LOG_TRACE(CAF_TARG(sender, to_string) << ", "
                   << CAF_TARG(msg, to_string));
     send_all_subscribers(sender, msg, host);
-    broker_->enqueue(sender, invalid_message_id, msg, host);
+    // skip the extra hop if no other node joined this group
+    if (remote_acquaintances_ > 0)
+      broker_->enqueue(sender, invalid_message_id, msg, host);
   }
 
   std::pair<bool, size_t> add_subscriber(const actor_addr& who) {
     CAF_LOG_TRACE(CAF_TSARG(who));
-    exclusive_guard guard(mtx_);
+    std::unique_lock<std::mutex> guard(mtx_);
     if (who && subscribers_.insert(who).second) {
+      invalidate_snapshot();
       return {true, subscribers_.size()};
     }
     return {false, subscribers_.size()};
@@ -103,11 +113,36 @@ public:
 
   std::pair<bool, size_t> erase_subscriber(const actor_addr& who) {
     CAF_LOG_TRACE(""); // serializing who would cause a deadlock
-    exclusive_guard guard(mtx_);
+    std::unique_lock<std::mutex> guard(mtx_);
     auto success = subscribers_.erase(who) > 0;
+    if (success)
+      invalidate_snapshot();
     return {success, subscribers_.size()};
   }
 
+  // returns an immutable snapshot of all subscribers for lock-free
+  // iteration; membership changes only discard the current snapshot
+  // and the next call rebuilds it, i.e., a burst of changes results
+  // in a single copy of subscribers_
+  subscriber_snapshot subscribers() {
+    auto result = std::atomic_load(&snapshot_);
+    if (result)
+      return result;
+    std::unique_lock<std::mutex> guard(mtx_);
+    // another publisher might have rebuilt the snapshot in the meantime
+    result = std::atomic_load(&snapshot_);
+    if (! result) {
+      result = std::make_shared<const subscriber_vector>(subscribers_.begin(),
+                                                         subscribers_.end());
+      std::atomic_store(&snapshot_, result);
+    }
+    return result;
+  }
+
+  void set_remote_acquaintances(size_t x) {
+    remote_acquaintances_ = x;
+  }
+
   bool subscribe(const actor_addr& who) override {
     CAF_LOG_TRACE(""); // serializing who would cause a deadlock
     if (add_subscriber(who).first)
@@ -138,8 +173,19 @@ public:
   ~local_group();
 
 protected:
-  detail::shared_spinlock mtx_;
+  // requires mtx_ to be locked
+  void invalidate_snapshot() {
+    std::atomic_store(&snapshot_, subscriber_snapshot{});
+  }
+
+  // guards subscribers_ and serializes rebuilding snapshot_
+  std::mutex mtx_;
   std::set<actor_addr> subscribers_;
+  // read via atomic_load, set to nullptr whenever subscribers_ changes
+  subscriber_snapshot snapshot_;
+  // number of actors on other nodes forwarding messages to their
+  // local subscribers, maintained by local_broker
+  std::atomic<size_t> remote_acquaintances_;
   actor broker_;
 };
 
@@ -162,12 +208,14 @@ public:
         CAF_LOG_TRACE(CAF_TSARG(other));
         if (other && acquaintances_.insert(other).second) {
           monitor(other);
+          group_->set_remote_acquaintances(acquaintances_.size());
         }
       },
       [=](leave_atom, const actor& other) {
         CAF_LOG_TRACE(CAF_TSARG(other));
         if (other && acquaintances_.erase(other) > 0) {
           demonitor(other);
+          group_->set_remote_acquaintances(acquaintances_.size());
         }
       },
       [=](forward_atom, const message& what) {
@@ -188,6 +236,7 @@ public:
           });
           if (i != last) {
             acquaintances_.erase(i);
+            group_->set_remote_acquaintances(acquaintances_.size());
           }
         }
       },
@@ -206,9 +255,12 @@ private:
     CAF_LOG_DEBUG("forward message to " << acquaintances_.size()
                   << " acquaintances; " << CAF_TSARG(sender) << ", "
                   << CAF_TSARG(what));
-    for (auto& acquaintance : acquaintances_) {
-      acquaintance->enqueue(sender, invalid_message_id, what, host());
-    }
+    auto i = acquaintances_.begin();
+    mailbox_element::make_n(acquaintances_.size(), sender,
+                            invalid_message_id, what,
+                            [&](mailbox_element_ptr ptr) {
+      (*i++)->enqueue(std::move(ptr), host());
+    });
   }
 
   local_group_ptr group_;
@@ -407,7 +459,8 @@ private:
 
 local_group::local_group(bool do_spawn, local_group_module* mod,
                          std::string id, const node_id& nid)
-    : abstract_group(mod, std::move(id), nid) {
+    : abstract_group(mod, std::move(id), nid),
+      remote_acquaintances_(0) {
   if (do_spawn) {
     broker_ = spawn<local_broker, hidden>(this);
   }
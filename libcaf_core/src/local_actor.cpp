@@ -21,6 +21,7 @@
 
 #include "caf/all.hpp"
 #include "caf/atom.hpp"
+#include "caf/metrics.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/default_attachable.hpp"
@@ -37,7 +38,9 @@ namespace caf {
 // e.g., when calling address() in the ctor of a derived class
 local_actor::local_actor()
     : planned_exit_reason_(exit_reason::not_exited),
-      timeout_id_(0) {
+      timeout_id_(0),
+      mailbox_capacity_(0),
+      overflow_policy_(overflow_policy::reject) {
   // nop
 }
 
@@ -112,30 +115,44 @@ uint32_t local_actor::request_timeout(const duration& d) {
     has_timeout(false);
     return 0;
   }
+  // the previous timeout becomes obsolete
+  cancel_timeout();
   has_timeout(true);
   auto result = ++timeout_id_;
-  auto msg = make_message(timeout_msg{++timeout_id_});
+  auto msg = make_message(timeout_msg{result});
   CAF_LOG_TRACE("send new timeout_msg, " << CAF_ARG(timeout_id_));
   if (d.is_zero()) {
     // immediately enqueue timeout message if duration == 0s
     enqueue(address(), invalid_message_id, std::move(msg), host());
   } else {
-    delayed_send(this, d, std::move(msg));
+    timeout_handle_ = delayed_send_impl(invalid_message_id, this, d,
+                                        std::move(msg));
   }
   return result;
 }
 
-void local_actor::request_sync_timeout_msg(const duration& d, message_id mid) {
+detail::timer_service::handle
+local_actor::request_sync_timeout_msg(const duration& d, message_id mid) {
   if (! d.valid()) {
-    return;
+    return nullptr;
+  }
+  return delayed_send_impl(mid, this, d, make_message(sync_timeout_msg{}));
+}
+
+void local_actor::cancel_timeout() {
+  if (timeout_handle_) {
+    auto sched_cd = detail::singletons::get_scheduling_coordinator();
+    sched_cd->cancel_delayed_send(timeout_handle_);
+    timeout_handle_.reset();
   }
-  delayed_send_impl(mid, this, d, make_message(sync_timeout_msg{}));
 }
 
 void local_actor::handle_timeout(behavior& bhvr, uint32_t timeout_id) {
   if (! is_active_timeout(timeout_id)) {
     return;
   }
+  // the timeout message has been delivered, nothing left to cancel
+  timeout_handle_.reset();
   bhvr.handle_timeout();
   if (bhvr_stack_.empty() || bhvr_stack_.back() != bhvr) {
     return;
@@ -151,6 +168,7 @@ void local_actor::handle_timeout(behavior& bhvr, uint32_t timeout_id) {
 void local_actor::reset_timeout(uint32_t timeout_id) {
   if (is_active_timeout(timeout_id)) {
     has_timeout(false);
+    cancel_timeout();
   }
 }
 
@@ -468,30 +486,20 @@ invoke_message_result local_actor::invoke_message(mailbox_element_ptr& ptr,
   CAF_CRITICAL("invalid message type");
 }
 
-struct pending_response_predicate {
-public:
-  explicit pending_response_predicate(message_id mid) : mid_(mid) {
-    // nop
-  }
-
-  bool operator()(const local_actor::pending_response& pr) const {
-    return std::get<0>(pr) == mid_;
-  }
-
-private:
-  message_id mid_;
-};
-
 message_id local_actor::new_request_id(message_priority mp) {
   auto result = ++last_request_id_;
-  pending_responses_.emplace_front(result.response_id(), behavior{});
+  pending_responses_.emplace(result.response_id(), behavior{});
   return mp == message_priority::normal ? result : result.with_high_priority();
 }
 
 void local_actor::mark_arrived(message_id mid) {
   CAF_ASSERT(mid.is_response());
-  pending_response_predicate predicate{mid};
-  pending_responses_.remove_if(predicate);
+  pending_responses_.erase(mid);
+  // drop leftovers such as a timeout for a request we already got
+  // a response for, since invoke_message would drop them anyway
+  detail::mailbox_cache_index::entry x;
+  while (cache_index_.take_response(mid, x))
+    mailbox().cache().erase(mailbox_type::cache_type::iterator{x.ptr});
 }
 
 bool local_actor::awaits_response() const {
@@ -500,20 +508,16 @@ bool local_actor::awaits_response() const {
 
 bool local_actor::awaits(message_id mid) const {
   CAF_ASSERT(mid.is_response());
-  pending_response_predicate predicate{mid};
-  return std::any_of(pending_responses_.begin(), pending_responses_.end(),
-                     predicate);
+  return pending_responses_.find(mid) != nullptr;
 }
 
 optional<local_actor::pending_response&>
 local_actor::find_pending_response(message_id mid) {
-  pending_response_predicate predicate{mid};
-  auto last = pending_responses_.end();
-  auto i = std::find_if(pending_responses_.begin(), last, predicate);
-  if (i == last) {
+  auto ptr = pending_responses_.find(mid);
+  if (! ptr) {
     return none;
   }
-  return *i;
+  return *ptr;
 }
 
 void local_actor::set_response_handler(message_id response_id, behavior bhvr) {
@@ -543,8 +547,8 @@ void local_actor::launch(execution_unit* eu, bool lazy, bool hide) {
     CAF_PUSH_AID(id());
     CAF_LOG_TRACE(CAF_ARG(lazy) << ", " << CAF_ARG(hide));
     scheduler::inc_detached_threads();
-    //intrusive_ptr<local_actor> mself{this};
-    std::thread{[hide](intrusive_ptr<local_actor> mself) {
+    intrusive_ptr<local_actor> mself{this};
+    scheduler::run_detached([mself]() mutable {
       // this extra scope makes sure that the trace logger is
       // destructed before dec_detached_threads() is called
       {
@@ -559,7 +563,7 @@ void local_actor::launch(execution_unit* eu, bool lazy, bool hide) {
         mself.reset();
       }
       scheduler::dec_detached_threads();
-    }, intrusive_ptr<local_actor>{this}}.detach();
+    });
     return;
   }
   // actor is cooperatively scheduled
@@ -581,7 +585,84 @@ void local_actor::enqueue(const actor_addr& sender, message_id mid,
   enqueue(mailbox_element::make(sender, mid, std::move(msg)), eu);
 }
 
+void local_actor::bound_mailbox(size_t capacity, overflow_policy policy) {
+  overflow_policy_.store(policy, std::memory_order_relaxed);
+  mailbox_capacity_.store(capacity, std::memory_order_relaxed);
+}
+
+namespace {
+
+// responses and system messages bypass the mailbox capacity, because
+// dropping them would break response handlers, links, and monitors
+bool is_droppable(const mailbox_element& x) {
+  if (x.mid.is_response())
+    return false;
+  auto& msg = x.msg;
+  if (msg.size() == 1)
+    return ! msg.match_element<exit_msg>(0)
+           && ! msg.match_element<down_msg>(0)
+           && ! msg.match_element<timeout_msg>(0);
+  return msg.empty() || ! msg.match_element<sys_atom>(0);
+}
+
+} // namespace <anonymous>
+
+bool local_actor::handle_overflow(mailbox_element_ptr& ptr,
+                                  execution_unit* eu) {
+  auto capacity = mailbox_capacity();
+  if (capacity == 0 || mailbox().size() < capacity || ! is_droppable(*ptr))
+    return false;
+  switch (mailbox_overflow_policy()) {
+    case overflow_policy::drop_newest:
+      CAF_LOG_DEBUG("mailbox full, drop newest message");
+      ptr.reset();
+      return true;
+    case overflow_policy::reject: {
+      CAF_LOG_DEBUG("mailbox full, reject message");
+      detail::sync_request_bouncer f{exit_reason::mailbox_overflow};
+      f(*ptr);
+      ptr.reset();
+      return true;
+    }
+    case overflow_policy::drop_oldest:
+      // the actor itself drops its oldest messages in shrink_mailbox,
+      // but senders can outpace it; hence, we drop the newest message
+      // as last resort to guarantee an upper bound
+      if (mailbox().size() < 2 * capacity)
+        return false;
+      CAF_LOG_DEBUG("mailbox full, drop newest message");
+      ptr.reset();
+      return true;
+    case overflow_policy::backpressure:
+      // never answer a backpressure signal with another one
+      if (ptr->sender
+          && ! ptr->msg.match_elements<overflow_atom, actor_addr>()) {
+        ptr->sender->enqueue(address(), invalid_message_id,
+                             make_message(overflow_atom::value, address()),
+                             eu);
+      }
+      return false;
+  }
+  return false;
+}
+
+void local_actor::shrink_mailbox() {
+  auto capacity = mailbox_capacity();
+  if (capacity == 0
+      || mailbox_overflow_policy() != overflow_policy::drop_oldest)
+    return;
+  auto nop = [](const mailbox_element&) { };
+  auto dropped = mailbox().shrink(capacity, is_droppable, nop);
+  static_cast<void>(dropped); // keep compiler happy when not logging
+  CAF_LOG_DEBUG_IF(dropped > 0, "mailbox full, dropped " << dropped
+                                << " oldest messages");
+}
+
 void local_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
+  if (handle_overflow(ptr, eu))
+    return;
+  if (metrics::enabled())
+    ptr->enqueued = metrics::timestamp();
   if (is_detached()) {
     // actor lives in its own thread
     auto mid = ptr->mid;
@@ -600,6 +681,7 @@ void local_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   auto sender = ptr->sender;
   switch (mailbox().enqueue(ptr.release())) {
     case detail::enqueue_result::unblocked_reader: {
+      metrics::add(metrics::mailbox_unblocked);
       // re-schedule actor
       if (eu) {
         eu->exec_later(this);
@@ -692,26 +774,62 @@ resumable::resume_result local_actor::resume(execution_unit* eu,
         request_timeout(get_behavior().timeout());
       }
     };
-    for (size_t i = 0; i < max_throughput; ++i) {
-      auto ptr = next_message();
-      if (ptr) {
-        auto res = exec_event(ptr);
-        if (res.first == resumable::resume_result::done)
-          return resumable::resume_result::done;
-        if (res.second == im_success)
-          ++handled_msgs;
+    auto done = false;
+    auto handle = [&](mailbox_element* x) -> bool {
+      mailbox_element_ptr ptr{x};
+      if (metrics::enabled()) {
+        metrics::record(metrics::mailbox_depth, mailbox().size());
+        if (x->enqueued != 0) {
+          uint32_t latency = metrics::timestamp() - x->enqueued;
+          metrics::record(metrics::mailbox_latency_us, latency);
+        }
+      }
+      // drop old messages before running the handler, since
+      // a single chunk from `consume` is possibly unbounded
+      shrink_mailbox();
+      auto res = exec_event(ptr);
+      if (res.first == resumable::resume_result::done) {
+        done = true;
+        return false;
+      }
+      if (res.second == im_success)
+        ++handled_msgs;
+      return true;
+    };
+    // loads the message of the next element while running the current one
+    auto prefetch = [](const mailbox_element& x) {
+      CAF_PREFETCH(x.msg.cvals().get());
+    };
+    for (size_t i = 0; i < max_throughput;) {
+      size_t n;
+      if (is_priority_aware()) {
+        auto ptr = next_message();
+        n = ptr ? 1 : 0;
+        if (ptr)
+          handle(ptr.release());
+      } else {
+        n = mailbox().consume(max_throughput - i, handle, prefetch);
+      }
+      if (done)
+        return resumable::resume_result::done;
+      if (n > 0) {
+        i += n;
       } else {
         CAF_LOG_DEBUG("no more element in mailbox; going to block");
         reset_timeout_if_needed();
         if (mailbox().try_block()) {
+          metrics::add(metrics::mailbox_blocked);
           return resumable::awaiting_message;
         }
         CAF_LOG_DEBUG("try_block() interrupted by new message");
+        ++i;
       }
     }
     reset_timeout_if_needed();
-    if (! has_next_message() && mailbox().try_block())
+    if (! has_next_message() && mailbox().try_block()) {
+      metrics::add(metrics::mailbox_blocked);
       return resumable::awaiting_message;
+    }
     // time's up
     return resumable::resume_later;
   }
@@ -816,6 +934,7 @@ void local_actor::exec_single_event(mailbox_element_ptr& ptr) {
 }
 
 mailbox_element_ptr local_actor::next_message() {
+  shrink_mailbox();
   if (! is_priority_aware()) {
     return mailbox_element_ptr{mailbox().try_pop()};
   }
@@ -856,19 +975,10 @@ bool local_actor::has_next_message() {
 }
 
 void local_actor::push_to_cache(mailbox_element_ptr ptr) {
-  if (! is_priority_aware()) {
-    mailbox().cache().push_second_back(ptr.release());
-    return;
-  }
-  auto high_prio = [](const mailbox_element& val) {
-    return val.is_high_priority();
-  };
-  auto& cache = mailbox().cache();
-  auto e = cache.second_end();
-  auto i = ptr->is_high_priority()
-           ? std::partition_point(cache.second_begin(), e, high_prio)
-           : e;
-  cache.insert(i, ptr.release());
+  // skipped elements remain in the second partition of the cache, which
+  // owns them; `cache_index_` determines the order of invocation
+  cache_index_.push(ptr.get(), is_priority_aware() && ptr->is_high_priority());
+  mailbox().cache().push_second_back(ptr.release());
 }
 
 bool local_actor::invoke_from_cache() {
@@ -876,11 +986,35 @@ bool local_actor::invoke_from_cache() {
 }
 
 bool local_actor::invoke_from_cache(behavior& bhvr, message_id mid) {
+  using cache_type = mailbox_type::cache_type;
   auto& cache = mailbox().cache();
-  auto i = cache.second_begin();
-  auto e = cache.second_end();
-  CAF_LOG_DEBUG(std::distance(i, e) << " elements in cache");
-  return cache.invoke(this, i, e, bhvr, mid);
+  detail::mailbox_cache_index::entry x;
+  // removes `x` from the cache and invokes it; since this function can be
+  // called recursively during invoke_message, we put `x` back only after
+  // invoke_message returned im_skipped
+  auto invoke = [&]() -> invoke_message_result {
+    mailbox_element_ptr tmp{cache.take(cache_type::iterator{x.ptr})};
+    auto res = invoke_message(tmp, bhvr, mid);
+    if (res == im_skipped && tmp) {
+      cache.push_second_back(tmp.release());
+      cache_index_.restore(x);
+    }
+    return res;
+  };
+  if (mid.valid()) {
+    // only the awaited response can match
+    return cache_index_.take_response(mid, x) && invoke() == im_success;
+  }
+  std::vector<detail::mailbox_cache_index::bucket*> xs;
+  cache_index_.candidates(bhvr, xs);
+  CAF_LOG_DEBUG(xs.size() << " candidate buckets in cache");
+  uint64_t min_key = 0;
+  while (cache_index_.take_next(xs, min_key, x)) {
+    min_key = x.key;
+    if (invoke() == im_success)
+      return true;
+  }
+  return false;
 }
 
 void local_actor::do_become(behavior bhvr, bool discard_old) {
@@ -912,10 +1046,12 @@ void local_actor::send_exit(const actor_addr& whom, uint32_t reason) {
        exit_msg{address(), reason});
 }
 
-void local_actor::delayed_send_impl(message_id mid, const channel& dest,
-                                    const duration& rel_time, message msg) {
+detail::timer_service::handle
+local_actor::delayed_send_impl(message_id mid, const channel& dest,
+                               const duration& rel_time, message msg) {
   auto sched_cd = detail::singletons::get_scheduling_coordinator();
-  sched_cd->delayed_send(rel_time, address(), dest, mid, std::move(msg));
+  return sched_cd->delayed_send(rel_time, address(), dest, mid,
+                                std::move(msg));
 }
 
 response_promise local_actor::make_response_promise() {
@@ -966,7 +1102,9 @@ void local_actor::cleanup(uint32_t reason) {
   current_mailbox_element().reset();
   detail::sync_request_bouncer f{reason};
   mailbox_.close(f);
+  cache_index_.clear();
   pending_responses_.clear();
+  cancel_timeout();
   { // lifetime scope of temporary
     actor_addr me = address();
     for (auto& subscription : subscriptions_)
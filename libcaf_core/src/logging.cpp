@@ -18,10 +18,13 @@
  ******************************************************************************/
 
 #include <ctime>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include <cstring>
 #include <fstream>
 #include <algorithm>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "caf/config.hpp"
@@ -29,6 +32,7 @@
 #if defined(CAF_LINUX) || defined(CAF_MACOS)
 #include <unistd.h>
 #include <cxxabi.h>
+#include <pthread.h>
 #include <sys/types.h>
 #endif
 
@@ -39,78 +43,297 @@
 
 #include "caf/detail/logging.hpp"
 #include "caf/detail/get_process_id.hpp"
-#include "caf/detail/single_reader_queue.hpp"
+#include "caf/detail/double_ended_queue.hpp"
 
 namespace caf {
 namespace detail {
 
 namespace {
 
-struct pop_aid_log_event_t {
-  constexpr pop_aid_log_event_t() {
-    // nop
+#ifndef CAF_LOG_LEVEL
+  constexpr int global_log_level = 0;
+#else
+  constexpr int global_log_level = CAF_LOG_LEVEL;
+#endif
+
+const char* log_level_table[] = {"ERROR", "WARN ", "INFO ", "DEBUG", "TRACE"};
+
+// a log statement as written by the calling thread, formatting happens
+// in the writer thread; fills exactly four cache lines
+struct log_record {
+  static constexpr size_t inline_size = 256 - 2 * sizeof(const char*)
+                                        - sizeof(int64_t)
+                                        - 2 * sizeof(uint32_t)
+                                        - sizeof(std::string*);
+  const log_call_site* site;
+  const char* class_name;
+  // milliseconds since epoch
+  int64_t timestamp;
+  actor_id aid;
+  uint32_t size;
+  // stores messages exceeding `inline_size`, nullptr otherwise
+  std::string* overflow;
+  char data[inline_size];
+};
+
+// a single-producer, single-consumer ring buffer of log records; the
+// producer is the thread owning this ring, the consumer is the writer
+class log_ring : public ref_counted {
+public:
+  static constexpr size_t capacity = 512;
+
+  static_assert((capacity & (capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+  explicit log_ring(size_t logger_id)
+      : logger_id_(logger_id),
+        closed_(false),
+        head_(0),
+        tail_(0) {
+    std::ostringstream oss;
+    oss << std::this_thread::get_id();
+    thread_id_ = oss.str();
+  }
+
+  ~log_ring() {
+    // release messages nobody consumed
+    consume([](log_record&) {
+      // nop
+    });
+  }
+
+  // returns a free slot or nullptr if the ring is full,
+  // called only by the owning thread
+  log_record* reserve() {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity)
+      return nullptr;
+    return &records_[tail & (capacity - 1)];
+  }
+
+  // publishes the slot returned by the last call to `reserve`,
+  // called only by the owning thread
+  void commit() {
+    tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_release);
+  }
+
+  // calls `f` for each record and returns the number of consumed records,
+  // called only by the writer
+  template <class F>
+  size_t consume(F f) {
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_acquire);
+    for (auto i = head; i != tail; ++i) {
+      auto& x = records_[i & (capacity - 1)];
+      f(x);
+      delete x.overflow;
+      x.overflow = nullptr;
+    }
+    head_.store(tail, std::memory_order_release);
+    return tail - head;
+  }
+
+  size_t logger_id() const {
+    return logger_id_;
+  }
+
+  const std::string& thread_id() const {
+    return thread_id_;
+  }
+
+  // marks this ring as abandoned by its owner
+  void close() {
+    closed_ = true;
+  }
+
+  bool closed() const {
+    return closed_;
   }
+
+private:
+  size_t logger_id_;
+  std::string thread_id_;
+  std::atomic<bool> closed_;
+  // read position, written by the consumer
+  std::atomic<size_t> head_;
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  // write position, written by the producer
+  std::atomic<size_t> tail_;
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  log_record records_[capacity];
 };
 
-constexpr auto pop_aid_log_event = pop_aid_log_event_t{};
+using log_ring_ptr = intrusive_ptr<log_ring>;
 
-struct log_event {
-  log_event* next;
-  log_event* prev;
-  std::string msg;
-  explicit log_event(std::string logmsg = "")
-      : next(nullptr),
-        prev(nullptr),
-        msg(std::move(logmsg)) {
+// logging state of a single thread
+struct thread_state {
+  thread_state() : aid(0) {
     // nop
   }
+
+  ~thread_state() {
+    if (ring)
+      ring->close();
+  }
+
+  actor_id aid;
+  log_ring_ptr ring;
 };
 
-#ifndef CAF_LOG_LEVEL
-  constexpr int global_log_level = 0;
-#else
-  constexpr int global_log_level = CAF_LOG_LEVEL;
+#if defined(CAF_CLANG) || defined(CAF_MACOS)
+
+pthread_key_t s_key;
+pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+
+void thread_state_destructor(void* ptr) {
+  delete reinterpret_cast<thread_state*>(ptr);
+}
+
+void make_thread_state_key() {
+  pthread_key_create(&s_key, thread_state_destructor);
+}
+
+thread_state& local_state() {
+  pthread_once(&s_key_once, make_thread_state_key);
+  auto res = reinterpret_cast<thread_state*>(pthread_getspecific(s_key));
+  if (! res) {
+    res = new thread_state;
+    pthread_setspecific(s_key, res);
+  }
+  return *res;
+}
+
+#else // !CAF_CLANG && !CAF_MACOS
+
+thread_local thread_state s_state;
+
+thread_state& local_state() {
+  return s_state;
+}
+
 #endif
 
+// hands out a unique ID for each logger instance, since a logger can be
+// re-created after shutdown while threads still hold rings of the old one
+std::atomic<size_t> s_logger_ids;
+
 class logging_impl : public logging {
 public:
+  logging_impl() : id_(++s_logger_ids), running_(true), rings_changed_(false) {
+    // nop
+  }
+
   void initialize() override {
-    const char* log_level_table[] = {"ERROR", "WARN", "INFO", "DEBUG", "TRACE"};
+    static const log_call_site site{CAF_TRACE, "run", __FILE__, __LINE__};
     thread_ = std::thread{[this] { (*this)(); }};
     std::string msg = "ENTRY log level = ";
     msg += log_level_table[global_log_level];
-    log("TRACE", "logging", "run", __FILE__, __LINE__, msg);
+    log(site, "logging", std::move(msg));
   }
 
   void stop() override {
-    log("TRACE", "logging", "run", __FILE__, __LINE__, "EXIT");
-    // an empty string means: shut down
-    queue_.synchronized_enqueue(queue_mtx_, queue_cv_, new log_event{""});
+    static const log_call_site site{CAF_TRACE, "run", __FILE__, __LINE__};
+    log(site, "logging", "EXIT");
+    { // lifetime scope of guard
+      std::unique_lock<std::mutex> guard{mtx_};
+      running_ = false;
+      cv_.notify_all();
+    }
     thread_.join();
   }
 
   void operator()() {
+    // write to the file in chunks of about this size
+    static constexpr size_t flush_threshold = 64 * 1024;
     std::ostringstream fname;
     fname << "actor_log_" << get_process_id() << "_" << time(0) << ".log";
     std::fstream out(fname.str().c_str(), std::ios::out | std::ios::app);
-    std::unique_ptr<log_event> event;
+    std::string buf;
+    buf.reserve(flush_threshold + 1024);
+    std::vector<log_ring_ptr> rings;
     for (;;) {
-      // make sure we have data to read
-      queue_.synchronized_await(queue_mtx_, queue_cv_);
-      // read & process event
-      event.reset(queue_.try_pop());
-      CAF_ASSERT(event != nullptr);
-      if (event->msg.empty()) {
-        out.close();
-        return;
+      bool done;
+      { // lifetime scope of guard
+        std::unique_lock<std::mutex> guard{mtx_};
+        done = ! running_;
+        if (rings_changed_) {
+          rings_changed_ = false;
+          rings.insert(rings.end(), new_rings_.begin(), new_rings_.end());
+          new_rings_.clear();
+        }
+      }
+      size_t consumed = 0;
+      for (auto& ring : rings) {
+        // check before consuming, since the owner may write
+        // a last record right before closing the ring
+        auto closed = ring->closed();
+        consumed += ring->consume([&](log_record& x) {
+          format(*ring, x, buf);
+          if (buf.size() >= flush_threshold) {
+            out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+            buf.clear();
+          }
+        });
+        if (closed)
+          ring.reset();
+      }
+      rings.erase(std::remove(rings.begin(), rings.end(), nullptr),
+                  rings.end());
+      if (! buf.empty()) {
+        out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        buf.clear();
+      }
+      if (consumed == 0) {
+        if (done)
+          break;
+        out.flush();
+        std::unique_lock<std::mutex> guard{mtx_};
+        if (running_ && ! rings_changed_)
+          cv_.wait_for(guard, std::chrono::milliseconds(10));
       }
-      out << event->msg << std::flush;
     }
+    out.close();
   }
 
-  void log(const char* level, const char* c_class_name,
-           const char* function_name, const char* c_full_file_name,
-           int line_num, const std::string& msg) override {
+  void log(const log_call_site& site, const char* class_name,
+           std::string msg) override {
+    auto& ring = local_state().ring;
+    if (! ring || ring->logger_id() != id_) {
+      ring.reset(new log_ring(id_), false);
+      std::unique_lock<std::mutex> guard{mtx_};
+      new_rings_.push_back(ring);
+      rings_changed_ = true;
+    }
+    auto x = ring->reserve();
+    while (! x) {
+      // wait for the writer to catch up
+      cv_.notify_one();
+      std::this_thread::yield();
+      x = ring->reserve();
+    }
+    auto t0 = std::chrono::system_clock::now().time_since_epoch();
+    x->site = &site;
+    x->class_name = class_name;
+    x->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(t0)
+                   .count();
+    x->aid = local_state().aid;
+    x->size = static_cast<uint32_t>(msg.size());
+    if (msg.size() <= log_record::inline_size) {
+      x->overflow = nullptr;
+      memcpy(x->data, msg.data(), msg.size());
+    } else {
+      x->overflow = new std::string(std::move(msg));
+    }
+    ring->commit();
+  }
+
+private:
+  // returns the demangled and simplified name of `c_class_name`
+  const std::string& class_name(const char* c_class_name) {
+    auto i = class_names_.find(c_class_name);
+    if (i != class_names_.end())
+      return i->second;
 #   if defined(CAF_LINUX) || defined(CAF_MACOS)
     int stat = 0;
     std::unique_ptr<char, decltype(free)*> real_class_name{nullptr, free};
@@ -137,54 +360,75 @@ public:
 #   else
     std::string class_name = c_class_name;
 #   endif
-    std::string file_name;
-    std::string full_file_name = c_full_file_name;
-    auto ri = find(full_file_name.rbegin(), full_file_name.rend(), '/');
-    if (ri != full_file_name.rend()) {
-      auto i = ri.base();
-      if (i == full_file_name.end()) {
-        file_name = std::move(full_file_name);
-      } else {
-        file_name = std::string(i, full_file_name.end());
-      }
-    } else {
-      file_name = std::move(full_file_name);
-    }
-    auto t0 = std::chrono::high_resolution_clock::now().time_since_epoch();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t0).count();
-    //auto tstamp = std::chrono::duration_cast<std::chrono::microseconds>(t0).count();
-    std::ostringstream line;
-    line << ms << " " << level << " "
-         << "actor" << get_aid() << " " << std::this_thread::get_id() << " "
-         << class_name << " " << function_name << " " << file_name << ":"
-         << line_num << " " << msg << std::endl;
-    queue_.synchronized_enqueue(queue_mtx_, queue_cv_,
-                                 new log_event{line.str()});
+    return class_names_.emplace(c_class_name, std::move(class_name))
+           .first->second;
   }
 
-private:
+  // appends a line for `x` to `buf`
+  void format(const log_ring& ring, const log_record& x, std::string& buf) {
+    auto& site = *x.site;
+    auto file_name = strrchr(site.file_name, '/');
+    file_name = file_name ? file_name + 1 : site.file_name;
+    buf += std::to_string(x.timestamp);
+    buf += ' ';
+    buf += log_level_table[site.level];
+    buf += " actor";
+    buf += std::to_string(x.aid);
+    buf += ' ';
+    buf += ring.thread_id();
+    buf += ' ';
+    buf += class_name(x.class_name);
+    buf += ' ';
+    buf += site.function_name;
+    buf += ' ';
+    buf += file_name;
+    buf += ':';
+    buf += std::to_string(site.line_num);
+    buf += ' ';
+    if (x.overflow)
+      buf += *x.overflow;
+    else
+      buf.append(x.data, x.size);
+    buf += '\n';
+  }
+
+  size_t id_;
   std::thread thread_;
-  std::mutex queue_mtx_;
-  std::condition_variable queue_cv_;
-  detail::single_reader_queue<log_event> queue_;
+  // guards running_, rings_changed_, and new_rings_
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  bool running_;
+  bool rings_changed_;
+  std::vector<log_ring_ptr> new_rings_;
+  // accessed only by the writer thread
+  std::unordered_map<const char*, std::string> class_names_;
 };
 
 } // namespace <anonymous>
 
-logging::trace_helper::trace_helper(std::string class_name,
-                                    const char* fun_name, const char* file_name,
-                                    int line_num, const std::string& msg)
-    : class_(std::move(class_name)),
-      fun_name_(fun_name),
-      file_name_(file_name),
-      line_num_(line_num) {
-  singletons::get_logger()->log("TRACE", class_.c_str(), fun_name, file_name,
-                                line_num, "ENTRY " + msg);
+// the compiler removes statements above CAF_LOG_LEVEL, hence the runtime
+// level initially accepts everything
+std::atomic<int> logging::level_{CAF_TRACE};
+
+int logging::level() {
+  return level_.load(std::memory_order_relaxed);
+}
+
+void logging::set_level(int lvl) {
+  level_.store(lvl, std::memory_order_relaxed);
+}
+
+logging::trace_helper::trace_helper(const log_call_site& site,
+                                    const char* class_name, std::string msg)
+    : site_(accepts(CAF_TRACE) ? &site : nullptr),
+      class_(class_name) {
+  if (site_)
+    singletons::get_logger()->log(site, class_name, "ENTRY " + msg);
 }
 
 logging::trace_helper::~trace_helper() {
-  singletons::get_logger()->log("TRACE", class_.c_str(), fun_name_,
-                                file_name_, line_num_, "EXIT");
+  if (site_)
+    singletons::get_logger()->log(*site_, class_, "EXIT");
 }
 
 logging::~logging() {
@@ -197,29 +441,14 @@ logging* logging::create_singleton() {
 
 // returns the actor ID for the current thread
 actor_id logging::get_aid() {
-  shared_lock<detail::shared_spinlock> guard{aids_lock_};
-  auto i = aids_.find(std::this_thread::get_id());
-  if (i != aids_.end()) {
-    return i->second;
-  }
-  return 0;
+  return local_state().aid;
 }
 
 actor_id logging::set_aid(actor_id aid) {
-  auto tid = std::this_thread::get_id();
-  upgrade_lock<detail::shared_spinlock> guard{aids_lock_};
-  auto i = aids_.find(tid);
-  if (i != aids_.end()) {
-    // we modify it despite the shared lock because the elements themselves
-    // are considered thread-local
-    auto res = i->second;
-    i->second = aid;
-    return res;
-  }
-  // upgrade to unique lock and insert new element
-  upgrade_to_unique_lock<detail::shared_spinlock> uguard{guard};
-  aids_.emplace(tid, aid);
-  return 0; // was empty before
+  auto& st = local_state();
+  auto res = st.aid;
+  st.aid = aid;
+  return res;
 }
 
 } // namespace detail
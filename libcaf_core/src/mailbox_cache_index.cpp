@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/mailbox_cache_index.hpp"
+
+#include <algorithm>
+
+#include "caf/behavior.hpp"
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// keys of normal elements start in the upper half of the key space
+constexpr uint64_t normal_key_offset = uint64_t{1} << 63;
+
+struct key_less {
+  bool operator()(const mailbox_cache_index::entry& x, uint64_t y) const {
+    return x.key < y;
+  }
+
+  bool operator()(uint64_t x, const mailbox_cache_index::entry& y) const {
+    return x < y.key;
+  }
+};
+
+} // namespace <anonymous>
+
+mailbox_cache_index::mailbox_cache_index()
+    : next_high_key_(1),
+      next_key_(normal_key_offset) {
+  // nop
+}
+
+void mailbox_cache_index::push(mailbox_element* ptr, bool high_priority) {
+  restore(entry{high_priority ? next_high_key_++ : next_key_++, ptr});
+}
+
+void mailbox_cache_index::restore(const entry& x) {
+  if (x.ptr->mid.is_response()) {
+    responses_.emplace(x.ptr->mid.integer_value(), x);
+    return;
+  }
+  // buckets are sorted by key, new normal elements always go to the back
+  auto& xs = buckets_[x.ptr->msg.type_token()];
+  if (xs.empty() || xs.back().key < x.key)
+    xs.push_back(x);
+  else
+    xs.insert(std::lower_bound(xs.begin(), xs.end(), x.key, key_less{}), x);
+}
+
+bool mailbox_cache_index::take_response(message_id mid, entry& x) {
+  // a response and the timeout for the same request can share an ID
+  auto r = responses_.equal_range(mid.integer_value());
+  if (r.first == r.second)
+    return false;
+  using value_type = decltype(responses_)::value_type;
+  auto i = std::min_element(r.first, r.second,
+                            [](const value_type& lhs, const value_type& rhs) {
+    return lhs.second.key < rhs.second.key;
+  });
+  x = i->second;
+  responses_.erase(i);
+  return true;
+}
+
+void mailbox_cache_index::candidates(const behavior& bhvr,
+                                     std::vector<bucket*>& xs) {
+  auto& impl = bhvr.as_behavior_impl();
+  if (! impl)
+    return;
+  for (auto& kvp : buckets_)
+    if (! kvp.second.empty() && impl->may_match(kvp.first))
+      xs.push_back(&kvp.second);
+}
+
+bool mailbox_cache_index::take_next(const std::vector<bucket*>& xs,
+                                    uint64_t min_key, entry& x) {
+  bucket* min_bucket = nullptr;
+  bucket::iterator min_pos;
+  for (auto b : xs) {
+    auto i = std::upper_bound(b->begin(), b->end(), min_key, key_less{});
+    if (i != b->end() && (! min_bucket || i->key < min_pos->key)) {
+      min_bucket = b;
+      min_pos = i;
+    }
+  }
+  if (! min_bucket)
+    return false;
+  x = *min_pos;
+  min_bucket->erase(min_pos);
+  return true;
+}
+
+void mailbox_cache_index::clear() {
+  buckets_.clear();
+  responses_.clear();
+}
+
+} // namespace detail
+} // namespace caf
@@ -21,10 +21,13 @@
 
 namespace caf {
 
+constexpr size_t mailbox_element::max_batch_size;
+
 mailbox_element::mailbox_element()
     : next(nullptr),
       prev(nullptr),
-      marked(false) {
+      marked(false),
+      enqueued(0) {
   // nop
 }
 
@@ -32,6 +35,7 @@ mailbox_element::mailbox_element(actor_addr arg0, message_id arg1)
     : next(nullptr),
       prev(nullptr),
       marked(false),
+      enqueued(0),
       sender(std::move(arg0)),
       mid(arg1) {
   // nop
@@ -41,6 +45,7 @@ mailbox_element::mailbox_element(actor_addr arg0, message_id arg1, message arg2)
     : next(nullptr),
       prev(nullptr),
       marked(false),
+      enqueued(0),
       sender(std::move(arg0)),
       mid(arg1),
       msg(std::move(arg2)) {
@@ -105,6 +105,17 @@ memory_cache* memory::get_cache_map_entry(const std::type_info* tinf) {
   return nullptr;
 }
 
+memory_cache_stats memory::thread_stats() {
+  memory_cache_stats result{0, 0, 0};
+  for (auto& kvp : get_cache_map()) {
+    auto x = kvp.second->stats();
+    result.live += x.live;
+    result.cached += x.cached;
+    result.remote_freed += x.remote_freed;
+  }
+  return result;
+}
+
 void memory::add_cache_map_entry(const std::type_info* tinf,
                                  memory_cache* instance) {
   auto& cache = get_cache_map();
@@ -23,6 +23,7 @@
 
 #include "caf/serializer.hpp"
 #include "caf/deserializer.hpp"
+#include "caf/message_builder.hpp"
 #include "caf/message_handler.hpp"
 #include "caf/string_algorithms.hpp"
 
@@ -47,30 +48,32 @@ message& message::operator=(message&& other) {
 }
 
 void message::serialize(serializer& sink) const {
-  // ttn can be nullptr even if tuple is not empty (in case of object_array)
-  std::string tname = empty() ? "@<>" : tuple_type_names();
-  auto uti_map = detail::singletons::get_uniform_type_info_map();
-  auto uti = uti_map->by_uniform_name(tname);
-  if (uti == nullptr) {
-    std::string err = "could not get uniform type info for \"";
-    err += tname;
-    err += "\"";
-    CAF_LOGF_ERROR(err);
-    throw std::runtime_error(err);
+  // make sure we can serialize all elements before writing anything
+  for (size_t i = 0; i < size(); ++i) {
+    if (type_at(i) == nullptr) {
+      std::string err = "could not get uniform type info for \"";
+      err += tuple_type_names();
+      err += "\"";
+      CAF_LOGF_ERROR(err);
+      throw std::runtime_error(err);
+    }
   }
-  sink.begin_object(uti);
+  sink.begin_message(*this);
   for (size_t i = 0; i < size(); ++i) {
-    uniform_type_info::from(uniform_name_at(i))->serialize(at(i), &sink);
+    type_at(i)->serialize(at(i), &sink);
   }
-  sink.end_object();
+  sink.end_message();
 }
 
 void message::deserialize(deserializer& source) {
-  auto uti = source.begin_object();
-  auto uval = uti->create();
-  uti->deserialize(uval->val, &source);
-  source.end_object();
-  *this = *reinterpret_cast<message*>(uval->val);
+  std::vector<const uniform_type_info*> types;
+  source.begin_message(types);
+  message_builder mb;
+  for (auto uti : types) {
+    mb.append(uti->deserialize(&source));
+  }
+  source.end_message();
+  *this = mb.to_message();
 }
 
 void message::reset(raw_ptr new_ptr, bool add_ref) {
@@ -100,6 +103,11 @@ const char* message::uniform_name_at(size_t pos) const {
   return vals_->uniform_name_at(pos);
 }
 
+const uniform_type_info* message::type_at(size_t pos) const {
+  CAF_ASSERT(vals_);
+  return vals_->type_at(pos);
+}
+
 bool message::equals(const message& other) const {
   if (empty())
     return other.empty();
@@ -88,6 +88,10 @@ public:
     return elements_[pos]->ti->type_nr();
   }
 
+  const uniform_type_info* type_at(size_t pos) const override {
+    return elements_[pos]->ti;
+  }
+
   uint32_t type_token() const override {
     return type_token_;
   }
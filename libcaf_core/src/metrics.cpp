@@ -0,0 +1,282 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#include "caf/metrics.hpp"
+
+#include <mutex>
+#include <sstream>
+#include <algorithm>
+
+#include "caf/atom.hpp"
+#include "caf/spawn.hpp"
+#include "caf/behavior.hpp"
+#include "caf/spawn_options.hpp"
+#include "caf/event_based_actor.hpp"
+
+#if defined(CAF_CLANG) || defined(CAF_MACOS)
+#include <pthread.h>
+#endif
+
+namespace caf {
+
+constexpr size_t metrics::histogram_buckets;
+
+std::atomic<bool> metrics::enabled_{false};
+
+std::atomic<int64_t> metrics::gauges_[metrics::num_gauges];
+
+namespace {
+
+// metrics of a single thread, written only by the owning thread
+struct thread_cells {
+  thread_cells() {
+    for (auto& x : counters)
+      x = 0;
+    for (auto& x : sums)
+      x = 0;
+    for (auto& xs : buckets)
+      for (auto& x : xs)
+        x = 0;
+  }
+
+  std::atomic<uint64_t> counters[metrics::num_counters];
+  std::atomic<uint64_t> sums[metrics::num_histograms];
+  std::atomic<uint64_t> buckets[metrics::num_histograms]
+                               [metrics::histogram_buckets];
+};
+
+// only the owning thread writes, hence there is no need for an atomic
+// read-modify-write; readers only need to see a consistent value
+inline void inc(std::atomic<uint64_t>& x, uint64_t n) {
+  x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// adds all values of `from` to `to`
+void merge(const thread_cells& from, metrics::snapshot& to) {
+  for (size_t i = 0; i < metrics::num_counters; ++i)
+    to.counters[i] += from.counters[i].load(std::memory_order_relaxed);
+  for (size_t i = 0; i < metrics::num_histograms; ++i) {
+    auto& h = to.histograms[i];
+    h.sum += from.sums[i].load(std::memory_order_relaxed);
+    for (size_t j = 0; j < metrics::histogram_buckets; ++j) {
+      auto n = from.buckets[i][j].load(std::memory_order_relaxed);
+      h.buckets[j] += n;
+      h.count += n;
+    }
+  }
+}
+
+struct cells_registry {
+  std::mutex mtx;
+  std::vector<thread_cells*> active;
+  // accumulated values of terminated threads
+  thread_cells retired;
+};
+
+cells_registry& registry() {
+  // never destroyed, since threads may terminate after static destructors
+  static auto instance = new cells_registry;
+  return *instance;
+}
+
+struct thread_state {
+  thread_state() {
+    auto& r = registry();
+    std::unique_lock<std::mutex> guard{r.mtx};
+    r.active.push_back(&cells);
+  }
+
+  ~thread_state() {
+    auto& r = registry();
+    std::unique_lock<std::mutex> guard{r.mtx};
+    for (size_t i = 0; i < metrics::num_counters; ++i)
+      inc(r.retired.counters[i], cells.counters[i]);
+    for (size_t i = 0; i < metrics::num_histograms; ++i) {
+      inc(r.retired.sums[i], cells.sums[i]);
+      for (size_t j = 0; j < metrics::histogram_buckets; ++j)
+        inc(r.retired.buckets[i][j], cells.buckets[i][j]);
+    }
+    r.active.erase(std::find(r.active.begin(), r.active.end(), &cells));
+  }
+
+  thread_cells cells;
+};
+
+#if defined(CAF_CLANG) || defined(CAF_MACOS)
+
+pthread_key_t s_key;
+pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
+
+void thread_state_destructor(void* ptr) {
+  delete reinterpret_cast<thread_state*>(ptr);
+}
+
+void make_thread_state_key() {
+  pthread_key_create(&s_key, thread_state_destructor);
+}
+
+thread_cells& local_cells() {
+  pthread_once(&s_key_once, make_thread_state_key);
+  auto res = reinterpret_cast<thread_state*>(pthread_getspecific(s_key));
+  if (! res) {
+    res = new thread_state;
+    pthread_setspecific(s_key, res);
+  }
+  return res->cells;
+}
+
+#else // !CAF_CLANG && !CAF_MACOS
+
+thread_local thread_state s_state;
+
+thread_cells& local_cells() {
+  return s_state.cells;
+}
+
+#endif
+
+const char* counter_names[] = {
+  "worker_steals",
+  "worker_idle_ns",
+  "mailbox_blocked",
+  "mailbox_unblocked",
+  "net_read_calls",
+  "net_bytes_read",
+  "net_write_calls",
+  "net_bytes_written"
+};
+
+const char* gauge_names[] = {
+  "pending_timers"
+};
+
+const char* histogram_names[] = {
+  "mailbox_depth",
+  "mailbox_latency_us"
+};
+
+} // namespace <anonymous>
+
+uint64_t metrics::snapshot::histogram::percentile(double p) const {
+  if (count == 0)
+    return 0;
+  auto rank = static_cast<uint64_t>(p * static_cast<double>(count) + 0.5);
+  rank = std::min(std::max(rank, uint64_t{1}), count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank)
+      return lower_bound_of(i);
+  }
+  return lower_bound_of(buckets.size() - 1);
+}
+
+void metrics::enable(bool value) {
+  enabled_ = value;
+}
+
+size_t metrics::bucket_of(uint64_t value) {
+  if (value < 4)
+    return static_cast<size_t>(value);
+  size_t msb = 63;
+  while ((value >> msb) == 0)
+    --msb;
+  auto sub = static_cast<size_t>(value >> (msb - 2)) & 3;
+  return 4 + (msb - 2) * 4 + sub;
+}
+
+uint64_t metrics::lower_bound_of(size_t index) {
+  if (index < 4)
+    return index;
+  auto msb = (index - 4) / 4 + 2;
+  auto sub = (index - 4) % 4;
+  return static_cast<uint64_t>(4 + sub) << (msb - 2);
+}
+
+const char* metrics::name(counter_id x) {
+  return counter_names[x];
+}
+
+const char* metrics::name(gauge_id x) {
+  return gauge_names[x];
+}
+
+const char* metrics::name(histogram_id x) {
+  return histogram_names[x];
+}
+
+metrics::snapshot metrics::take_snapshot() {
+  snapshot result;
+  std::fill_n(result.counters, static_cast<size_t>(num_counters), 0);
+  for (size_t i = 0; i < num_gauges; ++i)
+    result.gauges[i] = gauges_[i].load(std::memory_order_relaxed);
+  for (auto& h : result.histograms) {
+    h.count = 0;
+    h.sum = 0;
+    h.buckets.assign(histogram_buckets, 0);
+  }
+  auto& r = registry();
+  std::unique_lock<std::mutex> guard{r.mtx};
+  merge(r.retired, result);
+  for (auto cells : r.active)
+    merge(*cells, result);
+  return result;
+}
+
+actor metrics::spawn_reporter() {
+  return spawn<hidden>([]() -> behavior {
+    return {
+      [](get_atom) {
+        return take_snapshot();
+      }
+    };
+  });
+}
+
+void metrics::add_impl(counter_id x, uint64_t n) {
+  inc(local_cells().counters[x], n);
+}
+
+void metrics::record_impl(histogram_id x, uint64_t value) {
+  auto& cells = local_cells();
+  inc(cells.sums[x], value);
+  inc(cells.buckets[x][bucket_of(value)], 1);
+}
+
+std::string to_string(const metrics::snapshot& x) {
+  static constexpr double quantiles[] = {0.5, 0.9, 0.99, 1.0};
+  std::ostringstream out;
+  for (size_t i = 0; i < metrics::num_counters; ++i)
+    out << "caf_" << metrics::name(static_cast<metrics::counter_id>(i))
+        << ' ' << x.counters[i] << '\n';
+  for (size_t i = 0; i < metrics::num_gauges; ++i)
+    out << "caf_" << metrics::name(static_cast<metrics::gauge_id>(i))
+        << ' ' << x.gauges[i] << '\n';
+  for (size_t i = 0; i < metrics::num_histograms; ++i) {
+    auto name = metrics::name(static_cast<metrics::histogram_id>(i));
+    auto& h = x.histograms[i];
+    out << "caf_" << name << "_count " << h.count << '\n'
+        << "caf_" << name << "_sum " << h.sum << '\n';
+    for (auto q : quantiles)
+      out << "caf_" << name << "{quantile=\"" << q << "\"} "
+          << h.percentile(q) << '\n';
+  }
+  return out.str();
+}
+
+} // namespace caf
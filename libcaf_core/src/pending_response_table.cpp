@@ -0,0 +1,138 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/pending_response_table.hpp"
+
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// number of slots allocated on the first insertion
+constexpr size_t initial_bits = 4;
+
+} // namespace <anonymous>
+
+pending_response_table::pending_response_table()
+    : shift_(64), size_(0), head_(nullptr) {
+  // nop
+}
+
+pending_response_table::~pending_response_table() {
+  clear();
+}
+
+pending_response_table::value_type&
+pending_response_table::emplace(message_id mid, behavior bhvr) {
+  CAF_ASSERT(find(mid) == nullptr);
+  if ((size_ + 1) * 2 > slots_.size())
+    grow();
+  auto ptr = new node{value_type{mid, std::move(bhvr)}, nullptr, head_};
+  if (head_)
+    head_->prev = ptr;
+  head_ = ptr;
+  insert_slot(ptr);
+  ++size_;
+  return ptr->value;
+}
+
+pending_response_table::value_type*
+pending_response_table::find(message_id mid) const {
+  if (size_ == 0)
+    return nullptr;
+  auto ptr = slots_[find_slot(mid)];
+  return ptr ? &ptr->value : nullptr;
+}
+
+bool pending_response_table::erase(message_id mid) {
+  if (size_ == 0)
+    return false;
+  auto i = find_slot(mid);
+  auto ptr = slots_[i];
+  if (! ptr)
+    return false;
+  // backward shift deletion, moves all entries following `i` in the same
+  // probe sequence up unless they already are at their preferred slot
+  auto mask = slots_.size() - 1;
+  for (auto j = (i + 1) & mask; slots_[j] != nullptr; j = (j + 1) & mask) {
+    auto k = slot_of(slots_[j]->value.first);
+    // move entry `j` to `i` unless `k` lies cyclically in (i, j]
+    if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+      continue;
+    slots_[i] = slots_[j];
+    i = j;
+  }
+  slots_[i] = nullptr;
+  if (ptr->prev)
+    ptr->prev->next = ptr->next;
+  else
+    head_ = ptr->next;
+  if (ptr->next)
+    ptr->next->prev = ptr->prev;
+  delete ptr;
+  --size_;
+  return true;
+}
+
+void pending_response_table::clear() {
+  while (head_) {
+    auto next = head_->next;
+    delete head_;
+    head_ = next;
+  }
+  std::fill(slots_.begin(), slots_.end(), nullptr);
+  size_ = 0;
+}
+
+size_t pending_response_table::slot_of(message_id mid) const {
+  // Fibonacci hashing, uses the high bits of the product
+  return static_cast<size_t>((mid.integer_value() * 11400714819323198485ull)
+                             >> shift_);
+}
+
+size_t pending_response_table::find_slot(message_id mid) const {
+  auto mask = slots_.size() - 1;
+  auto i = slot_of(mid);
+  while (slots_[i] != nullptr && slots_[i]->value.first != mid)
+    i = (i + 1) & mask;
+  return i;
+}
+
+void pending_response_table::insert_slot(node* ptr) {
+  auto mask = slots_.size() - 1;
+  auto i = slot_of(ptr->value.first);
+  while (slots_[i] != nullptr)
+    i = (i + 1) & mask;
+  slots_[i] = ptr;
+}
+
+void pending_response_table::grow() {
+  auto bits = slots_.empty() ? initial_bits : 64 - shift_ + 1;
+  slots_.assign(size_t{1} << bits, nullptr);
+  shift_ = 64 - bits;
+  for (auto ptr = head_; ptr != nullptr; ptr = ptr->next)
+    insert_slot(ptr);
+}
+
+} // namespace detail
+} // namespace caf
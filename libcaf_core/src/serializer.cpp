@@ -18,8 +18,16 @@
  ******************************************************************************/
 
 #include "caf/serializer.hpp"
+
+#include <string>
+#include <stdexcept>
+
+#include "caf/message.hpp"
 #include "caf/uniform_type_info.hpp"
 
+#include "caf/detail/singletons.hpp"
+#include "caf/detail/uniform_type_info_map.hpp"
+
 namespace caf {
 
 serializer::serializer(actor_namespace* ns) : namespace_{ns} {
@@ -30,4 +38,21 @@ serializer::~serializer() {
   // nop
 }
 
+void serializer::begin_message(const message& msg) {
+  std::string tname = msg.empty() ? "@<>" : msg.tuple_type_names();
+  auto uti_map = detail::singletons::get_uniform_type_info_map();
+  auto uti = uti_map->by_uniform_name(tname);
+  if (uti == nullptr) {
+    std::string err = "could not get uniform type info for \"";
+    err += tname;
+    err += "\"";
+    throw std::runtime_error(err);
+  }
+  begin_object(uti);
+}
+
+void serializer::end_message() {
+  end_object();
+}
+
 } // namespace caf
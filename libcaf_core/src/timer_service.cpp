@@ -0,0 +1,189 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_service.hpp"
+
+#include <limits>
+#include <vector>
+
+#include "caf/actor.hpp"
+#include "caf/metrics.hpp"
+#include "caf/abstract_channel.hpp"
+
+#include "caf/detail/logging.hpp"
+
+namespace caf {
+namespace detail {
+
+timer_service::entry::entry(actor_addr x0, channel x1, message_id x2,
+                            message x3)
+    : from(std::move(x0)),
+      to(std::move(x1)),
+      mid(x2),
+      msg(std::move(x3)) {
+  // nop
+}
+
+timer_service::entry::~entry() {
+  // nop
+}
+
+timer_service::timer_service(clock_type::duration resolution)
+    : start_(clock_type::now()),
+      resolution_(resolution),
+      wakeup_tick_(std::numeric_limits<uint64_t>::max()),
+      running_(false) {
+  // nop
+}
+
+timer_service::~timer_service() {
+  stop();
+}
+
+void timer_service::start() {
+  std::unique_lock<std::mutex> guard(mtx_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  thread_ = std::thread{[this] { run(); }};
+}
+
+void timer_service::stop() {
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard(mtx_);
+    if (! running_) {
+      return;
+    }
+    running_ = false;
+    cv_.notify_all();
+  }
+  thread_.join();
+  std::vector<handle> discarded;
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard(mtx_);
+    discarded.reserve(wheel_.size());
+    wheel_.advance(std::numeric_limits<uint64_t>::max(),
+                   [&](timer_wheel::node* ptr) {
+      // adopt the reference of the wheel
+      discarded.emplace_back(static_cast<entry*>(ptr), false);
+    });
+    metrics::set(metrics::pending_timers, 0);
+  }
+}
+
+timer_service::handle timer_service::schedule(const duration& rel_time,
+                                              actor_addr from, channel to,
+                                              message_id mid, message msg) {
+  auto tout = clock_type::now();
+  tout += rel_time;
+  // ref_counted objects start with a reference count of 1
+  handle result{new entry(std::move(from), std::move(to), mid,
+                          std::move(msg)), false};
+  auto tick = tick_of(tout);
+  std::unique_lock<std::mutex> guard(mtx_);
+  // the wheel holds a reference until the entry expires or gets cancelled
+  result->ref();
+  wheel_.insert(result.get(), tick);
+  metrics::set(metrics::pending_timers, static_cast<int64_t>(wheel_.size()));
+  if (result->tick() < wakeup_tick_) {
+    wakeup_tick_ = result->tick();
+    cv_.notify_one();
+  }
+  return result;
+}
+
+bool timer_service::cancel(const handle& hdl) {
+  if (! hdl) {
+    return false;
+  }
+  std::unique_lock<std::mutex> guard(mtx_);
+  if (! wheel_.erase(hdl.get())) {
+    return false;
+  }
+  metrics::set(metrics::pending_timers, static_cast<int64_t>(wheel_.size()));
+  guard.unlock();
+  // release the reference of the wheel
+  hdl->deref();
+  return true;
+}
+
+size_t timer_service::pending() const {
+  std::unique_lock<std::mutex> guard(mtx_);
+  return wheel_.size();
+}
+
+void timer_service::run() {
+  CAF_LOG_TRACE("");
+  std::vector<handle> expired;
+  std::unique_lock<std::mutex> guard(mtx_);
+  while (running_) {
+    // ticks are only complete once the clock has passed them
+    auto now = clock_type::now();
+    auto tick = tick_of(now);
+    if (time_of(tick) > now) {
+      --tick;
+    }
+    wheel_.advance(tick, [&](timer_wheel::node* ptr) {
+      // adopt the reference of the wheel
+      expired.emplace_back(static_cast<entry*>(ptr), false);
+    });
+    if (! expired.empty()) {
+      metrics::set(metrics::pending_timers,
+                   static_cast<int64_t>(wheel_.size()));
+      // deliver messages without holding the lock
+      guard.unlock();
+      for (auto& x : expired) {
+        if (x->to) {
+          x->to->enqueue(x->from, x->mid, std::move(x->msg), nullptr);
+        }
+        // clients may keep their handle around, which must not keep the
+        // receiver alive once the message has been delivered
+        x->to = invalid_actor;
+        x->from = invalid_actor_addr;
+      }
+      expired.clear();
+      guard.lock();
+      continue;
+    }
+    wakeup_tick_ = wheel_.next_tick();
+    if (wakeup_tick_ == std::numeric_limits<uint64_t>::max()) {
+      cv_.wait(guard);
+    } else {
+      cv_.wait_until(guard, time_of(wakeup_tick_));
+    }
+  }
+}
+
+uint64_t timer_service::tick_of(clock_type::time_point tp) const {
+  if (tp <= start_) {
+    return 0;
+  }
+  auto delta = (tp - start_).count();
+  auto res = resolution_.count();
+  return static_cast<uint64_t>((delta + res - 1) / res);
+}
+
+timer_service::clock_type::time_point
+timer_service::time_of(uint64_t tick) const {
+  return start_ + resolution_ * static_cast<clock_type::rep>(tick);
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,138 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/timer_wheel.hpp"
+
+#include <limits>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+constexpr size_t shift_of(size_t level) {
+  return level * timer_wheel::slot_bits;
+}
+
+} // namespace <anonymous>
+
+timer_wheel::timer_wheel(uint64_t now) : now_(now), size_(0) {
+  for (size_t i = 0; i < num_levels; ++i) {
+    level_sizes_[i] = 0;
+    for (auto& sentinel : slots_[i]) {
+      sentinel.prev_ = &sentinel;
+      sentinel.next_ = &sentinel;
+    }
+  }
+}
+
+void timer_wheel::insert(node* ptr, uint64_t tick) {
+  CAF_ASSERT(! ptr->linked());
+  ptr->tick_ = tick > now_ ? tick : now_ + 1;
+  place(ptr);
+}
+
+bool timer_wheel::erase(node* ptr) {
+  if (! ptr->linked()) {
+    return false;
+  }
+  unlink(ptr);
+  return true;
+}
+
+uint64_t timer_wheel::next_tick() const {
+  auto result = std::numeric_limits<uint64_t>::max();
+  if (size_ == 0) {
+    return result;
+  }
+  if (level_sizes_[0] > 0) {
+    for (auto t = now_ + 1; t <= now_ + num_slots; ++t) {
+      auto& sentinel = slots_[0][t & slot_mask];
+      if (sentinel.next_ != &sentinel) {
+        result = t;
+        break;
+      }
+    }
+  }
+  // timers on higher levels move down when the current tick reaches a
+  // multiple of the level's slot size; the lowest non-empty level
+  // always reaches such a boundary first
+  for (size_t level = 1; level < num_levels; ++level) {
+    if (level_sizes_[level] > 0) {
+      auto boundary = ((now_ >> shift_of(level)) + 1) << shift_of(level);
+      return boundary < result ? boundary : result;
+    }
+  }
+  return result;
+}
+
+void timer_wheel::place(node* ptr) {
+  auto tick = ptr->tick_ > now_ ? ptr->tick_ : now_;
+  auto delta = tick - now_;
+  size_t level = 0;
+  while (level < num_levels - 1
+         && delta >= (uint64_t{1} << shift_of(level + 1))) {
+    ++level;
+  }
+  if (delta >= (uint64_t{1} << shift_of(num_levels))) {
+    // out of range, park the timer in the farthest slot and
+    // put it back into the right slot once it moves down
+    tick = now_ + (uint64_t{1} << shift_of(num_levels)) - 1;
+  }
+  auto& sentinel = slots_[level][(tick >> shift_of(level)) & slot_mask];
+  ptr->level_ = level;
+  ptr->prev_ = sentinel.prev_;
+  ptr->next_ = &sentinel;
+  sentinel.prev_->next_ = ptr;
+  sentinel.prev_ = ptr;
+  ++level_sizes_[level];
+  ++size_;
+}
+
+void timer_wheel::unlink(node* ptr) {
+  CAF_ASSERT(ptr->linked());
+  ptr->prev_->next_ = ptr->next_;
+  ptr->next_->prev_ = ptr->prev_;
+  ptr->prev_ = nullptr;
+  ptr->next_ = nullptr;
+  --level_sizes_[ptr->level_];
+  --size_;
+}
+
+void timer_wheel::cascade() {
+  // move timers from the highest level first, since they
+  // may end up in a slot of a lower level that moves down as well
+  for (auto level = num_levels - 1; level > 0; --level) {
+    auto mask = (uint64_t{1} << shift_of(level)) - 1;
+    if ((now_ & mask) != 0 || level_sizes_[level] == 0) {
+      continue;
+    }
+    auto& sentinel = slots_[level][(now_ >> shift_of(level)) & slot_mask];
+    while (sentinel.next_ != &sentinel) {
+      auto ptr = sentinel.next_;
+      unlink(ptr);
+      place(ptr);
+    }
+  }
+}
+
+} // namespace detail
+} // namespace caf
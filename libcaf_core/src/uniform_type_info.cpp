@@ -69,7 +69,9 @@ const uniform_type_info* announce(const std::type_info& ti,
   return uti_map().insert(&ti, std::move(utype));
 }
 
-uniform_type_info::uniform_type_info(uint16_t typenr) : type_nr_(typenr) {
+uniform_type_info::uniform_type_info(uint16_t typenr)
+    : type_nr_(typenr),
+      type_id_(0) {
   // nop
 }
 
@@ -97,6 +99,24 @@ const uniform_type_info* uniform_type_info::from(const std::string& name) {
   return result;
 }
 
+uint64_t uniform_type_info::type_id() const {
+  auto result = type_id_.load(std::memory_order_relaxed);
+  if (result != 0) {
+    return result;
+  }
+  // 64-bit FNV-1a, 0 is reserved for "not computed yet"
+  result = 0xcbf29ce484222325ull;
+  for (auto c = name(); *c != '\0'; ++c) {
+    result ^= static_cast<unsigned char>(*c);
+    result *= 0x100000001b3ull;
+  }
+  if (result == 0) {
+    result = 1;
+  }
+  type_id_.store(result, std::memory_order_relaxed);
+  return result;
+}
+
 uniform_value uniform_type_info::deserialize(deserializer* src) const {
   auto uval = create();
   deserialize(uval->val, src);
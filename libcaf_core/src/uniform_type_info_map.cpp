@@ -26,6 +26,7 @@
 #include <cstring> // memcmp
 #include <algorithm>
 #include <type_traits>
+#include <unordered_map>
 
 #include "caf/locks.hpp"
 
@@ -489,6 +490,12 @@ public:
     return find_rtti(ti);
   }
 
+  pointer by_type_id(uint64_t id) const {
+    shared_lock<detail::shared_spinlock> guard(lock_);
+    auto i = ids_.find(id);
+    return i != ids_.end() ? i->second : nullptr;
+  }
+
   pointer by_uniform_name(const std::string& name) {
     pointer result = find_name(builtin_types_, name);
     if (! result) {
@@ -518,19 +525,20 @@ public:
                               [](pointer lhs, pointer rhs) {
       return strcmp(lhs->name(), rhs->name()) < 0;
     });
-    if (i == e) {
-      user_types_.push_back(enriched_pointer{uti.release(), ti});
-      return user_types_.back();
-    } else {
-      if (strcmp(uti->name(), (*i)->name()) == 0) {
-        // type already known
-        return *i;
-      }
-      // insert after lower bound (vector is always sorted)
-      auto new_pos = std::distance(user_types_.begin(), i);
-      user_types_.insert(i, enriched_pointer{uti.release(), ti});
-      return user_types_[static_cast<size_t>(new_pos)];
+    if (i != e && strcmp(uti->name(), (*i)->name()) == 0) {
+      // type already known
+      return *i;
+    }
+    auto id = uti->type_id();
+    auto res = ids_.emplace(id, uti.get());
+    if (! res.second) {
+      CAF_LOGF_ERROR("type ID of " << uti->name() << " collides with "
+                     << res.first->second->name());
     }
+    // insert after lower bound (vector is always sorted)
+    auto new_pos = std::distance(user_types_.begin(), i);
+    user_types_.insert(i, enriched_pointer{uti.release(), ti});
+    return user_types_[static_cast<size_t>(new_pos)];
   }
 
   ~utim_impl() {
@@ -574,6 +582,8 @@ private:
   // bot containers are sorted by uniform name (user_types_: second->name())
   std::array<pointer, type_nrs - 1> builtin_types_;
   std::vector<enriched_pointer> user_types_;
+  // maps type IDs of user-defined types to their type info
+  std::unordered_map<uint64_t, pointer> ids_;
   mutable detail::shared_spinlock lock_;
 
   pointer find_rtti(const std::type_info& ti) const {
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE actor_registry
+#include "caf/test/unit_test.hpp"
+
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/actor_registry.hpp"
+
+using namespace caf;
+
+namespace {
+
+behavior dummy() {
+  return {
+    others >> [] {
+      // nop
+    }
+  };
+}
+
+struct fixture {
+  fixture() : reg(detail::singletons::get_actor_registry()) {
+    // nop
+  }
+
+  ~fixture() {
+    await_all_actors_done();
+    shutdown();
+  }
+
+  detail::actor_registry* reg;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(actor_registry_tests, fixture)
+
+CAF_TEST(put_and_erase) {
+  auto x = spawn(dummy);
+  auto ptr = actor_cast<abstract_actor_ptr>(x);
+  reg->put(x->id(), ptr);
+  CAF_CHECK(reg->get(x->id()) == ptr);
+  CAF_CHECK(reg->get_addr(x->id()) == x.address());
+  CAF_CHECK_EQUAL(reg->get_entry(x->id()).second, exit_reason::not_exited);
+  anon_send_exit(x, exit_reason::user_shutdown);
+  await_all_actors_done();
+  // the registry keeps the exit reason of terminated actors
+  auto entry = reg->get_entry(x->id());
+  CAF_CHECK(entry.first == nullptr);
+  CAF_CHECK_EQUAL(entry.second, exit_reason::user_shutdown);
+  // unknown IDs
+  entry = reg->get_entry(std::numeric_limits<actor_id>::max());
+  CAF_CHECK(entry.first == nullptr);
+  CAF_CHECK_EQUAL(entry.second, exit_reason::unknown);
+}
+
+CAF_TEST(concurrent_access) {
+  // each thread registers its own actors under their ID, i.e., all threads
+  // access all shards, while looking up actors of the other threads
+  const size_t num_threads = 4;
+  const size_t num_actors = 100;
+  std::vector<std::vector<actor>> xs(num_threads);
+  for (auto& vec : xs)
+    for (size_t i = 0; i < num_actors; ++i)
+      vec.push_back(spawn(dummy));
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t)
+    threads.emplace_back([&, t] {
+      for (auto& x : xs[t])
+        reg->put(x->id(), actor_cast<abstract_actor_ptr>(x));
+      for (auto& vec : xs)
+        for (auto& x : vec)
+          static_cast<void>(reg->get(x->id()));
+    });
+  for (auto& t : threads)
+    t.join();
+  for (auto& vec : xs)
+    for (auto& x : vec) {
+      CAF_CHECK(reg->get_addr(x->id()) == x.address());
+      anon_send_exit(x, exit_reason::user_shutdown);
+    }
+  await_all_actors_done();
+  for (auto& vec : xs)
+    for (auto& x : vec)
+      CAF_CHECK(reg->get(x->id()) == nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,144 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE attachables
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <chrono>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using ok_atom = atom_constant<atom("ok")>;
+
+behavior dummy() {
+  return {
+    others >> [] {
+      // nop
+    }
+  };
+}
+
+// reports `ok_atom` to `sink` after receiving a down message from `target`
+behavior observer(event_based_actor* self, actor target, actor sink) {
+  self->monitor(target);
+  return {
+    [=](const down_msg& dm) {
+      if (dm.source == target && dm.reason == exit_reason::user_shutdown) {
+        self->send(sink, ok_atom::value);
+      }
+      self->quit();
+    }
+  };
+}
+
+struct fixture {
+  ~fixture() {
+    await_all_actors_done();
+    shutdown();
+  }
+
+  size_t drain(scoped_actor& self) {
+    size_t result = 0;
+    bool done = false;
+    self->do_receive(
+      [&](const down_msg&) {
+        ++result;
+      },
+      [&](const exit_msg&) {
+        ++result;
+      },
+      after(std::chrono::milliseconds(100)) >> [&] {
+        done = true;
+      }
+    ).until([&] { return done; });
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(attachables_tests, fixture)
+
+CAF_TEST(notify_all_observers) {
+  const size_t num_observers = 1000;
+  scoped_actor self;
+  self->trap_exit(true);
+  auto target = spawn(dummy);
+  std::atomic<bool> functor_called{false};
+  target->attach_functor([&] {
+    functor_called = true;
+  });
+  self->link_to(target);
+  for (size_t i = 0; i < num_observers; ++i) {
+    spawn(observer, target, self);
+  }
+  anon_send_exit(target, exit_reason::user_shutdown);
+  size_t received = 0;
+  size_t exits = 0;
+  self->receive_for(received, num_observers + 1) (
+    [&](ok_atom) {
+      // nop
+    },
+    [&](const exit_msg& em) {
+      CAF_CHECK(em.source == target);
+      CAF_CHECK_EQUAL(em.reason, exit_reason::user_shutdown);
+      ++exits;
+    }
+  );
+  CAF_CHECK_EQUAL(exits, 1u);
+  await_all_actors_done();
+  CAF_CHECK(functor_called.load());
+}
+
+CAF_TEST(detach_all_matches) {
+  scoped_actor self;
+  auto target = spawn(dummy);
+  for (int i = 0; i < 3; ++i) {
+    self->monitor(target);
+  }
+  auto ptr = actor_cast<abstract_actor_ptr>(target);
+  default_attachable::observe_token tk{self->address(),
+                                       default_attachable::monitor};
+  CAF_CHECK_EQUAL(ptr->detach(tk), 3u);
+  CAF_CHECK_EQUAL(ptr->detach(tk), 0u);
+  self->monitor(target);
+  anon_send_exit(target, exit_reason::user_shutdown);
+  CAF_CHECK_EQUAL(drain(self), 1u);
+}
+
+CAF_TEST(unlink) {
+  scoped_actor self;
+  self->trap_exit(true);
+  auto target = spawn(dummy);
+  self->link_to(target);
+  self->link_to(target);
+  self->unlink_from(target);
+  self->link_to(target);
+  anon_send_exit(target, exit_reason::user_shutdown);
+  CAF_CHECK_EQUAL(drain(self), 1u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE behavior
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using detail::behavior_impl;
+
+using a_atom = atom_constant<atom("a")>;
+using b_atom = atom_constant<atom("b")>;
+using c_atom = atom_constant<atom("c")>;
+
+// returns the integer result of `f(xs...)` or -1 if nothing matched
+template <class... Ts>
+int invoke(message_handler& f, Ts&&... xs) {
+  auto msg = make_message(std::forward<Ts>(xs)...);
+  optional<message> res = f(msg);
+  if (! res || ! res->match_elements<int>()) {
+    return -1;
+  }
+  return res->get_as<int>(0);
+}
+
+// ten cases, i.e., dispatched via the index
+message_handler indexed_handler() {
+  return {
+    [](int) { return 1; },
+    [](a_atom) { return 2; },
+    [](double) { return 3; },
+    [](b_atom) { return 4; },
+    [](const std::string&) { return 5; },
+    [](int, int) { return 6; },
+    [](a_atom, int) { return 7; },
+    [](float) { return 8; },
+    [](int, double) { return 9; },
+    [](a_atom, a_atom) { return 10; }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(indexed_dispatch) {
+  auto f = indexed_handler();
+  CAF_CHECK(f.as_behavior_impl()->size()
+            >= behavior_impl::index_threshold);
+  CAF_CHECK_EQUAL(invoke(f, 42), 1);
+  CAF_CHECK_EQUAL(invoke(f, a_atom::value), 2);
+  CAF_CHECK_EQUAL(invoke(f, 1.), 3);
+  CAF_CHECK_EQUAL(invoke(f, b_atom::value), 4);
+  CAF_CHECK_EQUAL(invoke(f, std::string{"hi"}), 5);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2), 6);
+  CAF_CHECK_EQUAL(invoke(f, a_atom::value, 1), 7);
+  CAF_CHECK_EQUAL(invoke(f, 1.f), 8);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2.), 9);
+  CAF_CHECK_EQUAL(invoke(f, a_atom::value, a_atom::value), 10);
+  // same token as the atom cases but no matching value
+  CAF_CHECK_EQUAL(invoke(f, c_atom::value), -1);
+  // unknown token
+  CAF_CHECK_EQUAL(invoke(f, 1, 2, 3), -1);
+  CAF_CHECK_EQUAL(invoke(f), -1);
+}
+
+CAF_TEST(wildcards_keep_their_position) {
+  message_handler f{
+    [](int) { return 1; },
+    [](a_atom) { return 2; },
+    [](double) { return 3; },
+    others >> [] { return 4; },
+    [](b_atom) { return 5; },
+    [](const std::string&) { return 6; },
+    [](int, int) { return 7; },
+    [](float) { return 8; },
+    [](int, double) { return 9; }
+  };
+  CAF_CHECK(f.as_behavior_impl()->size()
+            >= behavior_impl::index_threshold);
+  CAF_CHECK_EQUAL(invoke(f, 42), 1);
+  CAF_CHECK_EQUAL(invoke(f, a_atom::value), 2);
+  CAF_CHECK_EQUAL(invoke(f, 1.), 3);
+  // all cases following the wildcard are unreachable
+  CAF_CHECK_EQUAL(invoke(f, b_atom::value), 4);
+  CAF_CHECK_EQUAL(invoke(f, std::string{"hi"}), 4);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2), 4);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2, 3), 4);
+  CAF_CHECK_EQUAL(invoke(f), 4);
+}
+
+CAF_TEST(indexed_or_else) {
+  auto f = indexed_handler().or_else(
+    [](c_atom) { return 11; },
+    [](a_atom) { return 12; },
+    others >> [] { return 13; }
+  );
+  CAF_CHECK_EQUAL(invoke(f, a_atom::value), 2);
+  CAF_CHECK_EQUAL(invoke(f, c_atom::value), 11);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2), 6);
+  CAF_CHECK_EQUAL(invoke(f, 1, 2, 3), 13);
+  CAF_CHECK_EQUAL(invoke(f), 13);
+}
@@ -0,0 +1,143 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE bounded_mailbox
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <chrono>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  scoped_actor self;
+  scoped_actor testee;
+
+  // fills the mailbox of `testee` with the integers [0, n)
+  void fill(overflow_policy policy, int n) {
+    testee->bound_mailbox(3, policy);
+    for (int i = 0; i < n; ++i)
+      self->send(testee, i);
+  }
+
+  // returns all integers in the mailbox of `testee`
+  std::vector<int> drain() {
+    std::vector<int> result;
+    bool done = false;
+    testee->receive_while([&] { return ! done; })(
+      [&](int x) {
+        result.push_back(x);
+      },
+      after(std::chrono::seconds(0)) >> [&] {
+        done = true;
+      }
+    );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(bounded_mailbox_tests, fixture)
+
+CAF_TEST(unbounded_by_default) {
+  CAF_CHECK_EQUAL(testee->mailbox_capacity(), 0u);
+  for (int i = 0; i < 5; ++i)
+    self->send(testee, i);
+  CAF_CHECK_EQUAL(testee->mailbox().count(), 5u);
+  CAF_CHECK(drain() == (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+CAF_TEST(drop_newest) {
+  fill(overflow_policy::drop_newest, 5);
+  CAF_CHECK_EQUAL(testee->mailbox().count(), 3u);
+  CAF_CHECK(drain() == (std::vector<int>{0, 1, 2}));
+}
+
+CAF_TEST(drop_oldest) {
+  fill(overflow_policy::drop_oldest, 5);
+  // the actor drops old messages before fetching the next message, i.e.,
+  // we cannot use `drain` since its timeout message counts as well
+  std::vector<int> result;
+  for (int i = 0; i < 3; ++i)
+    testee->receive(
+      [&](int x) {
+        result.push_back(x);
+      }
+    );
+  CAF_CHECK(result == (std::vector<int>{2, 3, 4}));
+  CAF_CHECK_EQUAL(testee->mailbox().count(), 0u);
+}
+
+CAF_TEST(reject) {
+  fill(overflow_policy::reject, 3);
+  self->sync_send(testee, 3).await(
+    [](const sync_exited_msg& x) {
+      CAF_CHECK_EQUAL(x.reason, exit_reason::mailbox_overflow);
+    },
+    others >> [&] {
+      CAF_TEST_ERROR("unexpected message: "
+                     << to_string(self->current_message()));
+    }
+  );
+  CAF_CHECK(drain() == (std::vector<int>{0, 1, 2}));
+}
+
+CAF_TEST(backpressure) {
+  fill(overflow_policy::backpressure, 4);
+  self->receive(
+    [&](overflow_atom, const actor_addr& x) {
+      CAF_CHECK(x == testee->address());
+    }
+  );
+  CAF_CHECK(drain() == (std::vector<int>{0, 1, 2, 3}));
+}
+
+CAF_TEST(system_messages_bypass_capacity) {
+  fill(overflow_policy::drop_newest, 3);
+  testee->trap_exit(true);
+  self->send_exit(testee, exit_reason::user_defined);
+  testee->receive(
+    [&](const exit_msg& x) {
+      CAF_CHECK_EQUAL(x.reason, exit_reason::user_defined);
+    }
+  );
+  CAF_CHECK(drain() == (std::vector<int>{0, 1, 2}));
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(spawn_option) {
+  auto f = [](event_based_actor* self) -> behavior {
+    CAF_CHECK_EQUAL(self->mailbox_capacity(),
+                    local_actor::default_mailbox_capacity);
+    CAF_CHECK(self->mailbox_overflow_policy() == overflow_policy::reject);
+    self->quit();
+    return {};
+  };
+  spawn<bounded_mailbox>(f);
+  await_all_actors_done();
+  shutdown();
+}
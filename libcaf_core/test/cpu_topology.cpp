@@ -0,0 +1,76 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE cpu_topology
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/detail/cpu_topology.hpp"
+
+using namespace caf::detail;
+
+namespace {
+
+// two packages with one NUMA node each, two cores per package sharing an L3,
+// and two SMT siblings per core sharing an L2
+std::vector<cpu_info> dual_socket() {
+  std::vector<cpu_info> result;
+  for (int id = 0; id < 8; ++id) {
+    cpu_info x;
+    x.id = id;
+    x.package = id / 4;
+    x.node = id / 4;
+    x.core = (id / 2) % 2;
+    x.l2 = id - id % 2;
+    x.l3 = id - id % 4;
+    result.push_back(x);
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(distances) {
+  auto xs = dual_socket();
+  CAF_CHECK(distance(xs[0], xs[1]) == cpu_distance::shared_cache);
+  CAF_CHECK(distance(xs[0], xs[2]) == cpu_distance::shared_cache);
+  CAF_CHECK(distance(xs[0], xs[4]) == cpu_distance::remote);
+  xs[2].l3 = 2;
+  CAF_CHECK(distance(xs[0], xs[2]) == cpu_distance::same_node);
+}
+
+CAF_TEST(worker_cpus) {
+  CAF_CHECK(select_worker_cpus({}, 4).empty());
+  auto xs = select_worker_cpus(dual_socket(), 10);
+  CAF_REQUIRE(xs.size() == 10);
+  // physical cores of the first node, then of the second node
+  CAF_CHECK_EQUAL(xs[0].id, 0);
+  CAF_CHECK_EQUAL(xs[1].id, 2);
+  CAF_CHECK_EQUAL(xs[2].id, 4);
+  CAF_CHECK_EQUAL(xs[3].id, 6);
+  // SMT siblings come last
+  CAF_CHECK_EQUAL(xs[4].id, 1);
+  CAF_CHECK_EQUAL(xs[7].id, 7);
+  // round-robin assignment if there are more workers than CPUs
+  CAF_CHECK_EQUAL(xs[8].id, 0);
+  CAF_CHECK_EQUAL(xs[9].id, 2);
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE detached_threads
+#include "caf/test/unit_test.hpp"
+
+#include <chrono>
+#include <thread>
+#include <sstream>
+#include <unordered_set>
+
+#include "caf/all.hpp"
+#include "caf/scheduler/detached_threads.hpp"
+
+using namespace caf;
+
+namespace {
+
+using std::chrono::milliseconds;
+
+// waits until the pool has `n` idle threads
+void await_idle_threads(size_t n) {
+  while (scheduler::idle_detached_threads() != n)
+    std::this_thread::sleep_for(milliseconds(1));
+}
+
+// replies with the ID of its thread and terminates
+behavior thread_id_reporter(event_based_actor* self) {
+  return {
+    [=](get_atom) -> std::string {
+      self->quit();
+      std::ostringstream os;
+      os << std::this_thread::get_id();
+      return os.str();
+    }
+  };
+}
+
+struct fixture {
+  fixture() {
+    scheduler::set_detached_pool_limits(64, milliseconds(10000));
+  }
+
+  ~fixture() {
+    await_all_actors_done();
+    // stops all idle threads
+    scheduler::await_detached_threads();
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(detached_threads_tests, fixture)
+
+CAF_TEST(reuse_idle_threads) {
+  std::unordered_set<std::string> ids;
+  scoped_actor self;
+  for (int i = 0; i < 10; ++i) {
+    auto worker = spawn<detached>(thread_id_reporter);
+    self->sync_send(worker, get_atom::value).await(
+      [&](const std::string& id) {
+        ids.insert(id);
+      }
+    );
+    // the thread returns to the pool after the actor terminated
+    await_idle_threads(1);
+  }
+  CAF_CHECK_EQUAL(ids.size(), 1u);
+}
+
+CAF_TEST(run_detached_actors_concurrently) {
+  // detached actors may block each other, hence the pool
+  // must not make `worker1` wait for `worker2`
+  scoped_actor self;
+  auto worker1 = spawn<detached>(thread_id_reporter);
+  auto worker2 = spawn<detached>(thread_id_reporter);
+  std::string id1;
+  std::string id2;
+  self->sync_send(worker2, get_atom::value).await(
+    [&](const std::string& id) {
+      id2 = id;
+    }
+  );
+  self->sync_send(worker1, get_atom::value).await(
+    [&](const std::string& id) {
+      id1 = id;
+    }
+  );
+  CAF_CHECK(id1 != id2);
+}
+
+CAF_TEST(limit_idle_threads) {
+  scheduler::set_detached_pool_limits(2, milliseconds(10000));
+  { // lifetime scope of workers
+    std::vector<actor> workers;
+    for (int i = 0; i < 4; ++i)
+      workers.push_back(spawn<detached>(thread_id_reporter));
+    for (auto& worker : workers)
+      anon_send(worker, get_atom::value);
+  }
+  await_all_actors_done();
+  await_idle_threads(2);
+  CAF_CHECK_EQUAL(scheduler::idle_detached_threads(), 2u);
+}
+
+CAF_TEST(idle_timeout) {
+  scheduler::set_detached_pool_limits(64, milliseconds(1));
+  anon_send(spawn<detached>(thread_id_reporter), get_atom::value);
+  await_all_actors_done();
+  // without the timeout, the thread would stay idle
+  std::this_thread::sleep_for(milliseconds(100));
+  CAF_CHECK_EQUAL(scheduler::idle_detached_threads(), 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(shutdown_stops_idle_threads) {
+  anon_send(spawn<detached>(thread_id_reporter), get_atom::value);
+  await_all_actors_done();
+  shutdown();
+  CAF_CHECK_EQUAL(scheduler::idle_detached_threads(), 0u);
+}
@@ -23,6 +23,7 @@
 #include "caf/test/unit_test.hpp"
 
 #include <chrono>
+#include <vector>
 
 #include "caf/all.hpp"
 
@@ -53,6 +54,64 @@ void testee(event_based_actor* self) {
   self->delayed_send(self, std::chrono::seconds(1), timeout_atom::value);
 }
 
+// forwards each `msg_atom` to `sink` and leaves `grp` on `leave_atom`
+behavior subscriber(event_based_actor* self, group grp, actor sink) {
+  return {
+    [=](msg_atom) {
+      self->send(sink, msg_atom::value);
+    },
+    [=](leave_atom) {
+      self->leave(grp);
+      return ok_atom::value;
+    }
+  };
+}
+
+CAF_TEST(publish_to_changing_subscribers) {
+  scoped_actor self;
+  auto grp = group::anonymous();
+  std::vector<actor> subscribers;
+  auto num_subscribers = 100;
+  auto await_msgs = [&](int num) {
+    int received = 0;
+    for (int i = 0; i < num; ++i)
+      self->receive(
+        [&](msg_atom) {
+          ++received;
+        },
+        after(std::chrono::seconds(1)) >> [] {
+          // nop
+        }
+      );
+    self->receive(
+      [&](msg_atom) {
+        ++received;
+      },
+      after(std::chrono::milliseconds(50)) >> [] {
+        // nop
+      }
+    );
+    CAF_CHECK_EQUAL(received, num);
+  };
+  for (auto i = 0; i < num_subscribers; ++i)
+    subscribers.push_back(spawn_in_group(grp, subscriber, grp, self));
+  anon_send(grp, msg_atom::value);
+  await_msgs(num_subscribers);
+  // publish again without membership changes, i.e., reuse the snapshot
+  anon_send(grp, msg_atom::value);
+  await_msgs(num_subscribers);
+  for (auto i = 0; i < num_subscribers / 2; ++i)
+    self->sync_send(subscribers[i], leave_atom::value).await(
+      [](ok_atom) {
+        // nop
+      }
+    );
+  anon_send(grp, msg_atom::value);
+  await_msgs(num_subscribers / 2);
+  for (auto& s : subscribers)
+    self->send_exit(s, exit_reason::user_shutdown);
+}
+
 CAF_TEST(test_local_group) {
   spawn(testee);
   await_all_actors_done();
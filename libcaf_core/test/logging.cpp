@@ -0,0 +1,137 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+// enable all log statements in this test, regardless of the build setup
+#undef CAF_LOG_LEVEL
+#define CAF_LOG_LEVEL 4
+
+#define CAF_SUITE logging
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/logging.hpp"
+#include "caf/detail/get_process_id.hpp"
+
+#ifndef CAF_WINDOWS
+#include <dirent.h>
+#endif
+
+using namespace caf;
+
+using detail::logging;
+
+namespace {
+
+std::string marker(size_t thread_id, size_t i) {
+  return "logging-test-" + std::to_string(thread_id) + "-"
+         + std::to_string(i) + ".";
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(actor_ids) {
+  auto lg = detail::singletons::get_logger();
+  CAF_CHECK_EQUAL(lg->set_aid(42), 0);
+  CAF_CHECK_EQUAL(lg->get_aid(), 42);
+  std::thread t{[lg] {
+    // each thread has its own ID
+    CAF_CHECK_EQUAL(lg->get_aid(), 0);
+  }};
+  t.join();
+  CAF_CHECK_EQUAL(lg->set_aid(0), 42);
+}
+
+CAF_TEST(runtime_level) {
+  auto lvl = logging::level();
+  logging::set_level(CAF_INFO);
+  CAF_CHECK(logging::accepts(CAF_ERROR));
+  CAF_CHECK(logging::accepts(CAF_INFO));
+  CAF_CHECK(! logging::accepts(CAF_DEBUG));
+  logging::set_level(lvl);
+}
+
+#ifndef CAF_WINDOWS
+
+CAF_TEST(log_file) {
+  const size_t num_threads = 4;
+  // more records than fit into a ring buffer
+  const size_t num_records = 2000;
+  std::string long_msg(1000, 'x');
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < num_threads; ++t)
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < num_records; ++i)
+        CAF_LOGF_INFO(marker(t, i));
+    });
+  for (auto& t : threads)
+    t.join();
+  logging::set_level(CAF_INFO);
+  CAF_LOGF_DEBUG("filtered-out");
+  logging::set_level(CAF_TRACE);
+  CAF_LOGF_DEBUG(long_msg);
+  // stops the logger, i.e., flushes all records to the file
+  shutdown();
+  auto prefix = "actor_log_" + std::to_string(detail::get_process_id()) + "_";
+  std::vector<std::string> files;
+  auto dir = opendir(".");
+  CAF_REQUIRE(dir != nullptr);
+  while (auto entry = readdir(dir)) {
+    std::string fname = entry->d_name;
+    if (fname.compare(0, prefix.size(), prefix) == 0)
+      files.push_back(std::move(fname));
+  }
+  closedir(dir);
+  // previous tests of this process may have started other loggers
+  auto found_files = ! files.empty();
+  CAF_REQUIRE(found_files);
+  std::vector<size_t> next(num_threads, 0);
+  bool found_filtered = false;
+  bool found_long_msg = false;
+  for (auto& fname : files) {
+    std::ifstream in{fname};
+    std::string line;
+    while (std::getline(in, line)) {
+      for (size_t t = 0; t < num_threads; ++t)
+        if (next[t] < num_records
+            && line.find(marker(t, next[t])) != std::string::npos)
+          ++next[t];
+      if (line.find("filtered-out") != std::string::npos)
+        found_filtered = true;
+      if (line.find(long_msg) != std::string::npos)
+        found_long_msg = true;
+    }
+    in.close();
+    remove(fname.c_str());
+  }
+  // each thread writes its records in order
+  for (size_t t = 0; t < num_threads; ++t)
+    CAF_CHECK_EQUAL(next[t], num_records);
+  CAF_CHECK(! found_filtered);
+  CAF_CHECK(found_long_msg);
+}
+
+#endif // CAF_WINDOWS
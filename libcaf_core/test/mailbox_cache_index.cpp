@@ -0,0 +1,150 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE mailbox_cache_index
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/all.hpp"
+#include "caf/detail/mailbox_cache_index.hpp"
+
+using namespace caf;
+
+using caf::detail::mailbox_cache_index;
+
+namespace {
+
+struct fixture {
+  std::vector<mailbox_element_ptr> elements;
+  mailbox_cache_index idx;
+
+  mailbox_element* add(message msg, bool high_priority = false) {
+    elements.push_back(mailbox_element::make(invalid_actor_addr,
+                                             message_id::make(), msg));
+    idx.push(elements.back().get(), high_priority);
+    return elements.back().get();
+  }
+
+  // drains all elements `bhvr` may match in order of invocation
+  std::vector<mailbox_element*> drain(const behavior& bhvr) {
+    std::vector<mailbox_element*> result;
+    std::vector<mailbox_cache_index::bucket*> xs;
+    idx.candidates(bhvr, xs);
+    mailbox_cache_index::entry x;
+    uint64_t min_key = 0;
+    while (idx.take_next(xs, min_key, x)) {
+      min_key = x.key;
+      result.push_back(x.ptr);
+    }
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(mailbox_cache_index_tests, fixture)
+
+CAF_TEST(candidates_by_type) {
+  auto a = add(make_message(1));
+  auto b = add(make_message("a"));
+  auto c = add(make_message(2));
+  auto d = add(make_message(1.0));
+  using ptrs = std::vector<mailbox_element*>;
+  CAF_CHECK(drain(behavior{[](int) {}}) == (ptrs{a, c}));
+  CAF_CHECK(drain(behavior{[](int) {}}).empty());
+  CAF_CHECK(drain(behavior{others >> [] {}}) == (ptrs{b, d}));
+}
+
+CAF_TEST(merge_in_key_order) {
+  auto a = add(make_message(1));
+  auto b = add(make_message("a"));
+  auto c = add(make_message(2), true);
+  auto d = add(make_message("b"), true);
+  auto e = add(make_message(3));
+  using ptrs = std::vector<mailbox_element*>;
+  CAF_CHECK(drain(behavior{[](int) {}, [](const std::string&) {}})
+            == (ptrs{c, d, a, b, e}));
+}
+
+CAF_TEST(restore_keeps_position) {
+  auto a = add(make_message(1));
+  auto b = add(make_message(2));
+  auto c = add(make_message(3));
+  behavior bhvr{[](int) {}};
+  std::vector<mailbox_cache_index::bucket*> xs;
+  idx.candidates(bhvr, xs);
+  mailbox_cache_index::entry x;
+  auto found = idx.take_next(xs, 0, x);
+  CAF_REQUIRE(found);
+  CAF_CHECK(x.ptr == a);
+  auto y = x;
+  found = idx.take_next(xs, y.key, x);
+  CAF_REQUIRE(found);
+  CAF_CHECK(x.ptr == b);
+  idx.restore(y);
+  using ptrs = std::vector<mailbox_element*>;
+  CAF_CHECK(drain(bhvr) == (ptrs{a, c}));
+}
+
+CAF_TEST(responses_by_id) {
+  auto mid = message_id::from_integer_value(42).response_id();
+  elements.push_back(mailbox_element::make(invalid_actor_addr, mid,
+                                           make_message(1)));
+  idx.push(elements.back().get(), false);
+  mailbox_cache_index::entry x;
+  CAF_CHECK(drain(behavior{others >> [] {}}).empty());
+  auto found = idx.take_response(mid, x);
+  CAF_REQUIRE(found);
+  CAF_CHECK(x.ptr == elements.back().get());
+  found = idx.take_response(mid, x);
+  CAF_CHECK(! found);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(stashed_messages_in_order) {
+  auto received = std::make_shared<std::vector<int>>();
+  auto testee = spawn([=](event_based_actor* self) -> behavior {
+    return {
+      [=](const std::string&) {
+        self->become(
+          [=](int x) {
+            received->push_back(x);
+            if (received->size() == 6)
+              self->quit();
+          }
+        );
+      }
+    };
+  });
+  // interleave messages the actor cannot handle with the ones it stashes
+  for (int i = 0; i < 3; ++i) {
+    anon_send(testee, i);
+    anon_send(testee, 1.0);
+  }
+  for (int i = 3; i < 6; ++i)
+    anon_send(testee, i);
+  anon_send(testee, "go");
+  await_all_actors_done();
+  CAF_CHECK(*received == (std::vector<int>{0, 1, 2, 3, 4, 5}));
+  shutdown();
+}
@@ -0,0 +1,151 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE memory
+#include "caf/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/memory.hpp"
+
+using namespace caf;
+
+using detail::memory;
+
+#ifndef CAF_NO_MEM_MANAGEMENT
+
+namespace {
+
+mailbox_element_ptr make_element() {
+  return mailbox_element::make(invalid_actor_addr, message_id{},
+                               message{});
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(local_reuse) {
+  auto before = memory::stats_for<mailbox_element>();
+  auto x = make_element();
+  auto ptr = x.get();
+  auto stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.live, before.live + 1);
+  x.reset();
+  stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.live, before.live);
+  CAF_CHECK(stats.cached > 0);
+  CAF_CHECK_EQUAL(stats.remote_freed, before.remote_freed);
+  // the slot we just released is the next one we get
+  x = make_element();
+  CAF_CHECK(x.get() == ptr);
+}
+
+CAF_TEST(remote_free) {
+  auto before = memory::stats_for<mailbox_element>();
+  std::vector<mailbox_element_ptr> xs;
+  for (size_t i = 0; i < 100; ++i)
+    xs.push_back(make_element());
+  CAF_CHECK_EQUAL(memory::stats_for<mailbox_element>().live,
+                  before.live + 100);
+  std::thread t{[&] {
+    xs.clear();
+  }};
+  t.join();
+  auto stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.live, before.live);
+  CAF_CHECK_EQUAL(stats.remote_freed, before.remote_freed + 100);
+  // remotely freed slots become available once the local list runs dry
+  auto cached = stats.cached;
+  for (size_t i = 0; i < cached + 100; ++i)
+    xs.push_back(make_element());
+  stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.cached, 0);
+}
+
+CAF_TEST(message_data) {
+  auto before = memory::stats_for<detail::tuple_vals<int, int>>();
+  auto msg = make_message(1, 2);
+  auto stats = memory::stats_for<detail::tuple_vals<int, int>>();
+  CAF_CHECK_EQUAL(stats.live, before.live + 1);
+  auto copy = msg;
+  copy.get_as_mutable<int>(0) = 10; // detaches
+  CAF_CHECK_EQUAL(msg.get_as<int>(0), 1);
+  CAF_CHECK_EQUAL(copy.get_as<int>(0), 10);
+  stats = memory::stats_for<detail::tuple_vals<int, int>>();
+  CAF_CHECK_EQUAL(stats.live, before.live + 2);
+  msg = message{};
+  copy = message{};
+  stats = memory::stats_for<detail::tuple_vals<int, int>>();
+  CAF_CHECK_EQUAL(stats.live, before.live);
+}
+
+CAF_TEST(batch_creation) {
+  auto before = memory::stats_for<mailbox_element>();
+  auto msg = make_message(1, 2);
+  auto data = msg.cvals().get();
+  std::vector<mailbox_element_ptr> xs;
+  mailbox_element::make_n(50, invalid_actor_addr, message_id{}, msg,
+                          [&](mailbox_element_ptr x) {
+    xs.push_back(std::move(x));
+  });
+  CAF_REQUIRE(xs.size() == 50);
+  auto stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.live, before.live + 50);
+  // all elements share the content of `msg`
+  CAF_CHECK_EQUAL(data->get_reference_count(), 51);
+  for (auto& x : xs) {
+    CAF_CHECK(x->msg.cvals().get() == data);
+    CAF_CHECK_EQUAL(x->msg.get_as<int>(1), 2);
+  }
+  xs.clear();
+  CAF_CHECK_EQUAL(data->get_reference_count(), 1);
+  stats = memory::stats_for<mailbox_element>();
+  CAF_CHECK_EQUAL(stats.live, before.live);
+  // creating no element does not touch the content
+  mailbox_element::make_n(0, invalid_actor_addr, message_id{}, msg,
+                          [&](mailbox_element_ptr x) {
+    xs.push_back(std::move(x));
+  });
+  CAF_CHECK(xs.empty());
+  CAF_CHECK_EQUAL(data->get_reference_count(), 1);
+}
+
+CAF_TEST(orphaned_slab) {
+  std::vector<mailbox_element_ptr> xs;
+  std::thread t{[&] {
+    for (size_t i = 0; i < 10; ++i)
+      xs.push_back(make_element());
+    CAF_CHECK_EQUAL(memory::thread_stats().live, 10);
+  }};
+  t.join();
+  // releasing objects of a terminated thread eventually frees its slab
+  xs.clear();
+}
+
+#else // CAF_NO_MEM_MANAGEMENT
+
+CAF_TEST(no_mem_management) {
+  CAF_CHECK_EQUAL(memory::thread_stats().live, 0);
+}
+
+#endif // CAF_NO_MEM_MANAGEMENT
@@ -0,0 +1,219 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+#include "caf/config.hpp"
+
+#define CAF_SUITE metrics
+#include "caf/test/unit_test.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t num_messages = 1000;
+
+using done_atom = atom_constant<atom("done")>;
+
+behavior counter(event_based_actor* self, actor parent) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](int) {
+      if (++*received == num_messages) {
+        self->send(parent, done_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+struct fixture {
+  ~fixture() {
+    metrics::enable(false);
+    await_all_actors_done();
+    shutdown();
+  }
+
+  // sends `num_messages` messages to an actor and waits for it
+  void run_counter() {
+    scoped_actor self;
+    auto x = spawn(counter, self);
+    for (size_t i = 0; i < num_messages; ++i)
+      anon_send(x, static_cast<int>(i));
+    self->receive(
+      [](done_atom) {
+        // nop
+      }
+    );
+  }
+
+  uint64_t count(const metrics::snapshot& x, metrics::histogram_id id) {
+    return x.histograms[id].count;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(histogram_buckets) {
+  CAF_CHECK_EQUAL(metrics::bucket_of(0), 0);
+  CAF_CHECK_EQUAL(metrics::bucket_of(3), 3);
+  CAF_CHECK_EQUAL(metrics::bucket_of(4), 4);
+  CAF_CHECK_EQUAL(metrics::bucket_of(7), 7);
+  CAF_CHECK_EQUAL(metrics::bucket_of(8), 8);
+  CAF_CHECK_EQUAL(metrics::bucket_of(9), 8);
+  CAF_CHECK_EQUAL(metrics::bucket_of(10), 9);
+  auto last = metrics::bucket_of(std::numeric_limits<uint64_t>::max());
+  CAF_CHECK_EQUAL(last, metrics::histogram_buckets - 1);
+  // each bucket starts right after its predecessor
+  for (size_t i = 0; i < metrics::histogram_buckets; ++i) {
+    auto lb = metrics::lower_bound_of(i);
+    CAF_CHECK_EQUAL(metrics::bucket_of(lb), i);
+    if (i > 0)
+      CAF_CHECK_EQUAL(metrics::bucket_of(lb - 1), i - 1);
+  }
+}
+
+CAF_TEST(percentiles) {
+  metrics::snapshot::histogram h;
+  h.count = 0;
+  h.sum = 0;
+  h.buckets.assign(metrics::histogram_buckets, 0);
+  CAF_CHECK_EQUAL(h.percentile(0.5), 0);
+  for (uint64_t i = 1; i <= 100; ++i) {
+    ++h.buckets[metrics::bucket_of(i)];
+    ++h.count;
+    h.sum += i;
+  }
+  // 50 falls into the bucket [48, 56)
+  CAF_CHECK_EQUAL(h.percentile(0.5), 48);
+  // 100 falls into the bucket [96, 112)
+  CAF_CHECK_EQUAL(h.percentile(1.0), 96);
+  CAF_CHECK_EQUAL(h.percentile(0.0), 1);
+}
+
+CAF_TEST_FIXTURE_SCOPE(metrics_tests, fixture)
+
+CAF_TEST(disabled) {
+  metrics::enable(false);
+  auto before = metrics::take_snapshot();
+  run_counter();
+  auto after = metrics::take_snapshot();
+  CAF_CHECK_EQUAL(count(after, metrics::mailbox_depth),
+                  count(before, metrics::mailbox_depth));
+  CAF_CHECK_EQUAL(count(after, metrics::mailbox_latency_us),
+                  count(before, metrics::mailbox_latency_us));
+  CAF_CHECK_EQUAL(after.counters[metrics::mailbox_blocked],
+                  before.counters[metrics::mailbox_blocked]);
+}
+
+CAF_TEST(mailbox_metrics) {
+  metrics::enable();
+  auto before = metrics::take_snapshot();
+  run_counter();
+  auto after = metrics::take_snapshot();
+  CAF_CHECK(count(after, metrics::mailbox_depth)
+            >= count(before, metrics::mailbox_depth) + num_messages);
+  CAF_CHECK(count(after, metrics::mailbox_latency_us)
+            >= count(before, metrics::mailbox_latency_us) + num_messages);
+}
+
+CAF_TEST(mailbox_transitions) {
+  metrics::enable();
+  auto before = metrics::take_snapshot();
+  auto x = spawn([]() -> behavior {
+    return {
+      [](int) {
+        // nop
+      }
+    };
+  });
+  // wait until the actor runs out of messages after its initialization
+  auto blocked0 = before.counters[metrics::mailbox_blocked];
+  auto blocked = blocked0;
+  for (int i = 0; i < 1000 && blocked == blocked0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    blocked = metrics::take_snapshot().counters[metrics::mailbox_blocked];
+  }
+  CAF_CHECK(blocked > blocked0);
+  // wakes up the actor, which counts on this thread
+  anon_send(x, 42);
+  auto after = metrics::take_snapshot();
+  CAF_CHECK_EQUAL(after.counters[metrics::mailbox_unblocked],
+                  before.counters[metrics::mailbox_unblocked] + 1);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(pending_timers) {
+  metrics::enable();
+  auto x = spawn([](event_based_actor* self) -> behavior {
+    self->delayed_send(self, std::chrono::minutes(60), 42);
+    self->delayed_send(self, std::chrono::minutes(60), 43);
+    return {
+      [=](int) {
+        // nop
+      }
+    };
+  });
+  // wait until the actor has scheduled its messages
+  auto gauge = int64_t{0};
+  for (int i = 0; i < 1000 && gauge < 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    gauge = metrics::take_snapshot().gauges[metrics::pending_timers];
+  }
+  CAF_CHECK_EQUAL(gauge, 2);
+  anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(terminated_threads) {
+  metrics::enable();
+  auto before = metrics::take_snapshot();
+  std::thread t{[] {
+    metrics::add(metrics::net_read_calls, 10);
+    metrics::record(metrics::mailbox_depth, 5);
+  }};
+  t.join();
+  auto after = metrics::take_snapshot();
+  CAF_CHECK_EQUAL(after.counters[metrics::net_read_calls],
+                  before.counters[metrics::net_read_calls] + 10);
+  CAF_CHECK_EQUAL(count(after, metrics::mailbox_depth),
+                  count(before, metrics::mailbox_depth) + 1);
+}
+
+CAF_TEST(reporter) {
+  metrics::enable();
+  metrics::add(metrics::net_write_calls, 3);
+  scoped_actor self;
+  auto reporter = metrics::spawn_reporter();
+  self->sync_send(reporter, get_atom::value).await(
+    [&](const metrics::snapshot& x) {
+      CAF_CHECK(x.counters[metrics::net_write_calls] >= 3);
+      auto str = to_string(x);
+      CAF_CHECK(str.find("caf_net_write_calls ") != std::string::npos);
+      CAF_CHECK(str.find("caf_mailbox_latency_us{quantile=\"0.99\"} ")
+                != std::string::npos);
+    }
+  );
+  anon_send_exit(reporter, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
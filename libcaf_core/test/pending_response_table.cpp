@@ -0,0 +1,109 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE pending_response_table
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+
+#include "caf/detail/pending_response_table.hpp"
+
+using namespace caf;
+
+using caf::detail::pending_response_table;
+
+namespace {
+
+struct fixture {
+  pending_response_table tbl;
+  uint64_t last_id = 0;
+
+  message_id next_id() {
+    return message_id::from_integer_value(++last_id).response_id();
+  }
+
+  std::vector<message_id> add(size_t n) {
+    std::vector<message_id> result;
+    for (size_t i = 0; i < n; ++i) {
+      result.push_back(next_id());
+      tbl.emplace(result.back(), behavior{});
+    }
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(pending_response_table_tests, fixture)
+
+CAF_TEST(empty_table) {
+  CAF_CHECK(tbl.empty());
+  CAF_CHECK(tbl.find(next_id()) == nullptr);
+  CAF_CHECK(! tbl.erase(next_id()));
+}
+
+CAF_TEST(front_is_most_recent_request) {
+  auto ids = add(3);
+  CAF_CHECK_EQUAL(tbl.size(), 3u);
+  CAF_CHECK(tbl.front().first == ids[2]);
+  // erasing an older request does not change the front
+  CAF_CHECK(tbl.erase(ids[0]));
+  CAF_CHECK(tbl.front().first == ids[2]);
+  CAF_CHECK(tbl.erase(ids[2]));
+  CAF_CHECK(tbl.front().first == ids[1]);
+  CAF_CHECK(! tbl.erase(ids[2]));
+  CAF_CHECK(tbl.erase(ids[1]));
+  CAF_CHECK(tbl.empty());
+}
+
+CAF_TEST(references_survive_growth) {
+  auto first = next_id();
+  auto& x = tbl.emplace(first, behavior{});
+  add(1000);
+  CAF_CHECK(tbl.find(first) == &x);
+}
+
+CAF_TEST(random_erase) {
+  auto ids = add(10000);
+  std::shuffle(ids.begin(), ids.end(), std::minstd_rand{42});
+  auto half = ids.begin() + 5000;
+  for (auto i = ids.begin(); i != half; ++i) {
+    auto erased = tbl.erase(*i);
+    CAF_REQUIRE(erased);
+  }
+  CAF_CHECK_EQUAL(tbl.size(), 5000u);
+  for (auto i = ids.begin(); i != half; ++i)
+    CAF_REQUIRE(tbl.find(*i) == nullptr);
+  for (auto i = half; i != ids.end(); ++i) {
+    auto ptr = tbl.find(*i);
+    CAF_REQUIRE(ptr != nullptr && ptr->first == *i);
+  }
+  // the front is the largest remaining ID
+  CAF_CHECK(tbl.front().first == *std::max_element(half, ids.end()));
+  tbl.clear();
+  CAF_CHECK(tbl.empty());
+  CAF_CHECK(tbl.find(ids.back()) == nullptr);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
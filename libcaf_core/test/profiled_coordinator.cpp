@@ -16,7 +16,6 @@
  * http://opensource.org/licenses/BSD-3-Clause and                            *
  * http://www.boost.org/LICENSE_1_0.txt.                                      *
  ******************************************************************************/
-
 #include "caf/config.hpp"
 
 // exclude this suite; the profiled coordinator currently depends on POSIX
@@ -25,15 +24,123 @@
 #define CAF_SUITE profiled_coordinator
 #include "caf/test/unit_test.hpp"
 
+#include <set>
+#include <map>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+
 #include "caf/all.hpp"
 
 #include "caf/scheduler/profiled_coordinator.hpp"
 
 using namespace caf;
 
+namespace {
+
+using coordinator_type = scheduler::profiled_coordinator<>;
+
+constexpr size_t num_actors = 10;
+constexpr size_t num_messages = 100;
+
+std::vector<std::string> split(const std::string& line) {
+  std::vector<std::string> result;
+  std::istringstream in{line};
+  std::string field;
+  while (std::getline(in, field, ','))
+    result.push_back(std::move(field));
+  return result;
+}
+
+behavior counter(event_based_actor* self) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](int) {
+      if (++*received == num_messages)
+        self->quit();
+    }
+  };
+}
+
+struct totals {
+  uint64_t resumes = 0;
+  uint64_t messages = 0;
+  uint64_t samples = 0;
+  uint64_t depth_samples = 0;
+};
+
+// runs `num_actors` actors with `num_messages` messages each and returns
+// the summed up rows of the profiler output per actor ID
+std::map<actor_id, totals> run_profiled(size_t sample_interval) {
+  const char* fname = "profiled_coordinator_test.csv";
+  set_scheduler(new coordinator_type{fname, std::chrono::milliseconds{1000},
+                                     2, 10, sample_interval});
+  std::set<actor_id> ids;
+  for (size_t i = 0; i < num_actors; ++i) {
+    auto x = spawn(counter);
+    ids.insert(x.id());
+    for (size_t j = 0; j < num_messages; ++j)
+      anon_send(x, static_cast<int>(j));
+  }
+  await_all_actors_done();
+  shutdown();
+  std::map<actor_id, totals> result;
+  std::ifstream in{fname};
+  std::string line;
+  std::getline(in, line);
+  auto header = split(line);
+  auto columns = header.size();
+  CAF_REQUIRE(columns == 8 + coordinator_type::depth_buckets);
+  CAF_CHECK_EQUAL(header[5], "messages");
+  CAF_CHECK_EQUAL(header.back(), "depth_16384");
+  while (std::getline(in, line)) {
+    auto row = split(line);
+    auto row_size = row.size();
+    CAF_REQUIRE(row_size == columns);
+    auto id = static_cast<actor_id>(std::stoul(row[2]));
+    if (row[1] != "actor" || ids.count(id) == 0)
+      continue;
+    auto& x = result[id];
+    x.resumes += std::stoul(row[4]);
+    x.messages += std::stoul(row[5]);
+    x.samples += std::stoul(row[6]);
+    for (size_t i = 8; i < row.size(); ++i)
+      x.depth_samples += std::stoul(row[i]);
+  }
+  in.close();
+  std::remove(fname);
+  CAF_CHECK_EQUAL(result.size(), num_actors);
+  return result;
+}
+
+} // namespace <anonymous>
+
 CAF_TEST(test_profiled_coordinator) {
-  set_scheduler(new scheduler::profiled_coordinator<>{"/dev/null"});
+  set_scheduler(new coordinator_type{"/dev/null"});
   shutdown();
 }
 
+CAF_TEST(per_actor_totals) {
+  for (auto& kvp : run_profiled(1)) {
+    auto& x = kvp.second;
+    CAF_CHECK_EQUAL(x.messages, num_messages);
+    CAF_CHECK(x.resumes > 0);
+    CAF_CHECK_EQUAL(x.samples, x.resumes);
+    CAF_CHECK_EQUAL(x.depth_samples, x.samples);
+  }
+}
+
+CAF_TEST(sampled_totals) {
+  for (auto& kvp : run_profiled(1000)) {
+    auto& x = kvp.second;
+    // message counts and resumes are exact regardless of sampling
+    CAF_CHECK_EQUAL(x.messages, num_messages);
+    CAF_CHECK(x.resumes > 0);
+    CAF_CHECK(x.samples <= x.resumes);
+    CAF_CHECK_EQUAL(x.depth_samples, x.samples);
+  }
+}
+
 #endif // CAF_WINDOWS
@@ -328,6 +328,41 @@ CAF_TEST(test_multiple_messages) {
   CAF_CHECK(is_message(m2).equal(i32, te, str, rs));
 }
 
+CAF_TEST(compact_message_format) {
+  auto m = make_message(i32, str);
+  auto buf = binary_util::serialize(m);
+  // size and two type numbers followed by both values
+  auto expected_size = sizeof(uint32_t) + 2 * sizeof(uint16_t)
+                       + sizeof(int32_t) + sizeof(uint32_t) + str.size();
+  CAF_CHECK_EQUAL(buf.size(), expected_size);
+  // announced types are identified by their 64-bit type ID
+  auto m2 = make_message(te);
+  auto buf2 = binary_util::serialize(m2);
+  binary_deserializer bd{buf2.data(), buf2.size()};
+  CAF_CHECK_EQUAL(bd.read<uint32_t>(), 1u);
+  CAF_CHECK_EQUAL(bd.read<uint16_t>(), 0);
+  CAF_CHECK_EQUAL(bd.read<uint64_t>(), uniform_typeid<test_enum>()->type_id());
+  message x;
+  binary_util::deserialize(buf2, &x);
+  CAF_CHECK(x == m2);
+}
+
+CAF_TEST(unknown_type_id) {
+  vector<char> buf;
+  binary_serializer bs{std::back_inserter(buf)};
+  bs << uint32_t{1} << uint16_t{0} << uint64_t{42};
+  binary_deserializer bd{buf.data(), buf.size()};
+  message x;
+  auto failed = false;
+  try {
+    x.deserialize(bd);
+  }
+  catch (std::runtime_error&) {
+    failed = true;
+  }
+  CAF_CHECK(failed);
+}
+
 CAF_TEST(strings) {
   auto m1 = make_message("hello \"actor world\"!", atom("foo"));
   auto s1 = to_string(m1);
@@ -0,0 +1,107 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE single_reader_queue
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/detail/single_reader_queue.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct element {
+  element* next;
+  element* prev;
+  int value;
+
+  explicit element(int x = 0) : next(nullptr), prev(nullptr), value(x) {
+    // nop
+  }
+};
+
+using queue_type = detail::single_reader_queue<element>;
+
+struct fixture {
+  queue_type queue;
+  std::vector<int> consumed;
+  std::vector<int> prefetched;
+
+  void fill(int first, int last) {
+    for (int i = first; i <= last; ++i)
+      queue.enqueue(new element(i));
+  }
+
+  // consumes up to `max_count` elements, stopping after element `stop_at`
+  size_t consume(size_t max_count, int stop_at = -1) {
+    return queue.consume(max_count,
+                         [&](element* x) -> bool {
+                           auto value = x->value;
+                           consumed.push_back(value);
+                           delete x;
+                           return value != stop_at;
+                         },
+                         [&](const element& x) {
+                           prefetched.push_back(x.value);
+                         });
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(single_reader_queue_tests, fixture)
+
+CAF_TEST(consume_empty_queue) {
+  CAF_CHECK_EQUAL(consume(10), 0u);
+  CAF_CHECK(consumed.empty());
+}
+
+CAF_TEST(consume_in_fifo_order) {
+  fill(1, 5);
+  CAF_CHECK_EQUAL(consume(3), 3u);
+  CAF_CHECK(consumed == (std::vector<int>{1, 2, 3}));
+  CAF_CHECK(prefetched == (std::vector<int>{2, 3, 4}));
+  CAF_CHECK_EQUAL(consume(10), 2u);
+  CAF_CHECK(consumed == (std::vector<int>{1, 2, 3, 4, 5}));
+  CAF_CHECK(prefetched == (std::vector<int>{2, 3, 4, 5}));
+  CAF_CHECK(queue.empty());
+}
+
+CAF_TEST(consume_single_chunk) {
+  fill(1, 2);
+  CAF_CHECK_EQUAL(consume(1), 1u);
+  // element 2 is pending in the current chunk, newer elements must wait
+  fill(3, 4);
+  CAF_CHECK_EQUAL(consume(10), 1u);
+  CAF_CHECK_EQUAL(consume(10), 2u);
+  CAF_CHECK(consumed == (std::vector<int>{1, 2, 3, 4}));
+}
+
+CAF_TEST(consume_stops_early) {
+  fill(1, 5);
+  CAF_CHECK_EQUAL(consume(10, 2), 2u);
+  CAF_CHECK(consumed == (std::vector<int>{1, 2}));
+  CAF_CHECK_EQUAL(queue.count(), 3u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE timer_wheel
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <cstdint>
+
+#include "caf/detail/timer_wheel.hpp"
+
+using caf::detail::timer_wheel;
+
+namespace {
+
+struct timer : timer_wheel::node {
+  int id;
+};
+
+struct fixture {
+  timer_wheel wheel;
+  std::vector<int> fired;
+
+  void advance(uint64_t tick) {
+    wheel.advance(tick, [&](timer_wheel::node* ptr) {
+      CAF_CHECK(! ptr->linked());
+      fired.push_back(static_cast<timer*>(ptr)->id);
+    });
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(timer_wheel_tests, fixture)
+
+CAF_TEST(empty_wheel) {
+  CAF_CHECK(wheel.empty());
+  CAF_CHECK_EQUAL(wheel.next_tick(), UINT64_MAX);
+  advance(1000);
+  CAF_CHECK(fired.empty());
+  CAF_CHECK_EQUAL(wheel.now(), 1000);
+}
+
+CAF_TEST(timers_expire_in_order) {
+  timer xs[4];
+  uint64_t ticks[] = {30, 10, 20, 10};
+  for (int i = 0; i < 4; ++i) {
+    xs[i].id = i;
+    wheel.insert(&xs[i], ticks[i]);
+    CAF_CHECK(xs[i].linked());
+  }
+  CAF_CHECK_EQUAL(wheel.size(), 4);
+  advance(9);
+  CAF_CHECK(fired.empty());
+  advance(10);
+  CAF_CHECK((fired == std::vector<int>{1, 3}));
+  advance(100);
+  CAF_CHECK((fired == std::vector<int>{1, 3, 2, 0}));
+  CAF_CHECK(wheel.empty());
+}
+
+CAF_TEST(past_timers_expire_on_next_tick) {
+  advance(50);
+  timer x;
+  x.id = 1;
+  wheel.insert(&x, 10);
+  CAF_CHECK_EQUAL(x.tick(), 51);
+  advance(51);
+  CAF_CHECK((fired == std::vector<int>{1}));
+}
+
+CAF_TEST(erased_timers_never_expire) {
+  timer x;
+  timer y;
+  x.id = 1;
+  y.id = 2;
+  wheel.insert(&x, 5);
+  wheel.insert(&y, 5);
+  CAF_CHECK(wheel.erase(&x));
+  CAF_CHECK(! x.linked());
+  CAF_CHECK(! wheel.erase(&x));
+  advance(10);
+  CAF_CHECK((fired == std::vector<int>{2}));
+  CAF_CHECK(! wheel.erase(&y));
+}
+
+CAF_TEST(timers_cascade_across_levels) {
+  // one timer per level plus the boundaries between levels
+  uint64_t ticks[] = {255, 256, 257, 65535, 65536, 70000,
+                      16777215, 16777216, 20000000};
+  std::vector<timer> xs(sizeof(ticks) / sizeof(uint64_t));
+  std::vector<int> expected;
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i].id = static_cast<int>(i);
+    wheel.insert(&xs[i], ticks[i]);
+    expected.push_back(static_cast<int>(i));
+  }
+  // expire each timer exactly at its tick
+  for (size_t i = 0; i < xs.size(); ++i) {
+    advance(ticks[i] - 1);
+    CAF_CHECK_EQUAL(fired.size(), i);
+    advance(ticks[i]);
+    CAF_CHECK_EQUAL(fired.size(), i + 1);
+  }
+  CAF_CHECK(fired == expected);
+  CAF_CHECK(wheel.empty());
+}
+
+CAF_TEST(far_future_timers) {
+  // beyond the range of all levels combined
+  uint64_t far = (uint64_t{1} << 40) + 12345;
+  timer x;
+  x.id = 1;
+  wheel.insert(&x, far);
+  CAF_CHECK(wheel.next_tick() <= far);
+  advance(far - 1);
+  CAF_CHECK(fired.empty());
+  CAF_CHECK(x.linked());
+  advance(far);
+  CAF_CHECK((fired == std::vector<int>{1}));
+}
+
+CAF_TEST(next_tick_is_a_lower_bound) {
+  timer x;
+  x.id = 1;
+  wheel.insert(&x, 1000);
+  auto next = wheel.next_tick();
+  CAF_CHECK(next <= 1000);
+  CAF_CHECK(next > wheel.now());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE work_stealing
+#include "caf/test/unit_test.hpp"
+
+#include <thread>
+#include <chrono>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+behavior ping(event_based_actor* self, actor pong) {
+  return {
+    [=](int x) {
+      self->delegate(pong, x);
+    }
+  };
+}
+
+behavior pong() {
+  return {
+    [](int x) {
+      return x + 1;
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(parked_workers_wake_up) {
+  // park idle workers right away
+  policy::work_stealing::config cfg;
+  cfg.spin_attempts = 1;
+  cfg.steal_interval = 1;
+  set_scheduler<>(4, std::numeric_limits<size_t>::max(), cfg);
+  {
+    scoped_actor self;
+    auto pg = spawn(pong);
+    auto p = spawn(ping, pg);
+    for (int i = 0; i < 10; ++i) {
+      // give all workers time to park
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      self->sync_send(p, i).await(
+        [&](int x) {
+          CAF_CHECK_EQUAL(x, i + 1);
+        },
+        after(std::chrono::seconds(5)) >> [] {
+          CAF_TEST_ERROR("parked worker did not wake up");
+        }
+      );
+    }
+    anon_send_exit(p, exit_reason::kill);
+    anon_send_exit(pg, exit_reason::kill);
+  }
+  await_all_actors_done();
+  shutdown();
+}
+
+CAF_TEST(topology_aware_workers) {
+  policy::work_stealing::config cfg;
+  cfg.topology_aware = true;
+  set_scheduler<>(4, std::numeric_limits<size_t>::max(), cfg);
+  {
+    scoped_actor self;
+    auto pg = spawn(pong);
+    auto p = spawn(ping, pg);
+    for (int i = 0; i < 100; ++i) {
+      self->sync_send(p, i).await(
+        [&](int x) {
+          CAF_CHECK_EQUAL(x, i + 1);
+        }
+      );
+    }
+    anon_send_exit(p, exit_reason::kill);
+    anon_send_exit(pg, exit_reason::kill);
+  }
+  await_all_actors_done();
+  shutdown();
+}
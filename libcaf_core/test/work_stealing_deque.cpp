@@ -0,0 +1,133 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE work_stealing_deque
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include "caf/detail/work_stealing_deque.hpp"
+
+using caf::detail::work_stealing_deque;
+
+namespace {
+
+using deque_type = work_stealing_deque<int>;
+
+} // namespace <anonymous>
+
+CAF_TEST(empty_deque) {
+  deque_type q;
+  CAF_CHECK(q.empty());
+  CAF_CHECK(q.take() == nullptr);
+  CAF_CHECK(q.steal() == nullptr);
+  CAF_CHECK(q.empty());
+}
+
+CAF_TEST(owner_is_lifo_thief_is_fifo) {
+  int xs[] = {1, 2, 3, 4};
+  deque_type q;
+  for (auto& x : xs) {
+    q.push(&x);
+  }
+  CAF_CHECK_EQUAL(q.size(), 4);
+  CAF_CHECK(q.take() == &xs[3]);
+  CAF_CHECK(q.steal() == &xs[0]);
+  CAF_CHECK(q.take() == &xs[2]);
+  CAF_CHECK(q.steal() == &xs[1]);
+  CAF_CHECK(q.empty());
+  CAF_CHECK(q.take() == nullptr);
+  CAF_CHECK(q.steal() == nullptr);
+}
+
+CAF_TEST(growing) {
+  std::vector<int> xs(1000);
+  deque_type q{4};
+  CAF_CHECK_EQUAL(q.capacity(), 4);
+  for (auto& x : xs) {
+    q.push(&x);
+  }
+  CAF_CHECK_EQUAL(q.size(), xs.size());
+  CAF_CHECK(q.capacity() >= xs.size());
+  for (auto& x : xs) {
+    CAF_CHECK(q.steal() == &x);
+  }
+  CAF_CHECK(q.empty());
+}
+
+CAF_TEST(concurrent_stealing) {
+  static constexpr size_t num_elements = 100000;
+  static constexpr size_t num_thieves = 3;
+  std::vector<int> xs(num_elements, 0);
+  std::vector<std::atomic<int>> taken(num_elements);
+  for (auto& x : taken) {
+    x = 0;
+  }
+  deque_type q{16};
+  std::atomic<bool> done{false};
+  std::atomic<size_t> stolen{0};
+  auto mark = [&](int* x) {
+    ++taken[static_cast<size_t>(x - xs.data())];
+  };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i) {
+    thieves.emplace_back([&] {
+      while (! done) {
+        auto x = q.steal();
+        if (x) {
+          mark(x);
+          ++stolen;
+        }
+      }
+    });
+  }
+  size_t popped = 0;
+  for (size_t i = 0; i < num_elements; ++i) {
+    q.push(&xs[i]);
+    // pop every third element ourselves
+    if (i % 3 == 0) {
+      auto x = q.take();
+      if (x) {
+        mark(x);
+        ++popped;
+      }
+    }
+  }
+  for (auto x = q.take(); x != nullptr; x = q.take()) {
+    mark(x);
+    ++popped;
+  }
+  done = true;
+  for (auto& t : thieves) {
+    t.join();
+  }
+  auto total = popped + stolen.load();
+  CAF_CHECK_EQUAL(total, num_elements);
+  size_t duplicates_or_losses = 0;
+  for (auto& x : taken) {
+    if (x != 1) {
+      ++duplicates_or_losses;
+    }
+  }
+  CAF_CHECK_EQUAL(duplicates_or_losses, 0);
+}
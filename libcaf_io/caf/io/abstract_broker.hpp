@@ -138,6 +138,21 @@ public:
   /// Creates and assigns a new `scribe` from given native socked `fd`.
   connection_handle add_tcp_scribe(network::native_socket fd);
 
+  /// Queries whether the `multiplexer` of this broker can connect to
+  /// other processes on the same host via shared memory.
+  bool supports_shm();
+
+  /// Creates a new `scribe` communicating via shared memory and returns its
+  /// handle along with a token for the peer process. The peer connects by
+  /// calling `add_shm_scribe(pid, token)` with the process ID of this node.
+  /// @throws network_error Thrown if shared memory is unavailable.
+  std::pair<connection_handle, uint64_t> add_shm_scribe();
+
+  /// Connects to the `scribe` offered by process `pid` under `token`.
+  /// @throws network_error Thrown if shared memory is unavailable or
+  ///                       the peer did not respond in time.
+  connection_handle add_shm_scribe(uint32_t pid, uint64_t token);
+
   /// Adds a `doorman` instance to this broker.
   void add_doorman(const intrusive_ptr<doorman>& ptr);
 
@@ -236,7 +251,8 @@ protected:
 
   /// @endcond
 
-  /// Returns the `multiplexer` running this broker.
+  /// Returns the `multiplexer` running this broker. Each broker is pinned
+  /// to one event loop of the middleman, which also owns its connections.
   network::multiplexer& backend();
 
   /// Returns a `scribe` or `doorman` identified by `hdl`.
@@ -268,6 +284,7 @@ private:
   scribe_map scribes_;
   doorman_map doormen_;
   middleman& mm_;
+  network::multiplexer& backend_;
   detail::intrusive_partitioned_list<mailbox_element, detail::disposer> cache_;
 };
 
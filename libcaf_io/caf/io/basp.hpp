@@ -166,7 +166,7 @@ namespace basp {
 
 /// The current BASP version. Different BASP versions will not
 /// be able to exchange messages.
-constexpr uint64_t version = 1;
+constexpr uint64_t version = 2;
 
 /// Storage type for raw bytes.
 using buffer_type = std::vector<char>;
@@ -204,7 +204,19 @@ enum class message_type : uint32_t {
   /// that has been terminated.
   ///
   /// ![](kill_proxy_instance.png)
-  kill_proxy_instance = 0x04
+  kill_proxy_instance = 0x04,
+
+  /// Send from client to server after the handshake if both nodes run on
+  /// the same host. The operation data is a token for connecting to a
+  /// shared memory channel offered by the client process.
+  shm_offer = 0x05,
+
+  /// Marks the last message send via the current connection before
+  /// switching to a shared memory channel. The operation data is 1 if the
+  /// channel is used from now on and 0 if the server declined the offer.
+  /// The receiver starts reading from the channel after processing this
+  /// message, which preserves the ordering of all messages.
+  shm_switch = 0x06
 };
 
 /// @relates message_type
@@ -256,6 +268,21 @@ constexpr size_t header_size =
   node_id::host_id_size * 2 + sizeof(uint32_t) * 2 +
   sizeof(actor_id) * 2 + sizeof(uint32_t) * 2 + sizeof(uint64_t);
 
+/// Maximum number of bytes a BASP broker reads from a connection at once.
+/// A single read usually contains several frames.
+constexpr size_t max_read_size = 16 * 1024;
+
+/// Describes a function object responsible for writing
+/// the payload for a BASP message.
+using payload_writer = callback<serializer&>;
+
+/// Writes `hdr` followed by the payload written by `writer` to `buf` and
+/// updates `hdr.payload_len`, using `ns` to serialize actor addresses.
+/// Unlike `instance::write`, this function does not access the state of a
+/// BASP instance and is thus safe to call from any thread.
+void write_frame(buffer_type& buf, actor_namespace& ns, header& hdr,
+                 payload_writer* writer = nullptr);
+
 /// Describes an error during forwarding of BASP messages.
 enum class error : uint64_t {
   /// Indicates that a forwarding node had no route
@@ -321,6 +348,11 @@ public:
   /// @pre `hdl != invalid_connection_handle && nid != invalid_node_id`
   void add_direct(const connection_handle& hdl, const node_id& dest);
 
+  /// Makes `hdl` the direct route to `dest`. The previous handle for `dest`
+  /// remains associated to `dest` until `dest` is erased from the table.
+  /// @pre `lookup_direct(dest) != invalid_connection_handle`
+  void replace_direct(const connection_handle& hdl, const node_id& dest);
+
   /// Adds a new indirect route to the table.
   bool add_indirect(const node_id& hop, const node_id& dest);
 
@@ -360,6 +392,9 @@ public:
   using indirect_entries = std::unordered_map<node_id,      // dest
                                               node_id_set>; // hop
 
+  // removes all handles replaced via `replace_direct` for `dest`
+  void erase_replaced(const node_id& dest);
+
   abstract_broker* parent_;
   std::unordered_map<connection_handle, node_id> direct_by_hdl_;
   std::unordered_map<node_id, connection_handle> direct_by_nid_;
@@ -434,9 +469,18 @@ public:
 
   instance(abstract_broker* parent, callee& lstnr);
 
-  /// Handles received data and returns a config for receiving the
-  /// next data or `none` if an error occured.
-  connection_state handle(const new_data_msg& dm, header& hdr, bool is_payload);
+  /// Handles all complete frames in `dm.buf`. Frames are parsed in place,
+  /// i.e., without copying them out of the read buffer first. An incomplete
+  /// frame at the end of the buffer is stored in `pending` and completed
+  /// by subsequent calls. Returns `close_connection` on error.
+  connection_state handle(const new_data_msg& dm, buffer_type& pending);
+
+  /// Handles a single frame received on `hdl`. The header `hdr` must be
+  /// valid and `payload` must point to `hdr.payload_len` bytes directly
+  /// following the serialized header, which allows relaying the frame
+  /// without serializing it again.
+  connection_state handle(const connection_handle& hdl, const header& hdr,
+                          const char* payload);
 
   /// Handles connection shutdowns.
   void handle(const connection_closed_msg& msg);
@@ -474,6 +518,13 @@ public:
   bool dispatch(const actor_addr& sender, const actor_addr& receiver,
                 message_id mid, const message& msg);
 
+  /// Sends `frame`, i.e., a `dispatch_message` for `msg` that has already
+  /// been serialized by `write_frame`. The content of `frame` is moved to the
+  /// output buffer. Returns `true` if a path to destination existed,
+  /// `false` otherwise.
+  bool dispatch(const actor_addr& sender, const actor_addr& receiver,
+                message_id mid, const message& msg, buffer_type& frame);
+
   /// Returns the actor namespace associated to this BASP protocol instance.
   actor_namespace& get_namespace() {
     return callee_.get_namespace();
@@ -484,6 +535,16 @@ public:
     return tbl_;
   }
 
+  /// Enables or disables moving direct connections to nodes on the same
+  /// host to shared memory (enabled by default).
+  inline void enable_shm(bool x) {
+    shm_enabled_ = x;
+  }
+
+  /// Returns the shared memory connection to `nid` or
+  /// `invalid_connection_handle` if none exists.
+  connection_handle shm_connection(const node_id& nid) const;
+
   /// Stores the address of a published actor along with its publicly
   /// visible messaging interface.
   using published_actor = std::pair<actor_addr, std::set<std::string>>;
@@ -528,7 +589,7 @@ public:
                             const node_id& dest_node,
                             error error_code,
                             const header& original_hdr,
-                            const buffer_type* payload);
+                            const char* payload);
 
   /// Writes a `kill_proxy_instance` to `buf`.
   void write_kill_proxy_instance(buffer_type& buf,
@@ -547,10 +608,35 @@ public:
   }
 
 private:
+  // a shared memory channel replacing the connection `tcp` to a node
+  struct shm_link {
+    connection_handle tcp;
+    connection_handle shm;
+    bool offered; // true if this node created the channel
+  };
+
+  // removes all routes over `hdl` and returns `close_connection`
+  connection_state drop_connection(const connection_handle& hdl);
+
+  // checks whether we can talk to `nid` via shared memory
+  bool shm_eligible(const node_id& nid) const;
+
+  // creates a channel for `nid` and writes an offer to `buf`
+  void offer_shm(const connection_handle& hdl, const node_id& nid,
+                 buffer_type& buf);
+
+  // handles `shm_offer` and `shm_switch` messages
+  void handle_shm(const connection_handle& hdl, const header& hdr);
+
+  // closes all connections for `nid` except `hdl`
+  void close_shm(const node_id& nid, const connection_handle& hdl);
+
   routing_table tbl_;
   published_actor_map published_actors_;
   node_id this_node_;
   callee& callee_;
+  bool shm_enabled_;
+  std::unordered_map<node_id, shm_link> shm_links_;
 };
 
 /// Checks whether given header contains a handshake.
@@ -78,17 +78,22 @@ struct basp_broker_state : actor_namespace::backend, basp::instance::callee {
 
   struct connection_context {
     basp::connection_state cstate;
-    basp::header hdr;
     connection_handle hdl;
     node_id id;
     uint16_t remote_port;
     optional<response_promise> callback;
+    // incomplete frame at the end of the last read
+    basp::buffer_type pending;
   };
 
   void set_context(connection_handle hdl);
 
   bool erase_context(connection_handle hdl);
 
+  // returns the actor serializing messages to `nid` on behalf of this broker,
+  // i.e., the manager of all proxies for actors running on `nid`
+  const actor& shard_for(const node_id& nid);
+
   // pointer to ourselves
   broker* self;
 
@@ -110,6 +115,10 @@ struct basp_broker_state : actor_namespace::backend, basp::instance::callee {
   // get a 'SpawnServ' instance on the remote side
   std::unordered_map<node_id, actor> spawn_servers;
 
+  // serialize messages to remote actors in parallel; all messages for the
+  // same node are handled by the same shard to preserve message ordering
+  std::vector<actor> shards;
+
   // can be enabled by the user to let CAF automatically try
   // to establish new connections at runtime to optimize
   // routing paths by forming a mesh between all nodes
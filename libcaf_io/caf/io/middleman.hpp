@@ -21,6 +21,7 @@
 #define CAF_IO_MIDDLEMAN_HPP
 
 #include <map>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <thread>
@@ -68,18 +69,36 @@ public:
   /// Adds `bptr` to the list of known brokers.
   void add_broker(broker_ptr bptr);
 
-  /// Runs `fun` in the event loop of the middleman.
+  /// Runs `fun` in the main event loop of the middleman.
   /// @note This member function is thread-safe.
   template <class F>
   void run_later(F fun) {
-    backend_->post(fun);
+    backend().post(fun);
   }
 
-  /// Returns the IO backend used by this middleman.
+  /// Returns the IO backend running the main event loop of this middleman.
+  /// All named brokers, including the BASP broker, as well as all hooks
+  /// run in this event loop.
   inline network::multiplexer& backend() {
-    return *backend_;
+    return *backends_.front();
   }
 
+  /// Returns the IO backend running event loop `x`.
+  inline network::multiplexer& backend(size_t x) {
+    return *backends_[x];
+  }
+
+  /// Returns the number of event loops, i.e., IO backends, of this middleman.
+  inline size_t num_backends() const {
+    return backends_.size();
+  }
+
+  /// Selects the IO backend for a new broker. Returns the backend of the
+  /// calling thread when called from an event loop, e.g., when forking a
+  /// broker, and assigns backends in round-robin order otherwise.
+  /// @note This member function is thread-safe.
+  network::multiplexer& next_backend();
+
   /// Invokes the callback(s) associated with given event.
   template <hook::event_type Event, typename... Ts>
   void notify(Ts&&... ts) {
@@ -135,7 +154,9 @@ public:
   // initializes the singleton
   void initialize() override;
 
-  middleman(const backend_factory&);
+  /// Creates a middleman running `num_backends` event loops,
+  /// each using an IO backend created by `factory`.
+  middleman(const backend_factory& factory, size_t num_backends = 1);
 
   inline size_t max_throughput() const {
     return max_throughput_;
@@ -144,12 +165,14 @@ public:
   /// @endcond
 
 private:
-  // networking backend
-  backend_pointer backend_;
-  // prevents backend from shutting down unless explicitly requested
-  network::multiplexer::supervisor_ptr backend_supervisor_;
-  // runs the backend
-  std::thread thread_;
+  // networking backends, each running its own event loop
+  std::vector<backend_pointer> backends_;
+  // prevents backends from shutting down unless explicitly requested
+  std::vector<network::multiplexer::supervisor_ptr> backend_supervisors_;
+  // runs the backends
+  std::vector<std::thread> threads_;
+  // selects backends for new brokers in round-robin order
+  std::atomic<size_t> next_backend_;
   // keeps track of "singleton-like" brokers
   std::map<atom_value, broker_ptr> named_brokers_;
   // keeps track of anonymous brokers
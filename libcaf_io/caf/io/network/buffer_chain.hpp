@@ -0,0 +1,126 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_IO_NETWORK_BUFFER_CHAIN_HPP
+#define CAF_IO_NETWORK_BUFFER_CHAIN_HPP
+
+#include <deque>
+#include <vector>
+#include <cstddef>
+
+#include "caf/ref_counted.hpp"
+#include "caf/intrusive_ptr.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// A reference-counted block of bytes. Streams share segments instead of
+/// copying them, e.g., when sending the same data to multiple peers.
+/// @warning The content must not change once a segment has been passed
+///          to a stream.
+class buffer_segment : public ref_counted {
+public:
+  using buffer_type = std::vector<char>;
+
+  explicit buffer_segment(buffer_type buf);
+
+  ~buffer_segment();
+
+  inline buffer_type& buf() {
+    return buf_;
+  }
+
+  inline const buffer_type& buf() const {
+    return buf_;
+  }
+
+private:
+  buffer_type buf_;
+};
+
+/// @relates buffer_segment
+using buffer_segment_ptr = intrusive_ptr<buffer_segment>;
+
+/// Describes a contiguous block of bytes for scatter-gather IO.
+struct write_chunk {
+  const char* data;
+  size_t size;
+};
+
+/// A FIFO queue of buffer segments that allows a stream to send all pending
+/// segments with a single system call. Storage of fully written segments is
+/// recycled unless other streams still share the segment.
+class buffer_chain {
+public:
+  using buffer_type = buffer_segment::buffer_type;
+
+  buffer_chain();
+
+  buffer_chain(const buffer_chain&) = delete;
+  buffer_chain& operator=(const buffer_chain&) = delete;
+
+  /// Returns whether all segments have been written.
+  inline bool empty() const {
+    return segments_.empty();
+  }
+
+  /// Returns the number of pending bytes.
+  inline size_t size() const {
+    return size_;
+  }
+
+  /// Appends a shared segment to the chain.
+  void append(buffer_segment_ptr ptr);
+
+  /// Moves the content of `buf` into a new segment at the end of the chain
+  /// and replaces it with a recycled buffer if possible.
+  void append(buffer_type& buf);
+
+  /// Stores up to `max_chunks` pending blocks in `chunks`.
+  /// @returns the number of stored chunks.
+  size_t prepare(write_chunk* chunks, size_t max_chunks) const;
+
+  /// Removes the first `num_bytes` pending bytes from the chain.
+  void consume(size_t num_bytes);
+
+  /// Discards all pending segments.
+  void clear();
+
+private:
+  // maximum number of buffers kept for reuse
+  static constexpr size_t max_spare_buffers = 4;
+
+  // buffers with a larger capacity are not kept for reuse
+  static constexpr size_t max_spare_capacity = 64 * 1024;
+
+  void recycle(buffer_segment_ptr& ptr);
+
+  std::deque<buffer_segment_ptr> segments_;
+  // number of bytes from the first segment that have already been written
+  size_t offset_;
+  size_t size_;
+  std::vector<buffer_type> spare_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_IO_NETWORK_BUFFER_CHAIN_HPP
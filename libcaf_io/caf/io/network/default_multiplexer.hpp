@@ -36,6 +36,7 @@
 #include "caf/io/receive_policy.hpp"
 #include "caf/io/connection_handle.hpp"
 #include "caf/io/network/operation.hpp"
+#include "caf/io/network/buffer_chain.hpp"
 #include "caf/io/network/multiplexer.hpp"
 #include "caf/io/network/stream_manager.hpp"
 #include "caf/io/network/acceptor_manager.hpp"
@@ -174,6 +175,13 @@ bool read_some(size_t& result, native_socket fd, void* buf, size_t len);
 /// of written bytes is stored in `result` (can be 0).
 bool write_some(size_t& result, native_socket fd, const void* buf, size_t len);
 
+/// Writes up to `num_chunks` blocks from `chunks` to `fd` using a single
+/// scatter-gather system call. Returns `true` as long as `fd` is writable
+/// and `false` if the socket has been closed or an IO error occured. The
+/// number of written bytes is stored in `result` (can be 0).
+bool write_some(size_t& result, native_socket fd,
+                const write_chunk* chunks, size_t num_chunks);
+
 /// Tries to accept a new connection from `fd`. On success,
 /// the new connection is stored in `result`. Returns true
 /// as long as
@@ -302,6 +310,14 @@ public:
   std::pair<accept_handle, uint16_t>
   add_tcp_doorman(abstract_broker*, uint16_t p, const char* in, bool rflag) override;
 
+  bool supports_shm() const override;
+
+  std::pair<connection_handle, uint64_t>
+  add_shm_scribe(abstract_broker* ptr) override;
+
+  connection_handle add_shm_scribe(abstract_broker* ptr, uint32_t pid,
+                                   uint64_t token) override;
+
   void dispatch_runnable(runnable_ptr ptr) override;
 
   default_multiplexer();
@@ -412,8 +428,7 @@ public:
         sock_(backend_ref),
         threshold_(1),
         collected_(0),
-        writing_(false),
-        written_(0) {
+        writing_(false) {
     configure_read(receive_policy::at_most(1024));
   }
 
@@ -471,20 +486,32 @@ public:
     return rd_buf_;
   }
 
-  /// Sends the content of the write buffer, calling the `io_failure`
-  /// member function of `mgr` in case of an error.
+  /// Enqueues a shared segment without copying it. The write buffer
+  /// is enqueued first to preserve the ordering of outgoing data.
+  /// @warning Not thread safe.
+  void write(buffer_segment_ptr segment) {
+    CAF_LOG_TRACE("");
+    wr_chain_.append(wr_offline_buf_);
+    wr_chain_.append(std::move(segment));
+  }
+
+  /// Schedules the content of the write buffer for sending, calling the
+  /// `io_failure` member function of `mgr` in case of an error. Data is
+  /// sent once the socket becomes writable, i.e., all flushes during one
+  /// iteration of the event loop result in a single system call.
   /// @warning Must not be called outside the IO multiplexers event loop
   ///          once the stream has been started.
   void flush(const manager_ptr& mgr) {
     CAF_ASSERT(mgr != nullptr);
     CAF_LOG_TRACE("offline buf size: " << wr_offline_buf_.size()
+             << ", pending bytes: " << wr_chain_.size()
              << ", mgr = " << mgr.get()
              << ", writer_ = " << writer_.get());
-    if (! wr_offline_buf_.empty() && ! writing_) {
+    wr_chain_.append(wr_offline_buf_);
+    if (! wr_chain_.empty() && ! writing_) {
       backend().add(operation::write, sock_.fd(), this);
       writer_ = mgr;
       writing_ = true;
-      write_loop();
     }
   }
 
@@ -514,17 +541,17 @@ public:
         break;
       }
       case operation::write: {
+        write_chunk chunks[max_write_chunks];
+        auto num_chunks = wr_chain_.prepare(chunks, max_write_chunks);
         size_t wb; // written bytes
-        if (! write_some(wb, sock_.fd(),
-                wr_buf_.data() + written_,
-                wr_buf_.size() - written_)) {
+        if (! write_some(wb, sock_.fd(), chunks, num_chunks)) {
           writer_->io_failure(operation::write);
           backend().del(operation::write, sock_.fd(), this);
         }
         else if (wb > 0) {
-          written_ += wb;
-          if (written_ >= wr_buf_.size()) {
-            // prepare next send (or stop sending)
+          wr_chain_.consume(wb);
+          if (wr_chain_.empty()) {
+            // stop sending
             write_loop();
           }
         }
@@ -577,18 +604,17 @@ private:
   }
 
   void write_loop() {
-    CAF_LOG_TRACE("wr_buf size: " << wr_buf_.size()
+    CAF_LOG_TRACE("pending bytes: " << wr_chain_.size()
              << ", offline buf size: " << wr_offline_buf_.size());
-    written_ = 0;
-    wr_buf_.clear();
-    if (wr_offline_buf_.empty()) {
+    if (wr_chain_.empty()) {
       writing_ = false;
       backend().del(operation::write, sock_.fd(), this);
-    } else {
-      wr_buf_.swap(wr_offline_buf_);
     }
   }
 
+  // maximum number of segments passed to a single system call
+  static constexpr size_t max_write_chunks = 64;
+
   // reading & writing
   Socket sock_;
   // reading
@@ -601,8 +627,7 @@ private:
   // writing
   manager_ptr writer_;
   bool writing_;
-  size_t written_;
-  buffer_type wr_buf_;
+  buffer_chain wr_chain_;
   buffer_type wr_offline_buf_;
 };
 
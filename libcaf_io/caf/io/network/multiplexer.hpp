@@ -98,6 +98,26 @@ public:
   add_tcp_doorman(abstract_broker* ptr, uint16_t port, const char* in = nullptr,
                   bool reuse_addr = false) = 0;
 
+  /// Queries whether this multiplexer can connect brokers running
+  /// in different processes on the same host via shared memory.
+  virtual bool supports_shm() const;
+
+  /// Creates a new scribe communicating via shared memory and returns its
+  /// handle along with a token for the peer process to connect via
+  /// `add_shm_scribe(ptr, pid, token)`. The scribe does not receive any
+  /// data before its read policy is configured for the first time.
+  /// @throws network_error if shared memory is not supported or unavailable
+  /// @warning Do not call from outside the multiplexer's event loop.
+  virtual std::pair<connection_handle, uint64_t>
+  add_shm_scribe(abstract_broker* ptr);
+
+  /// Connects to the scribe offered by process `pid` under `token`
+  /// and returns a new scribe managing our end of the connection.
+  /// @throws network_error if shared memory is not supported or unavailable
+  /// @warning Do not call from outside the multiplexer's event loop.
+  virtual connection_handle add_shm_scribe(abstract_broker* ptr, uint32_t pid,
+                                           uint64_t token);
+
   /// Simple wrapper for runnables
   struct runnable : ref_counted {
     static constexpr auto memory_cache_flag = detail::needs_embedding;
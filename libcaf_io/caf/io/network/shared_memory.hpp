@@ -0,0 +1,287 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_IO_NETWORK_SHARED_MEMORY_HPP
+#define CAF_IO_NETWORK_SHARED_MEMORY_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "caf/config.hpp"
+
+#include "caf/io/receive_policy.hpp"
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/stream_manager.hpp"
+#include "caf/io/network/default_multiplexer.hpp"
+
+#ifdef CAF_LINUX
+
+namespace caf {
+namespace io {
+namespace network {
+
+/// Control block of an `shm_ring`. Producer and consumer positions are
+/// placed on different cache lines to avoid false sharing.
+struct shm_ring_header {
+  /// Number of bytes written by the producer so far.
+  alignas(64) std::atomic<uint64_t> head;
+  /// Number of bytes read by the consumer so far.
+  alignas(64) std::atomic<uint64_t> tail;
+  /// Set by the producer when it waits for free space.
+  alignas(64) std::atomic<uint32_t> producer_waiting;
+};
+
+/// A single-producer, single-consumer byte ring in a memory region
+/// shared between two processes. The ring itself never blocks, it
+/// only tells its users when to notify the other side.
+class shm_ring {
+public:
+  shm_ring();
+
+  /// Views `region` as ring with `capacity` bytes of payload.
+  /// @pre `capacity` is a power of two
+  shm_ring(void* region, size_t capacity);
+
+  /// Returns the number of bytes a ring with `capacity` bytes
+  /// of payload occupies in a shared memory region.
+  static size_t region_size(size_t capacity);
+
+  /// Initializes the control block. Must be called exactly once by
+  /// the process creating the shared memory region.
+  void init();
+
+  /// Copies up to `len` bytes from `buf` to the ring and returns the
+  /// number of written bytes. Sets `wakeup` to `true` if the consumer
+  /// might be waiting for data and needs to be notified.
+  size_t write(const void* buf, size_t len, bool& wakeup);
+
+  /// Copies up to `len` bytes from the ring to `buf` and returns the
+  /// number of read bytes. Sets `wakeup` to `true` if the producer
+  /// waits for free space and needs to be notified.
+  size_t read(void* buf, size_t len, bool& wakeup);
+
+  /// Tells the consumer to notify the producer after reading and returns
+  /// `true` if space became available in the meantime, in which case
+  /// the producer must not wait for a notification.
+  bool await_space();
+
+  /// Returns the number of readable bytes.
+  size_t size() const;
+
+  inline bool empty() const {
+    return size() == 0;
+  }
+
+  inline size_t capacity() const {
+    return capacity_;
+  }
+
+private:
+  shm_ring_header* hdr_;
+  char* data_;
+  size_t capacity_;
+};
+
+/// A bidirectional channel between two processes on the same host,
+/// consisting of two rings in a shared memory region plus one `eventfd`
+/// per side serving as doorbell. The process creating a channel sends
+/// the file descriptors via a UNIX domain socket to its peer.
+class shm_channel {
+public:
+  /// Default capacity of each ring in bytes.
+  static constexpr size_t default_capacity = 1024 * 1024;
+
+  shm_channel();
+
+  shm_channel(shm_channel&&);
+
+  shm_channel& operator=(shm_channel&&);
+
+  shm_channel(const shm_channel&) = delete;
+
+  shm_channel& operator=(const shm_channel&) = delete;
+
+  ~shm_channel();
+
+  /// Creates a new channel with rings of `capacity` bytes each.
+  /// @throws network_error
+  static shm_channel create(size_t capacity = default_capacity);
+
+  /// Sends the file descriptors of this channel over `fd`.
+  /// @pre `fd` is a connected UNIX domain socket
+  bool send(native_socket fd) const;
+
+  /// Receives the file descriptors of a channel over `fd` and maps the
+  /// shared memory region, i.e., creates the other end of the channel.
+  /// @throws network_error
+  static shm_channel receive(native_socket fd);
+
+  /// Returns the doorbell this end waits on.
+  inline native_socket bell() const {
+    return bell_;
+  }
+
+  /// Returns the ring for incoming data.
+  inline shm_ring& input() {
+    return input_;
+  }
+
+  /// Returns the ring for outgoing data.
+  inline shm_ring& output() {
+    return output_;
+  }
+
+  /// Notifies the other end.
+  void ring_peer();
+
+  /// Wakes up this end in the next iteration of its event loop.
+  void ring_self();
+
+  /// Resets the doorbell of this end.
+  void clear_bell();
+
+private:
+  void map(size_t region_size, bool creator);
+
+  void close_all();
+
+  int mem_fd_;
+  native_socket bell_;
+  native_socket peer_bell_;
+  void* region_;
+  size_t region_size_;
+  shm_ring input_;
+  shm_ring output_;
+};
+
+/// Creates a UNIX domain socket in the abstract namespace that serves
+/// channel `token` of this process to a single peer.
+/// @throws network_error
+native_socket new_shm_listener(uint64_t token);
+
+/// Receives channel `token` offered by process `pid`, waiting at most
+/// `timeout_ms` milliseconds for the peer.
+/// @throws network_error
+shm_channel connect_shm_channel(uint32_t pid, uint64_t token, int timeout_ms);
+
+/// A stream over an `shm_channel`. The doorbell of the channel is the only
+/// file descriptor this handler registers at its multiplexer. The peer
+/// rings it whenever it writes to an empty ring or frees space for
+/// pending output. Data written during `flush` is copied to the output
+/// ring immediately, i.e., without waiting for the event loop.
+class shm_stream : public event_handler {
+public:
+  using manager_ptr = intrusive_ptr<stream_manager>;
+
+  using buffer_type = std::vector<char>;
+
+  shm_stream(default_multiplexer& backend_ref, shm_channel channel);
+
+  /// Returns the underlying channel.
+  inline shm_channel& channel() {
+    return channel_;
+  }
+
+  /// Starts reading data from the channel, forwarding incoming
+  /// data to `mgr`.
+  void start(const manager_ptr& mgr);
+
+  /// Configures how much data will be provided for the next `consume`.
+  void configure_read(receive_policy::config config);
+
+  inline buffer_type& wr_buf() {
+    return wr_offline_buf_;
+  }
+
+  inline buffer_type& rd_buf() {
+    return rd_buf_;
+  }
+
+  /// Copies the content of the write buffer to the output ring, keeping
+  /// data that does not fit until the peer frees enough space.
+  void flush(const manager_ptr& mgr);
+
+  void stop_reading();
+
+  void handle_event(operation op) override;
+
+  void removed_from_loop(operation op) override;
+
+  native_socket fd() const override;
+
+private:
+  // maximum number of `consume` calls per event to keep the loop fair
+  static constexpr size_t max_reads_per_event = 32;
+
+  void read_loop();
+
+  void write_pending();
+
+  shm_channel channel_;
+  bool reading_;
+  // reading
+  manager_ptr reader_;
+  size_t threshold_;
+  size_t collected_;
+  size_t max_;
+  receive_policy_flag rd_flag_;
+  buffer_type rd_buf_;
+  // writing
+  manager_ptr writer_;
+  buffer_type wr_offline_buf_;
+  buffer_type wr_pending_;
+  size_t wr_pending_offset_;
+};
+
+/// Hands out the file descriptors of an `shm_channel` to the first
+/// process connecting to its UNIX domain socket and closes afterwards.
+class shm_listener : public event_handler {
+public:
+  using manager_ptr = intrusive_ptr<manager>;
+
+  shm_listener(default_multiplexer& backend_ref, native_socket fd,
+               const shm_channel& channel);
+
+  ~shm_listener();
+
+  void start(const manager_ptr& mgr);
+
+  void stop();
+
+  void handle_event(operation op) override;
+
+  void removed_from_loop(operation op) override;
+
+  native_socket fd() const override;
+
+private:
+  native_socket fd_;
+  const shm_channel& channel_;
+  manager_ptr mgr_;
+};
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#endif // CAF_LINUX
+
+#endif // CAF_IO_NETWORK_SHARED_MEMORY_HPP
@@ -40,6 +40,35 @@ void set_middleman() {
   set_middleman(new Multiplexer);
 }
 
+/// Sets a user-defined middleman running `num_event_loops` instances of the
+/// network backend created by `factory`, each in its own thread.
+/// Brokers are distributed across all event loops.
+/// @note This function must be used before actor is spawned. Dynamically
+///       changing the middleman at runtime is not supported.
+/// @throws std::logic_error if a middleman is already defined
+void set_middleman(const middleman::backend_factory& factory,
+                   size_t num_event_loops);
+
+/// Sets a user-defined middleman running `num_event_loops` instances
+/// of the default network backend, each in its own thread.
+/// Brokers are distributed across all event loops.
+/// @note This function must be used before actor is spawned. Dynamically
+///       changing the middleman at runtime is not supported.
+/// @throws std::logic_error if a middleman is already defined
+void set_middleman(size_t num_event_loops);
+
+/// Sets a user-defined middleman running `num_event_loops` instances
+/// of `Multiplexer`, each in its own thread.
+/// Brokers are distributed across all event loops.
+/// @note This function must be used before actor is spawned. Dynamically
+///       changing the middleman at runtime is not supported.
+/// @throws std::logic_error if a middleman is already defined
+template <class Multiplexer>
+void set_middleman(size_t num_event_loops) {
+  auto fac = [] { return middleman::backend_pointer{new Multiplexer}; };
+  set_middleman(fac, num_event_loops);
+}
+
 } // namespace io
 } // namespace caf
 
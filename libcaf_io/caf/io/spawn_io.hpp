@@ -45,8 +45,7 @@ intrusive_ptr<Impl> spawn_io_client_impl(F fun, const std::string& host,
   // variadic template parameter packs inside lambdas
   auto args = std::forward_as_tuple(std::forward<Ts>(xs)...);
   auto bl = [&](Impl* ptr) {
-    auto mm = middleman::instance();
-    auto hdl = mm->backend().add_tcp_scribe(ptr, host, port);
+    auto hdl = ptr->add_tcp_scribe(host, port);
     detail::init_fun_factory<Impl, F> fac;
     auto init = detail::apply_args_prefixed(fac, detail::get_indices(args),
                                             args, std::move(fun), hdl);
@@ -60,8 +59,7 @@ intrusive_ptr<Impl> spawn_io_server_impl(F fun, uint16_t port, Ts&&... xs) {
   detail::init_fun_factory<Impl, F> fac;
   auto init = fac(std::move(fun), std::forward<Ts>(xs)...);
   auto bl = [&](Impl* ptr) {
-    auto mm = middleman::instance();
-    mm->backend().add_tcp_doorman(ptr, port);
+    ptr->add_tcp_doorman(port);
     ptr->initial_behavior_fac(std::move(init));
   };
   return spawn_class<Impl>(nullptr, bl);
@@ -55,9 +55,11 @@ private:
   intrusive_ptr<abstract_broker> self_;
 };
 
-void abstract_broker::enqueue(mailbox_element_ptr ptr, execution_unit*) {
+void abstract_broker::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_PUSH_AID(id());
   CAF_LOG_TRACE("enqueue " << CAF_TSARG(ptr->msg));
+  if (handle_overflow(ptr, eu))
+    return;
   auto mid = ptr->mid;
   auto sender = ptr->sender;
   switch (mailbox().enqueue(ptr.release())) {
@@ -163,6 +165,21 @@ abstract_broker::add_tcp_scribe(network::native_socket fd) {
   return backend().add_tcp_scribe(this, fd);
 }
 
+bool abstract_broker::supports_shm() {
+  return backend().supports_shm();
+}
+
+std::pair<connection_handle, uint64_t> abstract_broker::add_shm_scribe() {
+  CAF_LOG_TRACE("");
+  return backend().add_shm_scribe(this);
+}
+
+connection_handle abstract_broker::add_shm_scribe(uint32_t pid,
+                                                  uint64_t token) {
+  CAF_LOG_TRACE(CAF_ARG(pid) << ", " << CAF_ARG(token));
+  return backend().add_shm_scribe(this, pid, token);
+}
+
 void abstract_broker::add_doorman(const intrusive_ptr<doorman>& ptr) {
   doormen_.emplace(ptr->hdl(), ptr);
   if (is_initialized())
@@ -240,16 +257,20 @@ void abstract_broker::init_broker() {
 
 }
 
-abstract_broker::abstract_broker() : mm_(*middleman::instance()) {
+abstract_broker::abstract_broker()
+    : mm_(*middleman::instance()),
+      backend_(mm_.next_backend()) {
   // nop
 }
 
-abstract_broker::abstract_broker(middleman& ptr) : mm_(ptr) {
+abstract_broker::abstract_broker(middleman& ptr)
+    : mm_(ptr),
+      backend_(ptr.backend()) {
   // nop
 }
 
 network::multiplexer& abstract_broker::backend() {
-  return mm_.backend();
+  return backend_;
 }
 
 } // namespace io
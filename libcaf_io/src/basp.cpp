@@ -19,6 +19,7 @@
 
 #include "caf/io/basp.hpp"
 
+#include "caf/exception.hpp"
 #include "caf/message.hpp"
 #include "caf/to_string.hpp"
 #include "caf/uniform_typeid.hpp"
@@ -49,6 +50,10 @@ std::string to_string(message_type x) {
       return "announce_proxy_instance";
     case message_type::kill_proxy_instance:
       return "kill_proxy_instance";
+    case message_type::shm_offer:
+      return "shm_offer";
+    case message_type::shm_switch:
+      return "shm_switch";
     default:
       return "???";
   }
@@ -90,6 +95,29 @@ void write_hdr(serializer& sink, const header& hdr) {
       .write(hdr.operation_data);
 }
 
+void write_frame(buffer_type& buf, actor_namespace& ns, header& hdr,
+                 payload_writer* pw) {
+  if (! pw) {
+    binary_serializer bs{std::back_inserter(buf), &ns};
+    hdr.payload_len = 0;
+    write_hdr(bs, hdr);
+    return;
+  }
+  // reserve space in the buffer to write the payload later on
+  auto wr_pos = static_cast<ptrdiff_t>(buf.size());
+  char placeholder[basp::header_size];
+  buf.insert(buf.end(), std::begin(placeholder), std::end(placeholder));
+  auto pl_pos = buf.size();
+  { // lifetime scope of first serializer (write payload)
+    binary_serializer bs1{std::back_inserter(buf), &ns};
+    (*pw)(bs1);
+  }
+  // write broker message to the reserved space
+  binary_serializer bs2{buf.begin() + wr_pos, &ns};
+  hdr.payload_len = static_cast<uint32_t>(buf.size() - pl_pos);
+  write_hdr(bs2, hdr);
+}
+
 bool operator==(const header& lhs, const header& rhs) {
   return lhs.operation == rhs.operation
       && lhs.payload_len == rhs.payload_len
@@ -154,6 +182,26 @@ bool kill_proxy_instance_valid(const header& hdr) {
        && ! zero(hdr.operation_data);
 }
 
+bool shm_offer_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && zero(hdr.source_actor)
+       && zero(hdr.dest_actor)
+       && zero(hdr.payload_len)
+       && ! zero(hdr.operation_data);
+}
+
+bool shm_switch_valid(const header& hdr) {
+  return  valid(hdr.source_node)
+       && valid(hdr.dest_node)
+       && hdr.source_node != hdr.dest_node
+       && zero(hdr.source_actor)
+       && zero(hdr.dest_actor)
+       && zero(hdr.payload_len)
+       && hdr.operation_data <= 1;
+}
+
 } // namespace <anonymous>
 
 bool valid(const header& hdr) {
@@ -170,6 +218,10 @@ bool valid(const header& hdr) {
       return announce_proxy_instance_valid(hdr);
     case message_type::kill_proxy_instance:
       return kill_proxy_instance_valid(hdr);
+    case message_type::shm_offer:
+      return shm_offer_valid(hdr);
+    case message_type::shm_switch:
+      return shm_switch_valid(hdr);
   }
 }
 
@@ -243,10 +295,12 @@ void routing_table::erase_direct(const connection_handle& hdl,
   auto i = direct_by_hdl_.find(hdl);
   if (i == direct_by_hdl_.end())
     return;
-  cb(i->second);
-  parent_->parent().notify<hook::connection_lost>(i->second);
-  direct_by_nid_.erase(i->second);
+  auto nid = i->second;
+  cb(nid);
+  parent_->parent().notify<hook::connection_lost>(nid);
+  direct_by_nid_.erase(nid);
   direct_by_hdl_.erase(i);
+  erase_replaced(nid);
 }
 
 bool routing_table::erase_indirect(const node_id& dest) {
@@ -269,6 +323,14 @@ void routing_table::add_direct(const connection_handle& hdl,
   parent_->parent().notify<hook::new_connection_established>(nid);
 }
 
+void routing_table::replace_direct(const connection_handle& hdl,
+                                   const node_id& dest) {
+  CAF_ASSERT(direct_by_hdl_.count(hdl) == 0);
+  CAF_ASSERT(direct_by_nid_.count(dest) == 1);
+  direct_by_hdl_.emplace(hdl, dest);
+  direct_by_nid_[dest] = hdl;
+}
+
 bool routing_table::add_indirect(const node_id& hop, const node_id& dest) {
   auto i = blacklist_.find(dest);
   if (i == blacklist_.end() || i->second.count(hop) == 0) {
@@ -301,12 +363,23 @@ size_t routing_table::erase(const node_id& dest, erase_callback& cb) {
   if (hdl != invalid_connection_handle) {
     direct_by_hdl_.erase(hdl);
     direct_by_nid_.erase(dest);
+    erase_replaced(dest);
     parent_->parent().notify<hook::connection_lost>(dest);
     ++res;
   }
   return res;
 }
 
+void routing_table::erase_replaced(const node_id& dest) {
+  auto i = direct_by_hdl_.begin();
+  while (i != direct_by_hdl_.end()) {
+    if (i->second == dest)
+      i = direct_by_hdl_.erase(i);
+    else
+      ++i;
+  }
+}
+
 /******************************************************************************
  *                                   callee                                   *
  ******************************************************************************/
@@ -328,50 +401,87 @@ instance::callee::~callee() {
 instance::instance(abstract_broker* parent, callee& lstnr)
     : tbl_(parent),
       this_node_(caf::detail::singletons::get_node_id()),
-      callee_(lstnr) {
+      callee_(lstnr),
+      shm_enabled_(true) {
   CAF_ASSERT(this_node_ != invalid_node_id);
 }
 
-connection_state instance::handle(const new_data_msg& dm, header& hdr,
-                                  bool is_payload) {
-  CAF_LOG_TRACE("");
-  // function object providing cleanup code on errors
-  auto err = [&]() -> connection_state {
-    auto cb = make_callback([&](const node_id& nid){
-      callee_.purge_state(nid);
-    });
-    tbl_.erase_direct(dm.handle, cb);
-    return close_connection;
+connection_state instance::handle(const new_data_msg& dm,
+                                  buffer_type& pending) {
+  CAF_LOG_TRACE(CAF_ARG(dm.buf.size()) << ", " << CAF_ARG(pending.size()));
+  auto first = dm.buf.data();
+  auto remaining = dm.buf.size();
+  header hdr;
+  auto parse_hdr = [&](const char* data) -> bool {
+    binary_deserializer bd{data, header_size, &get_namespace()};
+    read_hdr(bd, hdr);
+    if (! valid(hdr)) {
+      CAF_LOG_WARNING("received invalid header of type "
+                      << to_string(hdr.operation));
+      return false;
+    }
+    return true;
   };
-  const std::vector<char>* payload = nullptr;
-  if (is_payload) {
-    payload = &dm.buf;
-    if (payload->size() != hdr.payload_len) {
-      CAF_LOG_WARNING("received invalid payload");
-      return err();
+  // complete the frame left over from the previous read first
+  if (! pending.empty()) {
+    auto take = [&](size_t n) {
+      n = std::min(n, remaining);
+      pending.insert(pending.end(), first, first + n);
+      first += n;
+      remaining -= n;
+    };
+    if (pending.size() < header_size) {
+      take(header_size - pending.size());
+      if (pending.size() < header_size)
+        return await_header;
     }
-  } else {
-    binary_deserializer bd{dm.buf.data(), dm.buf.size(), &get_namespace()};
-    read_hdr(bd, hdr);
-    if (hdr.payload_len > 0)
+    if (! parse_hdr(pending.data()))
+      return drop_connection(dm.handle);
+    auto frame_size = header_size + hdr.payload_len;
+    take(frame_size - pending.size());
+    if (pending.size() < frame_size)
       return await_payload;
+    auto res = handle(dm.handle, hdr, pending.data() + header_size);
+    pending.clear();
+    if (res == close_connection)
+      return res;
   }
-  CAF_LOG_DEBUG("hdr = " << to_string(hdr));
-  if (! valid(hdr)) {
-    CAF_LOG_WARNING("received invalid header of type "
-                    << to_string(hdr.operation));
-    return err();
+  // handle all complete frames directly from the read buffer
+  while (remaining >= header_size) {
+    if (! parse_hdr(first))
+      return drop_connection(dm.handle);
+    auto frame_size = header_size + hdr.payload_len;
+    if (remaining < frame_size) {
+      pending.reserve(frame_size);
+      break;
+    }
+    if (handle(dm.handle, hdr, first + header_size) == close_connection)
+      return close_connection;
+    first += frame_size;
+    remaining -= frame_size;
   }
+  pending.insert(pending.end(), first, first + remaining);
+  return pending.size() < header_size ? await_header : await_payload;
+}
+
+connection_state instance::handle(const connection_handle& hdl,
+                                  const header& hdr, const char* payload) {
+  CAF_LOG_TRACE(CAF_ARG(hdl.id()));
+  CAF_LOG_DEBUG("hdr = " << to_string(hdr));
   // needs forwarding?
   if (! is_handshake(hdr) && hdr.dest_node != this_node_) {
     auto path = lookup(hdr.dest_node);
     if (path) {
-      binary_serializer bs{std::back_inserter(path->wr_buf), &get_namespace()};
-      write_hdr(bs, hdr);
-      if (payload)
-        bs.write_raw(payload->size(), payload->data());
+      // relay the frame as is, we only need its header for routing
+      auto frame = payload - header_size;
+      path->wr_buf.insert(path->wr_buf.end(), frame,
+                          payload + hdr.payload_len);
       tbl_.flush(*path);
-      notify<hook::message_forwarded>(hdr, payload);
+      if (callee_.get_middleman().has_hook()) {
+        std::vector<char> buf(payload, payload + hdr.payload_len);
+        notify<hook::message_forwarded>(hdr, hdr.payload_len > 0 ? &buf
+                                                                 : nullptr);
+      }
     } else {
       CAF_LOG_INFO("cannot forward message, no route to destination");
       if (hdr.source_node != this_node_) {
@@ -389,48 +499,50 @@ connection_state instance::handle(const new_data_msg& dm, header& hdr,
       } else {
         CAF_LOG_WARNING("lost packet with probably spoofed source");
       }
-      notify<hook::message_forwarding_failed>(hdr, payload);
+      if (callee_.get_middleman().has_hook()) {
+        std::vector<char> buf(payload, payload + hdr.payload_len);
+        notify<hook::message_forwarding_failed>(hdr, hdr.payload_len > 0
+                                                     ? &buf
+                                                     : nullptr);
+      }
     }
     return await_header;
   }
-  // function object for checking payload validity
-  auto payload_valid = [&]() -> bool {
-    return payload != nullptr && payload->size() == hdr.payload_len;
-  };
   // handle message to ourselves
   switch (hdr.operation) {
     case message_type::server_handshake: {
       actor_id aid = invalid_actor_id;
       std::set<std::string> sigs;
-      if (payload_valid()) {
-        binary_deserializer bd{payload->data(), payload->size(),
-                               &get_namespace()};
+      if (hdr.payload_len > 0) {
+        binary_deserializer bd{payload, hdr.payload_len, &get_namespace()};
         bd >> aid >> sigs;
       }
       // close self connection after handshake is done
       if (hdr.source_node == this_node_) {
         CAF_LOG_INFO("close connection to self immediately");
         callee_.finalize_handshake(hdr.source_node, aid, sigs);
-        return err();
+        return drop_connection(hdl);
       }
       // close this connection if we already have a direct connection
       if (tbl_.lookup_direct(hdr.source_node) != invalid_connection_handle) {
         CAF_LOG_INFO("close connection since we already have a "
                      "direct connection to " << to_string(hdr.source_node));
         callee_.finalize_handshake(hdr.source_node, aid, sigs);
-        return err();
+        return drop_connection(hdl);
       }
       // add direct route to this node and remove any indirect entry
       CAF_LOG_INFO("new direct connection: " << to_string(hdr.source_node));
-      tbl_.add_direct(dm.handle, hdr.source_node);
+      tbl_.add_direct(hdl, hdr.source_node);
       auto was_indirect = tbl_.erase_indirect(hdr.source_node);
       // write handshake as client in response
       auto path = tbl_.lookup(hdr.source_node);
       if (!path) {
         CAF_LOG_ERROR("no route to host after server handshake");
-        return err();
+        return drop_connection(hdl);
       }
       write_client_handshake(path->wr_buf, hdr.source_node);
+      if (shm_eligible(hdr.source_node))
+        offer_shm(hdl, hdr.source_node, path->wr_buf);
       callee_.learned_new_node_directly(hdr.source_node, was_indirect);
       callee_.finalize_handshake(hdr.source_node, aid, sigs);
       flush(*path);
@@ -444,25 +556,22 @@ connection_state instance::handle(const new_data_msg& dm, header& hdr,
       }
       // add direct route to this node and remove any indirect entry
       CAF_LOG_INFO("new direct connection: " << to_string(hdr.source_node));
-      tbl_.add_direct(dm.handle, hdr.source_node);
+      tbl_.add_direct(hdl, hdr.source_node);
       auto was_indirect = tbl_.erase_indirect(hdr.source_node);
       callee_.learned_new_node_directly(hdr.source_node, was_indirect);
       break;
     }
     case message_type::dispatch_message: {
-      if (! payload_valid())
-        return err();
       // in case the sender of this message was received via a third node,
       // we assume that that node to offers a route to the original source
-      auto last_hop = tbl_.lookup_direct(dm.handle);
+      auto last_hop = tbl_.lookup_direct(hdl);
       if (hdr.source_node != invalid_node_id
           && hdr.source_node != this_node_
           && last_hop != hdr.source_node
           && tbl_.lookup_direct(hdr.source_node) == invalid_connection_handle
           && tbl_.add_indirect(last_hop, hdr.source_node))
         callee_.learned_new_node_indirectly(hdr.source_node);
-      binary_deserializer bd{payload->data(), payload->size(),
-                             &get_namespace()};
+      binary_deserializer bd{payload, hdr.payload_len, &get_namespace()};
       message msg;
       msg.deserialize(bd);
       callee_.deliver(hdr.source_node, hdr.source_actor,
@@ -477,9 +586,13 @@ connection_state instance::handle(const new_data_msg& dm, header& hdr,
       callee_.kill_proxy(hdr.source_node, hdr.source_actor,
                          static_cast<uint32_t>(hdr.operation_data));
       break;
+    case message_type::shm_offer:
+    case message_type::shm_switch:
+      handle_shm(hdl, hdr);
+      break;
     default:
       CAF_LOG_ERROR("invalid operation");
-      return err();
+      return drop_connection(hdl);
   }
   return await_header;
 }
@@ -488,7 +601,9 @@ void instance::handle(const connection_closed_msg& msg) {
   auto cb = make_callback([&](const node_id& nid){
     callee_.purge_state(nid);
   });
+  auto nid = tbl_.lookup_direct(msg.handle);
   tbl_.erase_direct(msg.handle, cb);
+  close_shm(nid, msg.handle);
 }
 
 void instance::handle_node_shutdown(const node_id& affected_node) {
@@ -500,6 +615,7 @@ void instance::handle_node_shutdown(const node_id& affected_node) {
     callee_.purge_state(nid);
   });
   tbl_.erase(affected_node, cb);
+  close_shm(affected_node, invalid_connection_handle);
 }
 
 optional<routing_table::route> instance::lookup(const node_id& target) {
@@ -517,6 +633,11 @@ void instance::write(const routing_table::route& r, header& hdr,
   tbl_.flush(r);
 }
 
+connection_handle instance::shm_connection(const node_id& nid) const {
+  auto i = shm_links_.find(nid);
+  return i != shm_links_.end() ? i->second.shm : invalid_connection_handle;
+}
+
 void instance::add_published_actor(uint16_t port,
                                    actor_addr published_actor,
                                    std::set<std::string> published_interface) {
@@ -565,6 +686,26 @@ size_t instance::remove_published_actor(const actor_addr& whom, uint16_t port,
   return result;
 }
 
+bool instance::dispatch(const actor_addr& sender, const actor_addr& receiver,
+                        message_id mid, const message& msg,
+                        buffer_type& frame) {
+  CAF_LOG_TRACE("");
+  CAF_ASSERT(receiver.is_remote());
+  auto path = lookup(receiver->node());
+  if (! path) {
+    notify<hook::message_sending_failed>(sender, receiver, mid, msg);
+    return false;
+  }
+  if (path->wr_buf.empty()) {
+    path->wr_buf.swap(frame);
+  } else {
+    path->wr_buf.insert(path->wr_buf.end(), frame.begin(), frame.end());
+  }
+  flush(*path);
+  notify<hook::message_sent>(sender, path->next_hop, receiver, mid, msg);
+  return true;
+}
+
 bool instance::dispatch(const actor_addr& sender, const actor_addr& receiver,
                         message_id mid, const message& msg) {
   CAF_LOG_TRACE("");
@@ -595,38 +736,11 @@ void instance::write(buffer_type& buf,
                      actor_id source_actor,
                      actor_id dest_actor,
                      payload_writer* pw) {
-  if (! pw) {
-    binary_serializer bs{std::back_inserter(buf), &get_namespace()};
-    source_node.serialize(bs);
-    dest_node.serialize(bs);
-    bs.write(source_actor)
-      .write(dest_actor)
-      .write(uint32_t{0})
-      .write(static_cast<uint32_t>(operation))
-      .write(operation_data);
-  } else {
-    // reserve space in the buffer to write the payload later on
-    auto wr_pos = static_cast<ptrdiff_t>(buf.size());
-    char placeholder[basp::header_size];
-    buf.insert(buf.end(), std::begin(placeholder), std::end(placeholder));
-    auto pl_pos = buf.size();
-    { // lifetime scope of first serializer (write payload)
-      binary_serializer bs1{std::back_inserter(buf), &get_namespace()};
-      (*pw)(bs1);
-    }
-    // write broker message to the reserved space
-    binary_serializer bs2{buf.begin() + wr_pos, &get_namespace()};
-    auto plen = static_cast<uint32_t>(buf.size() - pl_pos);
-    source_node.serialize(bs2);
-    dest_node.serialize(bs2);
-    bs2.write(source_actor)
-       .write(dest_actor)
-       .write(plen)
-       .write(static_cast<uint32_t>(operation))
-       .write(operation_data);
-    if (payload_len)
-      *payload_len = plen;
-  }
+  header hdr{operation, 0, operation_data, source_node, dest_node,
+             source_actor, dest_actor};
+  write_frame(buf, get_namespace(), hdr, pw);
+  if (pw && payload_len)
+    *payload_len = hdr.payload_len;
 }
 
 void instance::write(buffer_type& buf, header& hdr, payload_writer* pw) {
@@ -666,11 +780,11 @@ void instance::write_dispatch_error(buffer_type& buf,
                                     const node_id& dest_node,
                                     error error_code,
                                     const header& original_hdr,
-                                    const buffer_type* payload) {
+                                    const char* payload) {
   auto writer = make_callback([&](serializer& sink) {
     write_hdr(sink, original_hdr);
-    if (payload)
-      sink.write_raw(payload->size(), payload->data());
+    if (original_hdr.payload_len > 0)
+      sink.write_raw(original_hdr.payload_len, payload);
   });
   header hdr{message_type::kill_proxy_instance, 0,
              static_cast<uint64_t>(error_code),
@@ -689,6 +803,109 @@ void instance::write_kill_proxy_instance(buffer_type& buf,
   write(buf, hdr);
 }
 
+connection_state instance::drop_connection(const connection_handle& hdl) {
+  auto cb = make_callback([&](const node_id& nid){
+    callee_.purge_state(nid);
+  });
+  auto nid = tbl_.lookup_direct(hdl);
+  tbl_.erase_direct(hdl, cb);
+  close_shm(nid, hdl);
+  return close_connection;
+}
+
+bool instance::shm_eligible(const node_id& nid) const {
+  return shm_enabled_
+         && nid.host_id() == this_node_.host_id()
+         && nid.process_id() != this_node_.process_id()
+         && shm_links_.count(nid) == 0
+         && tbl_.parent_->supports_shm();
+}
+
+void instance::offer_shm(const connection_handle& hdl, const node_id& nid,
+                         buffer_type& buf) {
+  CAF_LOG_TRACE(CAF_MARG(hdl, id) << ", " << CAF_TSARG(nid));
+  try {
+    auto res = tbl_.parent_->add_shm_scribe();
+    shm_links_.emplace(nid, shm_link{hdl, res.first, true});
+    write(buf, message_type::shm_offer, nullptr, res.second,
+          this_node_, nid, invalid_actor_id, invalid_actor_id);
+  }
+  catch (network_error& e) {
+    CAF_LOG_INFO("cannot offer shared memory channel: " << e.what());
+  }
+}
+
+void instance::handle_shm(const connection_handle& hdl, const header& hdr) {
+  CAF_LOG_TRACE(CAF_MARG(hdl, id) << ", " << CAF_TSARG(hdr));
+  auto& nid = hdr.source_node;
+  // writes the switch marker to the TCP connection
+  auto send_switch = [&](uint64_t accepted) {
+    auto& buf = tbl_.parent_->wr_buf(hdl);
+    write(buf, message_type::shm_switch, nullptr, accepted,
+          this_node_, nid, invalid_actor_id, invalid_actor_id);
+    tbl_.parent_->flush(hdl);
+  };
+  if (hdr.operation == message_type::shm_offer) {
+    if (tbl_.lookup_direct(nid) != hdl) {
+      CAF_LOG_WARNING("received shm_offer on a connection that "
+                      "is not the direct route to its source");
+      return;
+    }
+    if (! shm_eligible(nid)) {
+      send_switch(0);
+      return;
+    }
+    connection_handle shm_hdl;
+    try {
+      shm_hdl = tbl_.parent_->add_shm_scribe(nid.process_id(),
+                                             hdr.operation_data);
+    }
+    catch (network_error& e) {
+      CAF_LOG_INFO("cannot connect to shared memory channel: " << e.what());
+      send_switch(0);
+      return;
+    }
+    // all messages to `nid` after the switch use shared memory, but we
+    // read from the channel only after the client did switch as well
+    send_switch(1);
+    shm_links_.emplace(nid, shm_link{hdl, shm_hdl, false});
+    tbl_.replace_direct(shm_hdl, nid);
+    CAF_LOG_INFO("switched to shared memory for " << to_string(nid));
+    return;
+  }
+  auto i = shm_links_.find(nid);
+  if (i == shm_links_.end() || i->second.tcp != hdl) {
+    CAF_LOG_WARNING("received shm_switch without shared memory channel");
+    return;
+  }
+  auto& link = i->second;
+  if (link.offered) {
+    if (hdr.operation_data == 0) {
+      CAF_LOG_INFO("peer declined shared memory channel");
+      tbl_.parent_->close(link.shm);
+      shm_links_.erase(i);
+      return;
+    }
+    send_switch(1);
+    tbl_.replace_direct(link.shm, nid);
+    CAF_LOG_INFO("switched to shared memory for " << to_string(nid));
+  }
+  // we have processed everything the peer did send before switching
+  tbl_.parent_->configure_read(link.shm,
+                               receive_policy::at_most(max_read_size));
+}
+
+void instance::close_shm(const node_id& nid, const connection_handle& hdl) {
+  auto i = shm_links_.find(nid);
+  if (i == shm_links_.end())
+    return;
+  auto& parent = *tbl_.parent_;
+  for (auto& x : {i->second.tcp, i->second.shm})
+    if (x != hdl && parent.valid(x))
+      parent.close(x);
+  shm_links_.erase(i);
+}
+
 } // namespace basp
 } // namespace io
 } // namespace caf
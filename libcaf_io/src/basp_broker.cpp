@@ -24,11 +24,14 @@
 #include "caf/send.hpp"
 #include "caf/exception.hpp"
 #include "caf/make_counted.hpp"
+#include "caf/stateful_actor.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/forwarding_actor_proxy.hpp"
 
 #include "caf/experimental/whereis.hpp"
 
+#include "caf/scheduler/abstract_coordinator.hpp"
+
 #include "caf/detail/singletons.hpp"
 #include "caf/detail/actor_registry.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
@@ -44,6 +47,77 @@ using namespace caf::experimental;
 namespace caf {
 namespace io {
 
+/******************************************************************************
+ *                                 basp_shard                                 *
+ ******************************************************************************/
+
+namespace {
+
+struct basp_shard_state : actor_namespace::backend {
+  basp_shard_state() : ns(*this) {
+    // nop
+  }
+
+  actor_proxy_ptr make_proxy(const node_id&, actor_id) override {
+    // shards only serialize actor addresses, hence never create proxies
+    return nullptr;
+  }
+
+  actor_namespace ns;
+
+  const char* name = "basp_shard";
+};
+
+// Serializes messages from proxies into BASP frames on a scheduler worker.
+// The BASP broker then only needs to select a route for the resulting frame.
+behavior basp_shard(stateful_actor<basp_shard_state>* self, const actor& bb) {
+  auto this_node = detail::singletons::get_node_id();
+  return {
+    [=](forward_atom, const actor_addr& sender, const actor_addr& receiver,
+        message_id mid, const message& msg) {
+      CAF_LOGF_TRACE(CAF_TSARG(sender) << ", " << CAF_TSARG(receiver)
+                     << ", " << CAF_MARG(mid, integer_value)
+                     << ", " << CAF_TSARG(msg));
+      if (receiver == invalid_actor_addr || ! receiver.is_remote()) {
+        CAF_LOGF_WARNING("cannot forward to invalid or local actor: "
+                         << to_string(receiver));
+        return;
+      }
+      if (sender != invalid_actor_addr && ! sender.is_remote())
+        detail::singletons::get_actor_registry()->put(sender->id(), sender);
+      auto writer = make_callback([&](serializer& sink) {
+        msg.serialize(sink);
+      });
+      basp::header hdr{basp::message_type::dispatch_message, 0,
+                       mid.integer_value(),
+                       sender ? sender->node() : this_node, receiver->node(),
+                       sender ? sender->id() : invalid_actor_id,
+                       receiver->id()};
+      basp::buffer_type frame;
+      try {
+        basp::write_frame(frame, self->state.ns, hdr, &writer);
+      }
+      catch (std::exception& e) {
+        CAF_LOGF_ERROR("unable to serialize message: " << e.what());
+        if (mid.is_request()) {
+          detail::sync_request_bouncer srb{exit_reason::unhandled_exception};
+          srb(sender, mid);
+        }
+        return;
+      }
+      self->send(bb, forward_atom::value, sender, receiver, mid, msg,
+                 std::move(frame));
+    },
+    others >> [=] {
+      // e.g., `delete_atom` messages from destroyed proxies, which
+      // must not overtake messages previously sent to the proxy
+      self->forward_current_message(bb);
+    }
+  };
+}
+
+} // namespace <anonymous>
+
 /******************************************************************************
  *                             basp_broker_state                              *
  ******************************************************************************/
@@ -54,12 +128,19 @@ basp_broker_state::basp_broker_state(broker* selfptr)
       self(selfptr),
       instance(selfptr, *this) {
   CAF_ASSERT(this_node() != invalid_node_id);
+  intrusive_ptr<basp_broker> bb = static_cast<basp_broker*>(self);
+  auto sc = detail::singletons::get_scheduling_coordinator();
+  auto num_shards = std::max<size_t>(1, sc->num_workers());
+  for (size_t i = 0; i < num_shards; ++i)
+    shards.push_back(spawn<hidden>(basp_shard, actor{bb}));
 }
 
 basp_broker_state::~basp_broker_state() {
   // make sure all spawn servers are down
   for (auto& kvp : spawn_servers)
     anon_send_exit(kvp.second, exit_reason::kill);
+  for (auto& shard : shards)
+    anon_send_exit(shard, exit_reason::kill);
 }
 
 actor_proxy_ptr basp_broker_state::make_proxy(const node_id& nid,
@@ -89,7 +170,7 @@ actor_proxy_ptr basp_broker_state::make_proxy(const node_id& nid,
   // receive a kill_proxy_instance message
   intrusive_ptr<basp_broker> ptr = static_cast<basp_broker*>(self);
   auto mm = middleman::instance();
-  auto res = make_counted<forwarding_actor_proxy>(aid, nid, ptr);
+  auto res = make_counted<forwarding_actor_proxy>(aid, nid, shard_for(nid));
   res->attach_functor([=](uint32_t rsn) {
     mm->backend().post([=] {
       // using res->id() instead of aid keeps this actor instance alive
@@ -399,13 +480,11 @@ void basp_broker_state::set_context(connection_handle hdl) {
     i = ctx.emplace(hdl,
                     connection_context{
                       basp::await_header,
-                      basp::header{basp::message_type::server_handshake, 0, 0,
-                                   invalid_node_id, invalid_node_id,
-                                   invalid_actor_id, invalid_actor_id},
                       hdl,
                       invalid_node_id,
                       0,
-                      none}).first;
+                      none,
+                      basp::buffer_type{}}).first;
   }
   this_context = &i->second;
 }
@@ -425,6 +504,11 @@ bool basp_broker_state::erase_context(connection_handle hdl) {
   return true;
 }
 
+const actor& basp_broker_state::shard_for(const node_id& nid) {
+  CAF_ASSERT(! shards.empty());
+  return shards[std::hash<node_id>{}(nid) % shards.size()];
+}
+
 /******************************************************************************
  *                                basp_broker                                 *
  ******************************************************************************/
@@ -438,25 +522,33 @@ behavior basp_broker::make_behavior() {
   // ask the configuration server whether we should open a default port
   auto config_server = whereis(atom("ConfigServ"));
   send(config_server, get_atom::value, "global.enable-automatic-connections");
+  send(config_server, get_atom::value, "global.enable-shared-memory");
   return {
     // received from underlying broker implementation
     [=](new_data_msg& msg) {
       CAF_LOG_TRACE("handle = " << msg.handle.id());
       state.set_context(msg.handle);
       auto& ctx = *state.this_context;
-      auto next = state.instance.handle(msg, ctx.hdr,
-                                        ctx.cstate == basp::await_payload);
+      auto next = state.instance.handle(msg, ctx.pending);
       if (next == basp::close_connection) {
         close(msg.handle);
         state.ctx.erase(msg.handle);
-      } else if (next != ctx.cstate) {
-        auto rd_size = next == basp::await_payload
-                       ? ctx.hdr.payload_len
-                       : basp::header_size;
-        configure_read(msg.handle, receive_policy::exactly(rd_size));
+      } else {
         ctx.cstate = next;
       }
     },
+    // received from shards
+    [=](forward_atom, const actor_addr& sender, const actor_addr& receiver,
+        message_id mid, const message& msg, basp::buffer_type& frame) {
+      CAF_LOG_TRACE(CAF_TSARG(sender) << ", " << CAF_TSARG(receiver)
+                    << ", " << CAF_MARG(mid, integer_value)
+                    << ", " << CAF_TSARG(msg));
+      if (! state.instance.dispatch(sender, receiver, mid, msg, frame)
+          && mid.is_request()) {
+        detail::sync_request_bouncer srb{exit_reason::remote_link_unreachable};
+        srb(sender, mid);
+      }
+    },
     // received from proxy instances
     [=](forward_atom, const actor_addr& sender, const actor_addr& receiver,
         message_id mid, const message& msg) {
@@ -514,7 +606,7 @@ behavior basp_broker::make_behavior() {
       auto& bi = state.instance;
       bi.write_server_handshake(wr_buf(msg.handle), local_port(msg.source));
       flush(msg.handle);
-      configure_read(msg.handle, receive_policy::exactly(basp::header_size));
+      configure_read(msg.handle, receive_policy::at_most(basp::max_read_size));
     },
     // received from underlying broker implementation
     [=](const connection_closed_msg& msg) {
@@ -579,7 +671,7 @@ behavior basp_broker::make_behavior() {
       ctx.cstate = basp::await_header;
       ctx.callback = rp;
       // await server handshake
-      configure_read(hdl, receive_policy::exactly(basp::header_size));
+      configure_read(hdl, receive_policy::at_most(basp::max_read_size));
     },
     [=](delete_atom, const node_id& nid, actor_id aid) {
       CAF_LOG_TRACE(CAF_TSARG(nid) << ", " << CAF_ARG(aid));
@@ -640,6 +732,11 @@ behavior basp_broker::make_behavior() {
                make_message(port, std::move(addrs)));
           state.enable_automatic_connections = true;
         });
+      } else if (key == "global.enable-shared-memory") {
+        value.apply([&](bool enabled) {
+          CAF_LOG_INFO_IF(! enabled, "disable shared memory transport");
+          state.instance.enable_shm(enabled);
+        });
       }
     },
     // catch-all error handler
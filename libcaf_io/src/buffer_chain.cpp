@@ -0,0 +1,110 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/network/buffer_chain.hpp"
+
+#include "caf/make_counted.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+buffer_segment::buffer_segment(buffer_type buf) : buf_(std::move(buf)) {
+  // nop
+}
+
+buffer_segment::~buffer_segment() {
+  // nop
+}
+
+buffer_chain::buffer_chain() : offset_(0), size_(0) {
+  // nop
+}
+
+void buffer_chain::append(buffer_segment_ptr ptr) {
+  if (! ptr || ptr->buf().empty()) {
+    return;
+  }
+  size_ += ptr->buf().size();
+  segments_.push_back(std::move(ptr));
+}
+
+void buffer_chain::append(buffer_type& buf) {
+  if (buf.empty()) {
+    return;
+  }
+  size_ += buf.size();
+  segments_.push_back(make_counted<buffer_segment>(std::move(buf)));
+  if (spare_.empty()) {
+    buf = buffer_type{};
+  } else {
+    buf.swap(spare_.back());
+    spare_.pop_back();
+  }
+}
+
+size_t buffer_chain::prepare(write_chunk* chunks, size_t max_chunks) const {
+  size_t result = 0;
+  auto offset = offset_;
+  for (auto i = segments_.begin();
+       i != segments_.end() && result < max_chunks; ++i) {
+    auto& buf = (*i)->buf();
+    chunks[result].data = buf.data() + offset;
+    chunks[result].size = buf.size() - offset;
+    ++result;
+    offset = 0;
+  }
+  return result;
+}
+
+void buffer_chain::consume(size_t num_bytes) {
+  size_ -= num_bytes;
+  while (num_bytes > 0) {
+    auto& front = segments_.front();
+    auto remaining = front->buf().size() - offset_;
+    if (num_bytes < remaining) {
+      offset_ += num_bytes;
+      return;
+    }
+    num_bytes -= remaining;
+    offset_ = 0;
+    recycle(front);
+    segments_.pop_front();
+  }
+}
+
+void buffer_chain::clear() {
+  segments_.clear();
+  offset_ = 0;
+  size_ = 0;
+}
+
+void buffer_chain::recycle(buffer_segment_ptr& ptr) {
+  // shared segments might still be in use by other streams
+  if (! ptr->unique() || spare_.size() >= max_spare_buffers
+      || ptr->buf().capacity() > max_spare_capacity) {
+    return;
+  }
+  ptr->buf().clear();
+  spare_.push_back(std::move(ptr->buf()));
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
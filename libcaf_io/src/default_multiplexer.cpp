@@ -19,7 +19,10 @@
 
 #include "caf/io/network/default_multiplexer.hpp"
 
+#include <atomic>
+
 #include "caf/config.hpp"
+#include "caf/metrics.hpp"
 #include "caf/optional.hpp"
 #include "caf/exception.hpp"
 #include "caf/make_counted.hpp"
@@ -29,6 +32,7 @@
 
 #include "caf/io/network/protocol.hpp"
 #include "caf/io/network/interfaces.hpp"
+#include "caf/io/network/shared_memory.hpp"
 
 #ifdef CAF_WINDOWS
 # include <winsock2.h>
@@ -38,7 +42,9 @@
 #else
 # include <errno.h>
 # include <netdb.h>
+# include <limits.h>
 # include <fcntl.h>
+# include <sys/uio.h>
 # include <sys/types.h>
 # include <arpa/inet.h>
 # include <sys/socket.h>
@@ -58,6 +64,15 @@ namespace {
   constexpr int no_sigpipe_flag = MSG_NOSIGNAL;
 #endif
 
+#ifndef CAF_WINDOWS
+  // maximum number of buffers passed to a single `sendmsg` call
+# if defined(IOV_MAX) && IOV_MAX < 64
+  constexpr size_t max_iov = IOV_MAX;
+# else
+  constexpr size_t max_iov = 64;
+# endif
+#endif
+
 // safe ourselves some typing
 constexpr auto ipv4 = caf::io::network::protocol::ipv4;
 constexpr auto ipv6 = caf::io::network::protocol::ipv6;
@@ -843,6 +858,119 @@ default_multiplexer::add_tcp_doorman(abstract_broker* self,
   return ptr->hdl();
 }
 
+#ifdef CAF_LINUX
+
+namespace {
+
+// maximum time for waiting on a peer offering a shared memory channel
+constexpr int shm_connect_timeout_ms = 1000;
+
+class shm_scribe : public scribe {
+public:
+  shm_scribe(abstract_broker* ptr, default_multiplexer& dm, shm_channel ch,
+             native_socket listener_fd = invalid_native_socket)
+      : scribe(ptr, connection_handle::from_int(
+                      int64_from_native_socket(ch.bell()))),
+        launched_(false),
+        stream_(dm, std::move(ch)) {
+    if (listener_fd != invalid_native_socket)
+      listener_.reset(new shm_listener(dm, listener_fd, stream_.channel()));
+  }
+  void configure_read(receive_policy::config config) override {
+    CAF_LOG_TRACE("");
+    stream_.configure_read(config);
+    if (! launched_) launch();
+  }
+  std::vector<char>& wr_buf() override {
+    return stream_.wr_buf();
+  }
+  std::vector<char>& rd_buf() override {
+    return stream_.rd_buf();
+  }
+  void stop_reading() override {
+    CAF_LOG_TRACE("");
+    stream_.stop_reading();
+    if (listener_)
+      listener_->stop();
+    detach(false);
+  }
+  void flush() override {
+    CAF_LOG_TRACE("");
+    stream_.flush(this);
+  }
+  std::string addr() const override {
+    return "localhost";
+  }
+  uint16_t port() const override {
+    return 0;
+  }
+  void launch() {
+    CAF_LOG_TRACE("");
+    CAF_ASSERT(! launched_);
+    launched_ = true;
+    stream_.start(this);
+  }
+  // waits for the peer to connect to our listener
+  void offer() {
+    CAF_ASSERT(listener_ != nullptr);
+    listener_->start(this);
+  }
+private:
+  bool launched_;
+  shm_stream stream_;
+  std::unique_ptr<shm_listener> listener_;
+};
+
+} // namespace <anonymous>
+
+bool default_multiplexer::supports_shm() const {
+  return true;
+}
+
+std::pair<connection_handle, uint64_t>
+default_multiplexer::add_shm_scribe(abstract_broker* self) {
+  CAF_LOG_TRACE("");
+  // tokens are unique per process, since all event loops share the
+  // abstract namespace for UNIX domain sockets
+  static std::atomic<uint64_t> next_token{0};
+  auto token = ++next_token;
+  auto ch = shm_channel::create();
+  auto fd = new_shm_listener(token);
+  auto ptr = make_counted<shm_scribe>(self, *this, std::move(ch), fd);
+  self->add_scribe(ptr);
+  ptr->offer();
+  return {ptr->hdl(), token};
+}
+
+connection_handle default_multiplexer::add_shm_scribe(abstract_broker* self,
+                                                      uint32_t pid,
+                                                      uint64_t token) {
+  CAF_LOG_TRACE(CAF_ARG(pid) << ", " << CAF_ARG(token));
+  auto ch = connect_shm_channel(pid, token, shm_connect_timeout_ms);
+  auto ptr = make_counted<shm_scribe>(self, *this, std::move(ch));
+  self->add_scribe(ptr);
+  return ptr->hdl();
+}
+
+#else // CAF_LINUX
+
+bool default_multiplexer::supports_shm() const {
+  return false;
+}
+
+std::pair<connection_handle, uint64_t>
+default_multiplexer::add_shm_scribe(abstract_broker* self) {
+  return multiplexer::add_shm_scribe(self);
+}
+
+connection_handle default_multiplexer::add_shm_scribe(abstract_broker* self,
+                                                      uint32_t pid,
+                                                      uint64_t token) {
+  return multiplexer::add_shm_scribe(self, pid, token);
+}
+
+#endif // CAF_LINUX
+
 connection_handle default_multiplexer::new_tcp_scribe(const std::string& host,
                                                       uint16_t port) {
   auto fd = new_tcp_connection_impl(host, port);
@@ -866,7 +994,9 @@ connection_handle default_multiplexer::add_tcp_scribe(abstract_broker* self,
                                                       uint16_t port) {
   CAF_LOG_TRACE(CAF_ARG(self) << ", " << CAF_ARG(host)
                 << ", " << CAF_ARG(port));
-  return add_tcp_scribe(self, new_tcp_connection(host, port));
+  // bind the socket to this multiplexer rather than to the singleton,
+  // since the middleman may run multiple event loops
+  return add_tcp_scribe(self, new_tcp_connection_impl(host, port));
 }
 
 std::pair<accept_handle, uint16_t>
@@ -889,9 +1019,9 @@ accept_handle default_multiplexer::add_tcp_doorman(abstract_broker* self,
 std::pair<accept_handle, uint16_t>
 default_multiplexer::add_tcp_doorman(abstract_broker* self, uint16_t port,
                                      const char* host, bool reuse_addr) {
-  auto acceptor = new_tcp_acceptor(port, host, reuse_addr);
+  auto acceptor = new_tcp_acceptor_impl(port, host, reuse_addr);
   auto bound_port = acceptor.second;
-  return {add_tcp_doorman(self, std::move(acceptor.first)), bound_port};
+  return {add_tcp_doorman(self, acceptor.first), bound_port};
 }
 
 /******************************************************************************
@@ -918,9 +1048,24 @@ bool is_error(ssize_t res, bool is_nonblock) {
   return false;
 }
 
+namespace {
+
+// counts a socket operation that returned `res`
+inline void count_io(metrics::counter_id calls, metrics::counter_id bytes,
+                     ssize_t res) {
+  if (! metrics::enabled())
+    return;
+  metrics::add(calls);
+  if (res > 0)
+    metrics::add(bytes, static_cast<uint64_t>(res));
+}
+
+} // namespace <anonymous>
+
 bool read_some(size_t& result, native_socket fd, void* buf, size_t len) {
   CAF_LOGF_TRACE(CAF_ARG(fd) << ", " << CAF_ARG(len));
   auto sres = ::recv(fd, reinterpret_cast<socket_recv_ptr>(buf), len, 0);
+  count_io(metrics::net_read_calls, metrics::net_bytes_read, sres);
   CAF_LOGF_DEBUG("tried to read " << len << " bytes from socket " << fd
                                   << ", recv returned " << sres);
   if (is_error(sres, true) || sres == 0) {
@@ -935,6 +1080,7 @@ bool write_some(size_t& result, native_socket fd, const void* buf, size_t len) {
   CAF_LOGF_TRACE(CAF_ARG(fd) << ", " << CAF_ARG(len));
   auto sres = ::send(fd, reinterpret_cast<socket_send_ptr>(buf),
                      len, no_sigpipe_flag);
+  count_io(metrics::net_write_calls, metrics::net_bytes_written, sres);
   CAF_LOGF_DEBUG("tried to write " << len << " bytes to socket " << fd
                                    << ", send returned " << sres);
   if (is_error(sres, true))
@@ -943,6 +1089,43 @@ bool write_some(size_t& result, native_socket fd, const void* buf, size_t len) {
   return true;
 }
 
+bool write_some(size_t& result, native_socket fd,
+                const write_chunk* chunks, size_t num_chunks) {
+  CAF_LOGF_TRACE(CAF_ARG(fd) << ", " << CAF_ARG(num_chunks));
+  if (num_chunks == 0) {
+    result = 0;
+    return true;
+  }
+# ifdef CAF_WINDOWS
+  // WSASend would require WSABUF arrays, fall back to a single send
+  return write_some(result, fd, chunks[0].data, chunks[0].size);
+# else
+  if (num_chunks == 1) {
+    return write_some(result, fd, chunks[0].data, chunks[0].size);
+  }
+  iovec iov[max_iov];
+  if (num_chunks > max_iov) {
+    num_chunks = max_iov;
+  }
+  for (size_t i = 0; i < num_chunks; ++i) {
+    iov[i].iov_base = const_cast<char*>(chunks[i].data);
+    iov[i].iov_len = chunks[i].size;
+  }
+  msghdr msg;
+  memset(&msg, 0, sizeof(msghdr));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = num_chunks;
+  auto sres = ::sendmsg(fd, &msg, no_sigpipe_flag);
+  count_io(metrics::net_write_calls, metrics::net_bytes_written, sres);
+  CAF_LOGF_DEBUG("tried to write " << num_chunks << " chunks to socket " << fd
+                                   << ", sendmsg returned " << sres);
+  if (is_error(sres, true))
+    return false;
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return true;
+# endif
+}
+
 bool try_accept(native_socket& result, native_socket fd) {
   CAF_LOGF_TRACE(CAF_ARG(fd));
   sockaddr_storage addr;
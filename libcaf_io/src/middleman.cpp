@@ -242,6 +242,19 @@ middleman* middleman::instance() {
   return static_cast<middleman*>(res);
 }
 
+network::multiplexer& middleman::next_backend() {
+  if (backends_.size() == 1) {
+    return backend();
+  }
+  auto tid = std::this_thread::get_id();
+  for (auto& backend : backends_) {
+    if (backend->thread_id() == tid) {
+      return *backend;
+    }
+  }
+  return *backends_[next_backend_++ % backends_.size()];
+}
+
 void middleman::add_broker(broker_ptr bptr) {
   brokers_.insert(bptr);
   bptr->attach_functor([=](uint32_t) { brokers_.erase(bptr); });
@@ -251,17 +264,21 @@ void middleman::initialize() {
   CAF_LOG_TRACE("");
   auto sc = detail::singletons::get_scheduling_coordinator();
   max_throughput_ = sc->max_throughput();
-  backend_supervisor_ = backend_->make_supervisor();
-  if (backend_supervisor_ == nullptr) {
-    // the only backend that returns a `nullptr` is the `test_multiplexer`
-    // which does not have its own thread but uses the main thread instead
-    backend_->thread_id(std::this_thread::get_id());
-  } else {
-    thread_ = std::thread{[this] {
-      CAF_LOG_TRACE("");
-      backend_->run();
-    }};
-    backend_->thread_id(thread_.get_id());
+  for (auto& backend : backends_) {
+    auto sv = backend->make_supervisor();
+    if (sv == nullptr) {
+      // the only backend that returns a `nullptr` is the `test_multiplexer`
+      // which does not have its own thread but uses the main thread instead
+      backend->thread_id(std::this_thread::get_id());
+    } else {
+      auto ptr = backend.get();
+      threads_.emplace_back([ptr] {
+        CAF_LOGF_TRACE("");
+        ptr->run();
+      });
+      ptr->thread_id(threads_.back().get_id());
+      backend_supervisors_.push_back(std::move(sv));
+    }
   }
   // announce io-related types
   announce<network::protocol>("caf::io::network::protocol");
@@ -283,7 +300,7 @@ void middleman::initialize() {
 
 void middleman::stop() {
   CAF_LOG_TRACE("");
-  backend_->dispatch([=] {
+  backend().dispatch([=] {
     CAF_LOG_TRACE("");
     notify<hook::before_shutdown>();
     // managers_ will be modified while we are stopping each manager,
@@ -296,9 +313,12 @@ void middleman::stop() {
       }
     }
   });
-  backend_supervisor_.reset();
-  if (thread_.joinable())
-    thread_.join();
+  backend_supervisors_.clear();
+  for (auto& t : threads_) {
+    if (t.joinable()) {
+      t.join();
+    }
+  }
   hooks_.reset();
   named_brokers_.clear();
   scoped_actor self(true);
@@ -315,10 +335,15 @@ void middleman::dispose() {
   delete this;
 }
 
-middleman::middleman(const backend_factory& factory)
-    : backend_(factory()),
+middleman::middleman(const backend_factory& factory, size_t num_backends)
+    : next_backend_(0),
       max_throughput_(std::numeric_limits<size_t>::max()) {
-  // nop
+  if (num_backends == 0) {
+    num_backends = 1;
+  }
+  for (size_t i = 0; i < num_backends; ++i) {
+    backends_.push_back(factory());
+  }
 }
 
 middleman::~middleman() {
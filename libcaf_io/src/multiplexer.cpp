@@ -41,6 +41,20 @@ boost::asio::io_service* multiplexer::pimpl() {
   return nullptr;
 }
 
+bool multiplexer::supports_shm() const {
+  return false;
+}
+
+std::pair<connection_handle, uint64_t>
+multiplexer::add_shm_scribe(abstract_broker*) {
+  throw network_error("shared memory not supported by this multiplexer");
+}
+
+connection_handle multiplexer::add_shm_scribe(abstract_broker*, uint32_t,
+                                              uint64_t) {
+  throw network_error("shared memory not supported by this multiplexer");
+}
+
 multiplexer::supervisor::~supervisor() {
   // nop
 }
@@ -22,11 +22,9 @@
 namespace caf {
 namespace io {
 
-void set_middleman(network::multiplexer* multiplexer_ptr) {
-  middleman::backend_pointer uptr;
-  uptr.reset(multiplexer_ptr);
-  auto fac = [&uptr] { return std::move(uptr); };
-  auto mm = new middleman(fac);
+namespace {
+
+void set_middleman_instance(middleman* mm) {
   auto getter = [mm] { return mm; };
   auto sid = detail::singletons::middleman_plugin_id;
   auto res = detail::singletons::get_plugin_singleton(sid, getter);
@@ -36,5 +34,23 @@ void set_middleman(network::multiplexer* multiplexer_ptr) {
   }
 }
 
+} // namespace <anonymous>
+
+void set_middleman(network::multiplexer* multiplexer_ptr) {
+  middleman::backend_pointer uptr;
+  uptr.reset(multiplexer_ptr);
+  auto fac = [&uptr] { return std::move(uptr); };
+  set_middleman_instance(new middleman(fac));
+}
+
+void set_middleman(const middleman::backend_factory& factory,
+                   size_t num_event_loops) {
+  set_middleman_instance(new middleman(factory, num_event_loops));
+}
+
+void set_middleman(size_t num_event_loops) {
+  set_middleman(network::multiplexer::make, num_event_loops);
+}
+
 } // namespace io
 } // namespace caf
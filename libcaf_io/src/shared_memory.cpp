@@ -0,0 +1,573 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/io/network/shared_memory.hpp"
+
+#ifdef CAF_LINUX
+
+#include <new>
+#include <string>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stddef.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+
+#include "caf/exception.hpp"
+
+#include "caf/detail/logging.hpp"
+#include "caf/detail/scope_guard.hpp"
+
+namespace caf {
+namespace io {
+namespace network {
+
+namespace {
+
+[[noreturn]] void throw_shm_error(std::string what) {
+  what += ": ";
+  what += strerror(errno);
+  throw network_error(std::move(what));
+}
+
+// name of the abstract UNIX domain socket serving channel `token` of `pid`
+socklen_t shm_listener_address(sockaddr_un& addr, uint32_t pid,
+                               uint64_t token) {
+  memset(&addr, 0, sizeof(sockaddr_un));
+  addr.sun_family = AF_UNIX;
+  auto name = "caf-shm-" + std::to_string(pid) + "-" + std::to_string(token);
+  // leading zero byte selects the abstract namespace
+  memcpy(addr.sun_path + 1, name.data(), name.size());
+  return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1
+                                + name.size());
+}
+
+} // namespace <anonymous>
+
+/******************************************************************************
+ *                                  shm_ring                                  *
+ ******************************************************************************/
+
+shm_ring::shm_ring() : hdr_(nullptr), data_(nullptr), capacity_(0) {
+  // nop
+}
+
+shm_ring::shm_ring(void* region, size_t capacity)
+    : hdr_(reinterpret_cast<shm_ring_header*>(region)),
+      data_(reinterpret_cast<char*>(region) + sizeof(shm_ring_header)),
+      capacity_(capacity) {
+  CAF_ASSERT((capacity & (capacity - 1)) == 0);
+}
+
+size_t shm_ring::region_size(size_t capacity) {
+  return sizeof(shm_ring_header) + capacity;
+}
+
+void shm_ring::init() {
+  new (hdr_) shm_ring_header;
+  hdr_->head.store(0, std::memory_order_relaxed);
+  hdr_->tail.store(0, std::memory_order_relaxed);
+  hdr_->producer_waiting.store(0, std::memory_order_relaxed);
+}
+
+size_t shm_ring::write(const void* buf, size_t len, bool& wakeup) {
+  wakeup = false;
+  auto head = hdr_->head.load(std::memory_order_relaxed);
+  auto tail = hdr_->tail.load(std::memory_order_acquire);
+  auto n = std::min(len, capacity_ - static_cast<size_t>(head - tail));
+  if (n == 0)
+    return 0;
+  auto pos = static_cast<size_t>(head) & (capacity_ - 1);
+  auto first = std::min(n, capacity_ - pos);
+  auto src = reinterpret_cast<const char*>(buf);
+  memcpy(data_ + pos, src, first);
+  memcpy(data_, src + first, n - first);
+  hdr_->head.store(head + n, std::memory_order_seq_cst);
+  // the consumer might sleep if it already read everything before our
+  // write; pairs with the store to `tail` followed by a load of `head`
+  // in `read`, i.e., at least one side sees the update of the other
+  wakeup = hdr_->tail.load(std::memory_order_seq_cst) == head;
+  return n;
+}
+
+size_t shm_ring::read(void* buf, size_t len, bool& wakeup) {
+  wakeup = false;
+  auto tail = hdr_->tail.load(std::memory_order_relaxed);
+  auto head = hdr_->head.load(std::memory_order_seq_cst);
+  auto n = std::min(len, static_cast<size_t>(head - tail));
+  if (n == 0)
+    return 0;
+  auto pos = static_cast<size_t>(tail) & (capacity_ - 1);
+  auto first = std::min(n, capacity_ - pos);
+  auto dst = reinterpret_cast<char*>(buf);
+  memcpy(dst, data_ + pos, first);
+  memcpy(dst + first, data_, n - first);
+  hdr_->tail.store(tail + n, std::memory_order_seq_cst);
+  if (hdr_->producer_waiting.load(std::memory_order_seq_cst) != 0)
+    wakeup = hdr_->producer_waiting.exchange(0) != 0;
+  return n;
+}
+
+bool shm_ring::await_space() {
+  hdr_->producer_waiting.store(1, std::memory_order_seq_cst);
+  auto head = hdr_->head.load(std::memory_order_relaxed);
+  auto tail = hdr_->tail.load(std::memory_order_seq_cst);
+  return static_cast<size_t>(head - tail) < capacity_;
+}
+
+size_t shm_ring::size() const {
+  auto tail = hdr_->tail.load(std::memory_order_relaxed);
+  auto head = hdr_->head.load(std::memory_order_seq_cst);
+  return static_cast<size_t>(head - tail);
+}
+
+/******************************************************************************
+ *                                shm_channel                                 *
+ ******************************************************************************/
+
+shm_channel::shm_channel()
+    : mem_fd_(-1),
+      bell_(invalid_native_socket),
+      peer_bell_(invalid_native_socket),
+      region_(nullptr),
+      region_size_(0) {
+  // nop
+}
+
+shm_channel::shm_channel(shm_channel&& other) : shm_channel() {
+  *this = std::move(other);
+}
+
+shm_channel& shm_channel::operator=(shm_channel&& other) {
+  using std::swap;
+  swap(mem_fd_, other.mem_fd_);
+  swap(bell_, other.bell_);
+  swap(peer_bell_, other.peer_bell_);
+  swap(region_, other.region_);
+  swap(region_size_, other.region_size_);
+  swap(input_, other.input_);
+  swap(output_, other.output_);
+  return *this;
+}
+
+shm_channel::~shm_channel() {
+  close_all();
+}
+
+shm_channel shm_channel::create(size_t capacity) {
+  CAF_LOGF_TRACE(CAF_ARG(capacity));
+  shm_channel result;
+  result.mem_fd_ = memfd_create("caf-shm", MFD_CLOEXEC);
+  if (result.mem_fd_ < 0)
+    throw_shm_error("memfd_create");
+  auto region_size = shm_ring::region_size(capacity) * 2;
+  if (ftruncate(result.mem_fd_, static_cast<off_t>(region_size)) != 0)
+    throw_shm_error("ftruncate");
+  result.bell_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  result.peer_bell_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (result.bell_ < 0 || result.peer_bell_ < 0)
+    throw_shm_error("eventfd");
+  result.map(region_size, true);
+  return result;
+}
+
+bool shm_channel::send(native_socket fd) const {
+  // the doorbells swap roles on the other end
+  int fds[3] = {mem_fd_, peer_bell_, bell_};
+  char dummy = 0;
+  iovec iov;
+  iov.iov_base = &dummy;
+  iov.iov_len = 1;
+  union {
+    char buf[CMSG_SPACE(sizeof(fds))];
+    cmsghdr align;
+  } ctrl;
+  memset(&ctrl, 0, sizeof(ctrl));
+  msghdr msg;
+  memset(&msg, 0, sizeof(msghdr));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrl.buf;
+  msg.msg_controllen = sizeof(ctrl.buf);
+  auto cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+  return ::sendmsg(fd, &msg, MSG_NOSIGNAL) == 1;
+}
+
+shm_channel shm_channel::receive(native_socket fd) {
+  CAF_LOGF_TRACE(CAF_ARG(fd));
+  int fds[3];
+  char dummy;
+  iovec iov;
+  iov.iov_base = &dummy;
+  iov.iov_len = 1;
+  union {
+    char buf[CMSG_SPACE(sizeof(fds))];
+    cmsghdr align;
+  } ctrl;
+  msghdr msg;
+  memset(&msg, 0, sizeof(msghdr));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = ctrl.buf;
+  msg.msg_controllen = sizeof(ctrl.buf);
+  if (::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC) != 1)
+    throw_shm_error("recvmsg");
+  auto cmsg = CMSG_FIRSTHDR(&msg);
+  if (! cmsg || cmsg->cmsg_type != SCM_RIGHTS
+      || cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+    throw network_error("recvmsg: no file descriptors received");
+  memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  shm_channel result;
+  result.mem_fd_ = fds[0];
+  result.bell_ = fds[1];
+  result.peer_bell_ = fds[2];
+  struct stat st;
+  if (fstat(result.mem_fd_, &st) != 0)
+    throw_shm_error("fstat");
+  result.map(static_cast<size_t>(st.st_size), false);
+  return result;
+}
+
+void shm_channel::ring_peer() {
+  uint64_t one = 1;
+  // EAGAIN means the counter is saturated, i.e., the peer wakes up anyway
+  auto res = ::write(peer_bell_, &one, sizeof(one));
+  static_cast<void>(res);
+}
+
+void shm_channel::ring_self() {
+  uint64_t one = 1;
+  auto res = ::write(bell_, &one, sizeof(one));
+  static_cast<void>(res);
+}
+
+void shm_channel::clear_bell() {
+  uint64_t value;
+  auto res = ::read(bell_, &value, sizeof(value));
+  static_cast<void>(res);
+}
+
+void shm_channel::map(size_t region_size, bool creator) {
+  region_ = mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                 mem_fd_, 0);
+  if (region_ == MAP_FAILED) {
+    region_ = nullptr;
+    throw_shm_error("mmap");
+  }
+  region_size_ = region_size;
+  auto capacity = region_size / 2 - sizeof(shm_ring_header);
+  auto first = region_;
+  auto second = reinterpret_cast<char*>(region_)
+                + shm_ring::region_size(capacity);
+  // the creator writes to the first ring and reads from the second one
+  if (creator) {
+    output_ = shm_ring{first, capacity};
+    input_ = shm_ring{second, capacity};
+    output_.init();
+    input_.init();
+  } else {
+    input_ = shm_ring{first, capacity};
+    output_ = shm_ring{second, capacity};
+  }
+}
+
+void shm_channel::close_all() {
+  if (region_)
+    munmap(region_, region_size_);
+  for (auto fd : {mem_fd_, bell_, peer_bell_})
+    if (fd >= 0)
+      ::close(fd);
+  mem_fd_ = -1;
+  bell_ = invalid_native_socket;
+  peer_bell_ = invalid_native_socket;
+  region_ = nullptr;
+  region_size_ = 0;
+}
+
+/******************************************************************************
+ *                              free functions                                *
+ ******************************************************************************/
+
+native_socket new_shm_listener(uint64_t token) {
+  CAF_LOGF_TRACE(CAF_ARG(token));
+  auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    throw_shm_error("socket");
+  sockaddr_un addr;
+  auto len = shm_listener_address(addr, static_cast<uint32_t>(getpid()),
+                                  token);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), len) != 0
+      || ::listen(fd, 1) != 0) {
+    ::close(fd);
+    throw_shm_error("cannot listen for shared memory peer");
+  }
+  return fd;
+}
+
+shm_channel connect_shm_channel(uint32_t pid, uint64_t token,
+                                int timeout_ms) {
+  CAF_LOGF_TRACE(CAF_ARG(pid) << ", " << CAF_ARG(token));
+  auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    throw_shm_error("socket");
+  auto guard = detail::make_scope_guard([&] {
+    ::close(fd);
+  });
+  sockaddr_un addr;
+  auto len = shm_listener_address(addr, pid, token);
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), len) != 0)
+    throw_shm_error("cannot connect to shared memory peer");
+  // the peer sends the channel once its event loop accepts our connection
+  pollfd pfd{fd, POLLIN, 0};
+  int res;
+  do {
+    res = ::poll(&pfd, 1, timeout_ms);
+  } while (res < 0 && errno == EINTR);
+  if (res == 0)
+    throw network_error("shared memory peer did not respond in time");
+  if (res < 0)
+    throw_shm_error("poll");
+  return shm_channel::receive(fd);
+}
+
+/******************************************************************************
+ *                                 shm_stream                                 *
+ ******************************************************************************/
+
+shm_stream::shm_stream(default_multiplexer& backend_ref, shm_channel channel)
+    : event_handler(backend_ref),
+      channel_(std::move(channel)),
+      reading_(false),
+      threshold_(1),
+      collected_(0),
+      wr_pending_offset_(0) {
+  configure_read(receive_policy::at_most(1024));
+}
+
+void shm_stream::start(const manager_ptr& mgr) {
+  CAF_ASSERT(mgr != nullptr);
+  reader_ = mgr;
+  reading_ = true;
+  backend().add(operation::read, fd(), this);
+  read_loop();
+  // the peer may have written data before we started listening
+  channel_.ring_self();
+}
+
+void shm_stream::configure_read(receive_policy::config config) {
+  rd_flag_ = config.first;
+  max_ = config.second;
+}
+
+void shm_stream::flush(const manager_ptr&) {
+  CAF_LOG_TRACE("offline buf size: " << wr_offline_buf_.size()
+                << ", pending bytes: "
+                << (wr_pending_.size() - wr_pending_offset_));
+  if (! wr_offline_buf_.empty()) {
+    if (wr_pending_.empty()) {
+      wr_pending_.swap(wr_offline_buf_);
+      wr_pending_offset_ = 0;
+    } else {
+      wr_pending_.insert(wr_pending_.end(), wr_offline_buf_.begin(),
+                         wr_offline_buf_.end());
+      wr_offline_buf_.clear();
+    }
+  }
+  write_pending();
+}
+
+void shm_stream::stop_reading() {
+  CAF_LOG_TRACE("");
+  reading_ = false;
+  backend().del(operation::read, fd(), this);
+}
+
+void shm_stream::handle_event(operation op) {
+  CAF_LOG_TRACE("op = " << static_cast<int>(op));
+  switch (op) {
+    case operation::read: {
+      // reset the doorbell *before* checking the rings to not miss
+      // any notification that arrives while we are reading
+      channel_.clear_bell();
+      write_pending();
+      auto& in = channel_.input();
+      bool wakeup = false;
+      for (size_t i = 0; i < max_reads_per_event && reading_; ++i) {
+        bool wk;
+        auto rb = in.read(rd_buf_.data() + collected_,
+                          rd_buf_.size() - collected_, wk);
+        wakeup = wakeup || wk;
+        if (rb == 0)
+          break;
+        collected_ += rb;
+        if (collected_ >= threshold_) {
+          if (wakeup) {
+            // let the peer continue writing while we process the data
+            channel_.ring_peer();
+            wakeup = false;
+          }
+          reader_->consume(rd_buf_.data(), collected_);
+          read_loop();
+        }
+      }
+      if (wakeup)
+        channel_.ring_peer();
+      if (reading_ && ! in.empty())
+        channel_.ring_self();
+      break;
+    }
+    case operation::write:
+      // we never register for write events
+      break;
+    case operation::propagate_error:
+      if (reader_)
+        reader_->io_failure(operation::read);
+      break;
+  }
+}
+
+void shm_stream::removed_from_loop(operation op) {
+  if (op == operation::read)
+    reader_.reset();
+}
+
+native_socket shm_stream::fd() const {
+  return channel_.bell();
+}
+
+void shm_stream::read_loop() {
+  collected_ = 0;
+  switch (rd_flag_) {
+    case receive_policy_flag::exactly:
+      if (rd_buf_.size() != max_)
+        rd_buf_.resize(max_);
+      threshold_ = max_;
+      break;
+    case receive_policy_flag::at_most:
+      if (rd_buf_.size() != max_)
+        rd_buf_.resize(max_);
+      threshold_ = 1;
+      break;
+    case receive_policy_flag::at_least: {
+      // read up to 10% more, but at least allow 100 bytes more
+      auto max_size = max_ + std::max<size_t>(100, max_ / 10);
+      if (rd_buf_.size() != max_size)
+        rd_buf_.resize(max_size);
+      threshold_ = max_;
+      break;
+    }
+  }
+}
+
+void shm_stream::write_pending() {
+  auto& out = channel_.output();
+  bool wakeup = false;
+  while (wr_pending_offset_ < wr_pending_.size()) {
+    bool wk;
+    auto wb = out.write(wr_pending_.data() + wr_pending_offset_,
+                        wr_pending_.size() - wr_pending_offset_, wk);
+    wakeup = wakeup || wk;
+    wr_pending_offset_ += wb;
+    // the consumer rings our bell once it has freed some space
+    if (wb == 0 && ! out.await_space())
+      break;
+  }
+  if (wakeup)
+    channel_.ring_peer();
+  if (wr_pending_offset_ == wr_pending_.size()) {
+    wr_pending_.clear();
+    wr_pending_offset_ = 0;
+  }
+}
+
+/******************************************************************************
+ *                                shm_listener                                *
+ ******************************************************************************/
+
+shm_listener::shm_listener(default_multiplexer& backend_ref, native_socket fd,
+                           const shm_channel& channel)
+    : event_handler(backend_ref),
+      fd_(fd),
+      channel_(channel) {
+  // nop
+}
+
+shm_listener::~shm_listener() {
+  if (fd_ != invalid_native_socket)
+    ::close(fd_);
+}
+
+void shm_listener::start(const manager_ptr& mgr) {
+  mgr_ = mgr;
+  backend().add(operation::read, fd_, this);
+}
+
+void shm_listener::stop() {
+  backend().del(operation::read, fd_, this);
+}
+
+void shm_listener::handle_event(operation op) {
+  CAF_LOG_TRACE("op = " << static_cast<int>(op));
+  if (op != operation::read || ! mgr_)
+    return;
+  native_socket peer = invalid_native_socket;
+  if (! try_accept(peer, fd_) || peer == invalid_native_socket)
+    return;
+  if (! channel_.send(peer))
+    CAF_LOG_WARNING("cannot send shared memory channel to peer");
+  ::close(peer);
+  // each channel has exactly one peer
+  stop();
+}
+
+void shm_listener::removed_from_loop(operation op) {
+  if (op == operation::read)
+    mgr_.reset();
+}
+
+native_socket shm_listener::fd() const {
+  return fd_;
+}
+
+} // namespace network
+} // namespace io
+} // namespace caf
+
+#else // CAF_LINUX
+
+int caf_shared_memory_keep_compiler_happy() {
+  // this function shuts up a linker warning saying that the
+  // object file has no symbols
+  return 0;
+}
+
+#endif // CAF_LINUX
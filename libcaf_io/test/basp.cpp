@@ -324,6 +324,13 @@ public:
     return result;
   }
 
+  // proxies forward messages via shards that serialize messages before the
+  // BASP broker writes them, i.e., the broker may run multiple times
+  void exec_until_output(connection_handle hdl) {
+    while (mpx_->output_buffer(hdl).empty())
+      mpx_->exec_runnable();
+  }
+
   void dispatch_out_buf(connection_handle hdl) {
     basp::header hdr;
     buffer buf;
@@ -494,7 +501,7 @@ CAF_TEST(client_handshake_and_dispatch) {
     THROW_ON_UNEXPECTED(self())
   );
   CAF_MESSAGE("exec message of forwarding proxy");
-  mpx()->exec_runnable();
+  exec_until_output(remote_hdl(0));
   dispatch_out_buf(remote_hdl(0)); // deserialize and send message from out buf
   pseudo_remote(0)->receive(
     [](int i) {
@@ -504,6 +511,42 @@ CAF_TEST(client_handshake_and_dispatch) {
   );
 }
 
+CAF_TEST(split_and_batched_frames) {
+  connect_node(0);
+  // write two frames into a single buffer
+  buffer buf;
+  for (int i = 0; i < 2; ++i) {
+    basp::header hdr{basp::message_type::dispatch_message, 0, 0,
+                     remote_node(0), this_node(),
+                     pseudo_remote(0)->id(), self()->id()};
+    to_buf(buf, hdr, nullptr, make_message(i));
+  }
+  // split the buffer within the header of the first frame and within the
+  // payload of the second frame, i.e., the second chunk contains the end
+  // of the first frame as well as the beginning of the second frame
+  auto frame_size = buf.size() / 2;
+  auto first = buf.begin();
+  std::vector<buffer::iterator> splits{first + 10,
+                                       first + frame_size + 10,
+                                       buf.end()};
+  for (auto split : splits) {
+    mpx()->virtual_send(remote_hdl(0), buffer{first, split});
+    first = split;
+  }
+  mock().expect(remote_hdl(0),
+                basp::message_type::announce_proxy_instance, uint32_t{0},
+                uint64_t{0}, this_node(), remote_node(0),
+                invalid_actor_id, pseudo_remote(0)->id());
+  for (int i = 0; i < 2; ++i) {
+    self()->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, i);
+      },
+      THROW_ON_UNEXPECTED(self())
+    );
+  }
+}
+
 CAF_TEST(message_forwarding) {
   // connect two remote nodes
   connect_node(0);
@@ -588,7 +631,7 @@ CAF_TEST(remote_actor_and_send) {
   );
   CAF_MESSAGE("send message to proxy");
   anon_send(actor_cast<actor>(result), 42);
-  mpx()->exec_runnable(); // process forwarded message in basp_broker
+  exec_until_output(remote_hdl(0)); // process forwarded message in basp_broker
   mock()
   .expect(remote_hdl(0),
           basp::message_type::dispatch_message, any_vals, uint64_t{0},
@@ -688,7 +731,7 @@ CAF_TEST(indirect_connections) {
     },
     THROW_ON_UNEXPECTED(self())
   );
-  mpx()->exec_runnable(); // process forwarded message in basp_broker
+  exec_until_output(remote_hdl(1)); // process forwarded message in basp_broker
   mock()
   .expect(remote_hdl(1),
           basp::message_type::dispatch_message, any_vals, uint64_t{0},
@@ -781,7 +824,7 @@ CAF_TEST(automatic_connection) {
     },
     THROW_ON_UNEXPECTED(self())
   );
-  mpx()->exec_runnable(); // process forwarded message in basp_broker
+  exec_until_output(remote_hdl(0)); // process forwarded message in basp_broker
   CAF_MESSAGE("response message must take direct route now");
   mock()
   .expect(remote_hdl(0),
@@ -0,0 +1,126 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_buffer_chain
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+
+#include "caf/make_counted.hpp"
+
+#include "caf/io/network/buffer_chain.hpp"
+
+using namespace caf;
+using namespace caf::io::network;
+
+namespace {
+
+using buffer_type = buffer_chain::buffer_type;
+
+buffer_type make_buf(const std::string& str) {
+  return buffer_type(str.begin(), str.end());
+}
+
+std::string pending(const buffer_chain& chain) {
+  write_chunk chunks[16];
+  auto n = chain.prepare(chunks, 16);
+  std::string result;
+  for (size_t i = 0; i < n; ++i) {
+    result.append(chunks[i].data, chunks[i].size);
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(append_and_consume) {
+  buffer_chain chain;
+  CAF_CHECK(chain.empty());
+  auto buf = make_buf("hello ");
+  chain.append(buf);
+  CAF_CHECK(buf.empty());
+  buf = make_buf("world");
+  chain.append(buf);
+  CAF_CHECK_EQUAL(chain.size(), 11u);
+  CAF_CHECK_EQUAL(pending(chain), "hello world");
+  chain.consume(3);
+  CAF_CHECK_EQUAL(pending(chain), "lo world");
+  chain.consume(4);
+  CAF_CHECK_EQUAL(pending(chain), "orld");
+  chain.consume(4);
+  CAF_CHECK(chain.empty());
+  CAF_CHECK_EQUAL(chain.size(), 0u);
+}
+
+CAF_TEST(empty_buffers_are_ignored) {
+  buffer_chain chain;
+  buffer_type buf;
+  chain.append(buf);
+  chain.append(buffer_segment_ptr{});
+  CAF_CHECK(chain.empty());
+  write_chunk chunks[4];
+  CAF_CHECK_EQUAL(chain.prepare(chunks, 4), 0u);
+}
+
+CAF_TEST(prepare_respects_limit) {
+  buffer_chain chain;
+  for (char c = 'a'; c < 'f'; ++c) {
+    auto buf = make_buf(std::string(1, c));
+    chain.append(buf);
+  }
+  write_chunk chunks[2];
+  CAF_REQUIRE(chain.prepare(chunks, 2) == 2u);
+  CAF_CHECK_EQUAL(std::string(chunks[0].data, chunks[0].size), "a");
+  CAF_CHECK_EQUAL(std::string(chunks[1].data, chunks[1].size), "b");
+  chain.consume(2);
+  CAF_CHECK_EQUAL(pending(chain), "cde");
+}
+
+CAF_TEST(buffers_are_recycled) {
+  buffer_chain chain;
+  auto buf = make_buf("abc");
+  buf.reserve(128);
+  auto storage = buf.data();
+  chain.append(buf);
+  chain.consume(3);
+  buf = make_buf("x");
+  chain.append(buf);
+  // the second append hands out the storage of the first buffer
+  CAF_CHECK(buf.empty());
+  CAF_CHECK_EQUAL(buf.data(), storage);
+}
+
+CAF_TEST(shared_segments) {
+  auto seg = make_counted<buffer_segment>(make_buf("shared"));
+  buffer_chain chain1;
+  buffer_chain chain2;
+  chain1.append(seg);
+  chain2.append(seg);
+  chain1.consume(6);
+  CAF_CHECK(chain1.empty());
+  // segment must be left untouched while other chains use it
+  CAF_CHECK_EQUAL(pending(chain2), "shared");
+  chain2.consume(2);
+  CAF_CHECK_EQUAL(pending(chain2), "ared");
+  chain2.clear();
+  CAF_CHECK(seg->unique());
+  CAF_CHECK_EQUAL(seg->buf().size(), 6u);
+}
@@ -0,0 +1,123 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_event_loops
+#include "caf/test/unit_test.hpp"
+
+#include <set>
+#include <thread>
+#include <cstring>
+
+#include "caf/all.hpp"
+#include "caf/io/all.hpp"
+
+using namespace caf;
+using namespace caf::io;
+
+namespace {
+
+using publish_atom = atom_constant<atom("publish")>;
+using done_atom = atom_constant<atom("done")>;
+
+constexpr size_t num_event_loops = 4;
+constexpr size_t num_clients = 8;
+
+uint64_t this_thread_hash() {
+  return std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+
+void write_int(broker* self, connection_handle hdl, int32_t value) {
+  auto& buf = self->wr_buf(hdl);
+  auto first = reinterpret_cast<char*>(&value);
+  buf.insert(buf.end(), first, first + sizeof(int32_t));
+  self->flush(hdl);
+}
+
+behavior echo_server(broker* self) {
+  return {
+    [=](const new_connection_msg& msg) {
+      self->configure_read(msg.handle, receive_policy::exactly(sizeof(int32_t)));
+    },
+    [=](const new_data_msg& msg) {
+      int32_t value;
+      memcpy(&value, msg.buf.data(), sizeof(int32_t));
+      write_int(self, msg.handle, value);
+    },
+    [=](const connection_closed_msg&) {
+      // nop
+    },
+    [=](publish_atom) {
+      return self->add_tcp_doorman(0, "127.0.0.1").second;
+    }
+  };
+}
+
+behavior client(broker* self, connection_handle hdl, int32_t id,
+                const actor& observer) {
+  // initialization runs in the event loop of this broker
+  auto tid = this_thread_hash();
+  self->configure_read(hdl, receive_policy::exactly(sizeof(int32_t)));
+  write_int(self, hdl, id);
+  return {
+    [=](const new_data_msg& msg) {
+      int32_t value;
+      memcpy(&value, msg.buf.data(), sizeof(int32_t));
+      CAF_CHECK_EQUAL(value, id);
+      // all events of a broker are handled by the same event loop
+      CAF_CHECK_EQUAL(this_thread_hash(), tid);
+      self->send(observer, done_atom::value, tid);
+      self->quit();
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(brokers_are_distributed_across_event_loops) {
+  set_middleman(num_event_loops);
+  CAF_CHECK_EQUAL(middleman::instance()->num_backends(), num_event_loops);
+  {
+    scoped_actor self;
+    auto server = spawn_io(echo_server);
+    uint16_t port = 0;
+    self->sync_send(server, publish_atom::value).await(
+      [&](uint16_t res) {
+        port = res;
+      }
+    );
+    CAF_REQUIRE(port != 0);
+    for (size_t i = 0; i < num_clients; ++i) {
+      spawn_io_client(client, "127.0.0.1", port, static_cast<int32_t>(i),
+                      actor{self});
+    }
+    std::set<uint64_t> threads;
+    size_t received = 0;
+    self->receive_for(received, num_clients) (
+      [&](done_atom, uint64_t tid) {
+        threads.insert(tid);
+      }
+    );
+    CAF_CHECK_EQUAL(threads.size(), num_event_loops);
+    anon_send_exit(server, exit_reason::user_shutdown);
+  }
+  await_all_actors_done();
+  shutdown();
+}
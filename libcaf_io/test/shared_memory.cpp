@@ -0,0 +1,152 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2015                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE io_shared_memory
+#include "caf/test/unit_test.hpp"
+
+#ifdef CAF_LINUX
+
+#include <thread>
+#include <string>
+#include <cstring>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "caf/io/network/shared_memory.hpp"
+
+using namespace caf;
+using namespace caf::io::network;
+
+namespace {
+
+constexpr size_t ring_capacity = 16;
+
+struct fixture {
+  alignas(64) char region[sizeof(shm_ring_header) + ring_capacity];
+  shm_ring ring;
+
+  fixture() : ring(region, ring_capacity) {
+    ring.init();
+  }
+
+  std::string read(size_t n) {
+    bool wakeup;
+    std::string result(n, '\0');
+    result.resize(ring.read(&result[0], n, wakeup));
+    return result;
+  }
+
+  size_t write(const std::string& str, bool& wakeup) {
+    return ring.write(str.data(), str.size(), wakeup);
+  }
+};
+
+bool readable(native_socket fd) {
+  pollfd pfd{fd, POLLIN, 0};
+  return ::poll(&pfd, 1, 0) == 1;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(shared_memory_tests, fixture)
+
+CAF_TEST(ring_wraps_around) {
+  bool wakeup;
+  CAF_CHECK(ring.empty());
+  CAF_CHECK_EQUAL(write("0123456789", wakeup), 10u);
+  CAF_CHECK(wakeup);
+  CAF_CHECK_EQUAL(read(6), "012345");
+  // only 12 bytes are free, the remainder wraps to the front of the ring
+  CAF_CHECK_EQUAL(write("abcdefghijklmnop", wakeup), 12u);
+  CAF_CHECK(! wakeup);
+  CAF_CHECK_EQUAL(ring.size(), ring_capacity);
+  CAF_CHECK_EQUAL(write("x", wakeup), 0u);
+  CAF_CHECK_EQUAL(read(32), "6789abcdefghijkl");
+  CAF_CHECK(ring.empty());
+}
+
+CAF_TEST(ring_wakes_up_waiting_producer) {
+  bool wakeup;
+  CAF_CHECK_EQUAL(write(std::string(ring_capacity, 'a'), wakeup), 16u);
+  CAF_CHECK(! ring.await_space());
+  // the first read after `await_space` notifies the producer exactly once
+  bool notify;
+  char buf[4];
+  CAF_CHECK_EQUAL(ring.read(buf, 4, notify), 4u);
+  CAF_CHECK(notify);
+  CAF_CHECK_EQUAL(ring.read(buf, 4, notify), 4u);
+  CAF_CHECK(! notify);
+  CAF_CHECK(ring.await_space());
+  CAF_CHECK_EQUAL(ring.read(buf, 4, notify), 4u);
+  CAF_CHECK(notify);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(channel_transfer) {
+  uint64_t token = 42;
+  auto listener = new_shm_listener(token);
+  shm_channel client;
+  std::thread t{[&] {
+    client = connect_shm_channel(static_cast<uint32_t>(getpid()), token, 1000);
+  }};
+  auto server = shm_channel::create(4096);
+  pollfd pfd{listener, POLLIN, 0};
+  CAF_REQUIRE(::poll(&pfd, 1, 1000) == 1);
+  auto peer = ::accept(listener, nullptr, nullptr);
+  CAF_REQUIRE(peer >= 0);
+  CAF_CHECK(server.send(peer));
+  t.join();
+  ::close(peer);
+  ::close(listener);
+  CAF_REQUIRE(client.bell() != invalid_native_socket);
+  CAF_CHECK_EQUAL(client.input().capacity(), 4096u);
+  // data written by one end arrives at the other and rings its doorbell
+  bool wakeup;
+  const char hello[] = "hello";
+  CAF_CHECK_EQUAL(server.output().write(hello, sizeof(hello), wakeup),
+                  sizeof(hello));
+  CAF_CHECK(wakeup);
+  CAF_CHECK(! readable(client.bell()));
+  server.ring_peer();
+  CAF_CHECK(readable(client.bell()));
+  client.clear_bell();
+  CAF_CHECK(! readable(client.bell()));
+  char buf[sizeof(hello)];
+  CAF_CHECK_EQUAL(client.input().read(buf, sizeof(buf), wakeup), sizeof(buf));
+  CAF_CHECK_EQUAL(std::string(buf), "hello");
+  // the same works in the other direction
+  CAF_CHECK_EQUAL(client.output().write(hello, 3, wakeup), 3u);
+  client.ring_peer();
+  CAF_CHECK(readable(server.bell()));
+  CAF_CHECK_EQUAL(server.input().read(buf, sizeof(buf), wakeup), 3u);
+  CAF_CHECK(strncmp(buf, "hel", 3) == 0);
+}
+
+#else // CAF_LINUX
+
+CAF_TEST(unsupported_platform) {
+  // nop
+}
+
+#endif // CAF_LINUX